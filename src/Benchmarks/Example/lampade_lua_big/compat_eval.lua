@@ -46,6 +46,7 @@ if arg and arg[1] then
     end
   end
 
+  local individual_fitness = {}
   for group in string.gmatch(os.getenv("UGP3_OFFSPRING"), "%S+") do
     local groupfile, msg = io.open(group, "r")
     if not groupfile then
@@ -64,7 +65,12 @@ if arg and arg[1] then
     local group_fitness = {evaluate(individuals)}
     write_fitness(group_fitness)
     for k, individual in ipairs(individuals) do
-      local val = {evaluate({individual})}
+      -- Groups share most of their members: evaluate each one only once
+      local val = individual_fitness[individual]
+      if not val then
+        val = {evaluate({individual})}
+        individual_fitness[individual] = val
+      end
       write_fitness(val)
     end
     fitness_file:write("\n")
@@ -60,12 +60,14 @@ function sqrt(x)
   return math.floor(math.sqrt(x) + 0.5)
 end
 
--- Increment a circle centered on the lamp coordinates
-function light_room(room, lamp)
+-- Increment a circle centered on the lamp coordinates (decrement it when
+-- amount is -1)
+function light_room(room, lamp, amount)
+  amount = amount or 1
   local x, y = lamp.x, lamp.y
   for i = max(0, x - radius), min(width-1, x + radius) do
     for j = max(0, y - sqrt(radius^2 - (i - x)^2)),min(height-1, y + sqrt(radius^2 - (i - x)^2)) do
-      room[j * width + i] = room[j * width + i] + 1
+      room[j * width + i] = room[j * width + i] + amount
     end
   end
 end
@@ -85,6 +87,50 @@ function sum_rooms(rooms)
   return result
 end
 
+-- Optional entry point for incremental group evaluation. MicroGP gives the
+-- state returned for a parent group (nil if there is none) and the lamps
+-- added to and removed from that parent, and stores the returned state along
+-- with the fitness. States here name rooms kept by this worker: a state that
+-- comes from another worker, or whose room has been dropped, is recomputed.
+-- States are saved in the status file, and a resumed run numbers its workers
+-- from the same values: the prefix also names this process, so that a state
+-- from a previous run never matches a room of this one.
+local rooms, room_states, room_count = {}, {}, 0
+local state_prefix = (ugp_environment and ugp_environment.tempdir or "") .. ":"
+  .. os.time() .. ":" .. tostring(rooms):match("%x+$") .. ":"
+local max_rooms = 256
+
+function evaluate_incremental(individuals, state, added, removed)
+  local room = state and rooms[state]
+  if room then
+    local copy = new_room()
+    ffi.copy(copy, room, ffi.sizeof(room))
+    room = copy
+  else
+    room = new_room()
+    added, removed = individuals, {}
+  end
+  for k, ind in pairs(added) do
+    local x, y = ind:match("(%d+)%s+(%d+)")
+    light_room(room, {x=x, y=y}, 1)
+  end
+  for k, ind in pairs(removed) do
+    local x, y = ind:match("(%d+)%s+(%d+)")
+    light_room(room, {x=x, y=y}, -1)
+  end
+  local group_coverage = coverage(room)
+  local group_overlap = overlap(room)
+
+  room_count = room_count + 1
+  local new_state = state_prefix .. room_count
+  rooms[new_state] = room
+  table.insert(room_states, new_state)
+  if #room_states > max_rooms then
+    rooms[table.remove(room_states, 1)] = nil
+  end
+  return group_coverage - group_overlap, "Cov: " .. group_coverage .. " - Ov: " .. group_overlap .. ", " .. #individuals .. " lamps", new_state
+end
+
 function count_brighter_than(room, level)
   -- Determine room illumination at or above the given level
   local illuminated = 0
@@ -0,0 +1,288 @@
+/***********************************************************************\
+|                                                                       |
+| Kernels.cc                                                            |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#include <sstream>
+
+#include "EvolutionaryCore.h"
+#include "Distances.h"
+#include "Relabeller.h"
+#include "Operators/AllopatricDifferentialOperator.h"
+#include "Operators/AlterationMutation.h"
+#include "Operators/BitStringOperator.h"
+#include "Operators/InsertionMutation.h"
+#include "Operators/InverOverCrossover.h"
+#include "Operators/LocalSearch.h"
+#include "Operators/OnePointCrossover.h"
+#include "Operators/OnePointImpreciseCrossover.h"
+#include "Operators/RandomizerOperator.h"
+#include "Operators/RemovalMutation.h"
+#include "Operators/ReplacementMutation.h"
+#include "Operators/ScanMutationBitArray.h"
+#include "Operators/ScanMutationConstant.h"
+#include "Operators/ScanMutationFloat.h"
+#include "Operators/ScanMutationInnerLabel.h"
+#include "Operators/ScanMutationInteger.h"
+#include "Operators/SimpleDifferentialOperator.h"
+#include "Operators/SingleParameterAlterationMutation.h"
+#include "Operators/SubGraphInsertionMutation.h"
+#include "Operators/SubGraphRemovalMutation.h"
+#include "Operators/SubGraphReplacementMutation.h"
+#include "Operators/SwapMutation.h"
+#include "Operators/TwoPointCrossover.h"
+#include "Operators/TwoPointImpreciseCrossover.h"
+#include "Operators/UniformCrossover.h"
+#include "Kernels.h"
+
+using namespace std;
+using namespace ugp3;
+using namespace ugp3::core;
+using namespace ugp3::ctgraph;
+using namespace ugp3::microbench;
+
+namespace {
+
+// Results are accumulated here so that the compiler cannot drop the kernels
+volatile hash_t sink;
+
+}
+
+void ugp3::microbench::registerOperators()
+{
+    // Same genetic operators as the ugp3 frontend; group operators do not apply
+    Operator::registration(new AllopatricDifferentialOperator());
+    Operator::registration(new AlterationMutationOperator());
+    Operator::registration(new BitStringFlipOneMutation());
+    Operator::registration(new BitStringResetOneMutation());
+    Operator::registration(new BitStringSetOneMutation());
+    Operator::registration(new BitStringGlobalMajorityMutation());
+    Operator::registration(new BitStringGlobalMinorityMutation());
+    Operator::registration(new BitStringLocalMajorityMutation());
+    Operator::registration(new BitStringLocalMinorityMutation());
+    Operator::registration(new BitStringFlipUniformMutation());
+    Operator::registration(new BitStringFlip1Mutation());
+    Operator::registration(new BitStringFlip3Mutation());
+    Operator::registration(new BitStringFlip5Mutation());
+    Operator::registration(new InsertionMutationOperator());
+    Operator::registration(new InverOverCrossoverOperator());
+    Operator::registration(new LocalSearchOperator());
+    Operator::registration(new OnePointCrossoverOperator());
+    Operator::registration(new OnePointImpreciseCrossoverOperator());
+    Operator::registration(new RandomizerOperator());
+    Operator::registration(new RemovalMutationOperator());
+    Operator::registration(new ReplacementMutationOperator());
+    Operator::registration(new ScanMutationBitArrayOperator());
+    Operator::registration(new ScanMutationConstantOperator());
+    Operator::registration(new ScanMutationFloatOperator());
+    Operator::registration(new ScanMutationInnerLabelOperator());
+    Operator::registration(new ScanMutationIntegerOperator());
+    Operator::registration(new SimpleDifferentialOperator());
+    Operator::registration(new SingleParameterAlterationMutationOperator());
+    Operator::registration(new SubGraphInsertionMutationOperator());
+    Operator::registration(new SubGraphRemovalMutationOperator());
+    Operator::registration(new SubGraphReplacementMutationOperator());
+    Operator::registration(new SwapMutationOperator());
+    Operator::registration(new TwoPointCrossoverOperator());
+    Operator::registration(new TwoPointImpreciseCrossoverOperator());
+    Operator::registration(new UniformCrossoverOperator());
+}
+
+void ugp3::microbench::runGenomeKernels(MicroBench& bench, SyntheticProblem& problem)
+{
+    unsigned int next = 0;
+    
+    // Cloning is lazy: the labels must be attached again, as the operators do
+    bench.run("CGraphContainer::clone", [&] {
+        unique_ptr<CGraphContainer> copy = problem.getIndividual(next++).getGraphContainer().clone();
+        copy->attachFloatingEdges();
+    });
+    
+    // Hash codes are cached at every level of the graph: the warm kernel only
+    // combines the cached hashes of the graphs, the cold one starts from a
+    // fresh clone (subtract CGraphContainer::clone to get the hashing time).
+    bench.run("CGraphContainer::calculateHashCode", [&] {
+        sink = sink + problem.getIndividual(next++).getGraphContainer().calculateHashCode(Hashable::GENOTYPE);
+    });
+    bench.run("CGraphContainer::clone+calculateHashCode", [&] {
+        unique_ptr<CGraphContainer> copy = problem.getIndividual(next++).getGraphContainer().clone();
+        copy->attachFloatingEdges();
+        sink = sink + copy->calculateHashCode(Hashable::GENOTYPE);
+        sink = sink + copy->calculateHashCode(Hashable::ENTROPY);
+    });
+    
+    // Same code as Individual::computeNormalizedPhenotype(), which is not public
+    bench.run("Individual::computeNormalizedPhenotype", [&] {
+        string code;
+        NormalizingRelabeller relabeller;
+        problem.getIndividual(next++).getGraphContainer().appendExternalRepresentation(code, relabeller);
+        sink = sink + code.size();
+    });
+    
+    bench.run("Individual::validate", [&] {
+        sink = sink + problem.getIndividual(next++).validate();
+    });
+}
+
+void ugp3::microbench::runOperatorKernels(MicroBench& bench, SyntheticProblem& problem)
+{
+    BenchmarkPopulation& population = problem.getPopulation();
+    
+    for (unsigned int i = 0; i < Operator::getOperatorCount(); ++i) {
+        const GeneticOperator* geneticOperator = dynamic_cast<GeneticOperator*>(Operator::getOperator(i));
+        if (geneticOperator == nullptr || !Operator::getOperator(i)->isApplicable(&population)) {
+            continue;
+        }
+        
+        const string kernel = "GeneticOperator::generate/" + geneticOperator->getName();
+        if (!bench.isSelected(kernel)) {
+            continue;
+        }
+        
+        unsigned int next = 0;
+        vector<Individual*> parents(geneticOperator->getParentsCardinality());
+        vector<Individual*> children;
+        auto generate = [&] {
+            for (auto& parent: parents) {
+                parent = &problem.getIndividual(next++);
+            }
+            geneticOperator->generate(parents, children, population);
+            for (auto child: children) {
+                delete child;
+            }
+            children.clear();
+        };
+        
+        // Operators that need more than the synthetic constraints offer are skipped
+        try {
+            generate();
+        } catch (const exception& e) {
+            LOG_WARNING << "Skipping " << kernel << ": " << e.what() << ends;
+            continue;
+        }
+        
+        bench.run(kernel, generate);
+    }
+}
+
+void ugp3::microbench::runDistanceKernels(MicroBench& bench, SyntheticProblem& problem)
+{
+    unsigned int next = 0;
+    
+    bench.run("Distances::levenshtein", [&] {
+        const Individual& a = problem.getIndividual(next++);
+        const Individual& b = problem.getIndividual(next);
+        sink = sink + Distances::levenshtein(a.getGraphContainer().getNodeHashSequence(),
+                                             b.getGraphContainer().getNodeHashSequence());
+    });
+    
+    bench.run("Distances::hamming", [&] {
+        const Individual& a = problem.getIndividual(next++);
+        const Individual& b = problem.getIndividual(next);
+        sink = sink + Distances::hamming(a.getExternalRepresentation(), b.getExternalRepresentation());
+    });
+    
+    bench.run("Distances::entropic", [&] {
+        const Individual& a = problem.getIndividual(next++);
+        const Individual& b = problem.getIndividual(next);
+        sink = sink + Distances::entropic(a.getMessage(), b.getMessage());
+    });
+    
+    bench.run("Distances::approximateEntropic", [&] {
+        const Individual& a = problem.getIndividual(next++);
+        const Individual& b = problem.getIndividual(next);
+        sink = sink + Distances::approximateEntropic(a.getSketch(), b.getSketch());
+    });
+    
+    bench.run("MessageSketch::compute", [&] {
+        MessageSketch sketch;
+        sketch.compute(problem.getIndividual(next++).getMessage());
+        sink = sink + sketch.getSymbolCount();
+    });
+    
+    bench.run("Message::extractSymbols", [&] {
+        Message message;
+        message.extractSymbols(problem.getIndividual(next++).getGraphContainer().getNodeHashSequence());
+        sink = sink + message.getSize();
+    });
+    
+    // Whole population message, as in Population::updateDeltaEntropy()
+    Message total;
+    bench.run("Message::operator+=/population", [&] {
+        total.reset();
+        for (unsigned int i = 0; i < problem.getPopulation().getIndividualCount(); ++i) {
+            total += problem.getIndividual(i).getMessage();
+        }
+    });
+    
+    // Delta entropy of one individual: remove its message, compute, put it back
+    bench.run("Message::getEntropy", [&] {
+        const Message& message = problem.getIndividual(next++).getMessage();
+        total -= message;
+        sink = sink + total.getEntropy() * 1000;
+        total += message;
+    });
+}
+
+void ugp3::microbench::runPopulationKernels(MicroBench& bench, SyntheticProblem& problem)
+{
+    BenchmarkPopulation& population = problem.getPopulation();
+    
+    bench.run("MOPopulation::computeLevels", [&] {
+        population.computeLevels();
+    });
+    
+    // The clones are killed: bring them back each time (linear, negligible)
+    bench.run("Population::detectAndHandleClones", [&] {
+        population.detectAndHandleClones();
+        population.resurrect();
+    });
+}
+
+void ugp3::microbench::runXmlKernels(MicroBench& bench, SyntheticProblem& problem)
+{
+    unsigned int next = 0;
+    
+    bench.run("Individual::writeXml", [&] {
+        ostringstream stream;
+        problem.getIndividual(next++).writeXml(stream);
+        sink = sink + stream.str().size();
+    });
+    
+    if (!bench.isSelected("Individual::readXml")) {
+        return;
+    }
+    
+    vector<string> documents;
+    for (unsigned int i = 0; i < problem.getPopulation().getIndividualCount(); ++i) {
+        ostringstream stream;
+        problem.getIndividual(i).writeXml(stream);
+        documents.push_back(stream.str());
+    }
+    bench.run("Individual::readXml", [&] {
+        xml::Document document;
+        document.Parse(documents[next++ % documents.size()].c_str());
+        unique_ptr<Individual> individual = Individual::instantiate(*document.RootElement(), problem.getPopulation());
+    });
+}
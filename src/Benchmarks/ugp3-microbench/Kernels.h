@@ -0,0 +1,59 @@
+/***********************************************************************\
+|                                                                       |
+| Kernels.h                                                             |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#ifndef HEADER_UGP3_MICROBENCH_KERNELS
+#define HEADER_UGP3_MICROBENCH_KERNELS
+
+#include "MicroBench.h"
+#include "SyntheticProblem.h"
+
+namespace ugp3 {
+namespace microbench {
+
+/**
+ * Registers the genetic operators timed by runOperatorKernels().
+ */
+void registerOperators();
+
+/** Genome kernels: clone, hash, normalized phenotype, validation. */
+void runGenomeKernels(MicroBench& bench, SyntheticProblem& problem);
+
+/** The generate() function of each applicable genetic operator. */
+void runOperatorKernels(MicroBench& bench, SyntheticProblem& problem);
+
+/** Distances and entropy. */
+void runDistanceKernels(MicroBench& bench, SyntheticProblem& problem);
+
+/** Population-wide kernels: levels and clone detection. */
+void runPopulationKernels(MicroBench& bench, SyntheticProblem& problem);
+
+/** XML serialization of individuals. */
+void runXmlKernels(MicroBench& bench, SyntheticProblem& problem);
+
+}
+}
+
+#endif
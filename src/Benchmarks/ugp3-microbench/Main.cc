@@ -0,0 +1,195 @@
+/***********************************************************************\
+|                                                                       |
+| Main.cc                                                               |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "ConsoleHandler.h"
+#include "PlainFormatter.h"
+#include "EvolutionaryCore.h"
+#include "Convert.h"
+#include "Kernels.h"
+
+using namespace std;
+using namespace ugp3;
+using namespace ugp3::log;
+using namespace ugp3::core;
+using namespace ugp3::microbench;
+
+#define PROGRAM_NAME            "ugp3-microbench"
+#define OPTION_MACROS           "macros"
+#define OPTION_NODES            "nodes"
+#define OPTION_POPULATION       "population"
+#define OPTION_CLONES           "clones"
+#define OPTION_OBJECTIVES       "objectives"
+#define OPTION_SEED             "seed"
+#define OPTION_SAMPLES          "samples"
+#define OPTION_BATCHTIME        "batchTime"
+#define OPTION_FILTER           "filter"
+#define OPTION_FORMAT           "format"
+#define OPTION_OUTPUT           "output"
+#define OPTION_VERBOSE          "verbose"
+#define OPTION_HELP             "help"
+
+namespace {
+
+struct Options
+{
+    SyntheticProblem::Configuration problem;
+    unsigned long seed = 42;
+    unsigned int samples = 5;
+    unsigned int batchTime = 20;
+    string filter;
+    string format = "csv";
+    string output;
+    bool verbose = false;
+};
+
+void showHelp()
+{
+    cout << "Usage: " PROGRAM_NAME " [options]" << endl
+         << "Times the core genome and population kernels on a synthetic problem." << endl
+         << "Options:" << endl
+         << "  --" OPTION_MACROS " <n>        distinct macros in the constraints (default 8)" << endl
+         << "  --" OPTION_NODES " <n>         average macros per individual (default 100)" << endl
+         << "  --" OPTION_POPULATION " <n>    random individuals (default 50)" << endl
+         << "  --" OPTION_CLONES " <n>        additional clones of random individuals (default 5)" << endl
+         << "  --" OPTION_OBJECTIVES " <n>    fitness components (default 2)" << endl
+         << "  --" OPTION_SEED " <n>          random seed (default 42)" << endl
+         << "  --" OPTION_SAMPLES " <n>       timed batches per kernel (default 5)" << endl
+         << "  --" OPTION_BATCHTIME " <ms>    minimum duration of a batch (default 20)" << endl
+         << "  --" OPTION_FILTER " <text>     only run the kernels whose name contains text" << endl
+         << "  --" OPTION_FORMAT " csv|json   format of the results (default csv)" << endl
+         << "  --" OPTION_OUTPUT " <file>     write the results to file instead of stdout" << endl
+         << "  --" OPTION_VERBOSE "           show the progress" << endl;
+}
+
+bool parseArguments(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const string argument = argv[i];
+        if (argument == "--" OPTION_HELP) {
+            showHelp();
+            return false;
+        } else if (argument == "--" OPTION_VERBOSE) {
+            options.verbose = true;
+            continue;
+        }
+        
+        if (i + 1 >= argc) {
+            throw Exception("Missing value for option \"" + argument + "\".", LOCATION);
+        }
+        const string value = argv[++i];
+        
+        if (argument == "--" OPTION_MACROS) {
+            options.problem.macros = Convert::toUInt(value);
+        } else if (argument == "--" OPTION_NODES) {
+            options.problem.nodes = Convert::toUInt(value);
+        } else if (argument == "--" OPTION_POPULATION) {
+            options.problem.population = Convert::toUInt(value);
+        } else if (argument == "--" OPTION_CLONES) {
+            options.problem.clones = Convert::toUInt(value);
+        } else if (argument == "--" OPTION_OBJECTIVES) {
+            options.problem.objectives = Convert::toUInt(value);
+        } else if (argument == "--" OPTION_SEED) {
+            options.seed = Convert::toUInt(value);
+        } else if (argument == "--" OPTION_SAMPLES) {
+            options.samples = Convert::toUInt(value);
+        } else if (argument == "--" OPTION_BATCHTIME) {
+            options.batchTime = Convert::toUInt(value);
+        } else if (argument == "--" OPTION_FILTER) {
+            options.filter = value;
+        } else if (argument == "--" OPTION_FORMAT) {
+            options.format = value;
+        } else if (argument == "--" OPTION_OUTPUT) {
+            options.output = value;
+        } else {
+            throw Exception("Unknown option \"" + argument + "\".", LOCATION);
+        }
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    // Messages go to stderr, so that the results can be redirected
+    ConsoleHandler* consoleHandler = new ConsoleHandler();
+    consoleHandler->setConsole(&cerr);
+    consoleHandler->setFormatter(*new PlainFormatter());
+    consoleHandler->setLevel(Level::Warning);
+    log_.addHandler(*consoleHandler);
+    
+    try
+    {
+        Options options;
+        if (!parseArguments(argc, argv, options)) {
+            return EXIT_SUCCESS;
+        }
+        if (options.verbose) {
+            consoleHandler->setLevel(Level::Info);
+        }
+        const MicroBench::Format format = MicroBench::parseFormat(options.format);
+        
+        Random::seed(options.seed);
+        registerOperators();
+        
+        SyntheticProblem problem(options.problem);
+        
+        MicroBench bench(options.samples, chrono::milliseconds(options.batchTime), options.filter);
+        bench.addConfiguration(OPTION_MACROS, Convert::toString(options.problem.macros));
+        bench.addConfiguration(OPTION_NODES, Convert::toString(options.problem.nodes));
+        bench.addConfiguration(OPTION_POPULATION, Convert::toString(options.problem.population));
+        bench.addConfiguration(OPTION_CLONES, Convert::toString(options.problem.clones));
+        bench.addConfiguration(OPTION_OBJECTIVES, Convert::toString(options.problem.objectives));
+        bench.addConfiguration(OPTION_SEED, Convert::toString(options.seed));
+        
+        runGenomeKernels(bench, problem);
+        runOperatorKernels(bench, problem);
+        runDistanceKernels(bench, problem);
+        runPopulationKernels(bench, problem);
+        runXmlKernels(bench, problem);
+        
+        if (options.output.empty()) {
+            bench.write(cout, format);
+        } else {
+            ofstream output(options.output);
+            if (!output) {
+                throw Exception("Could not write file \"" + options.output + "\".", LOCATION);
+            }
+            bench.write(output, format);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR << e.what() << std::ends;
+        return EXIT_FAILURE;
+    }
+    
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+/***********************************************************************\
+|                                                                       |
+| MicroBench.cc                                                         |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+#include "EvolutionaryCore.h"
+#include "MicroBench.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace ugp3::microbench;
+
+MicroBench::MicroBench(unsigned int samples, milliseconds batchTime, const string& filter)
+: m_samples(max(samples, 1u)),
+  m_batchTime(batchTime),
+  m_filter(filter)
+{
+}
+
+void MicroBench::addConfiguration(const string& name, const string& value)
+{
+    m_configuration.push_back(make_pair(name, value));
+}
+
+bool MicroBench::isSelected(const string& kernel) const
+{
+    return m_filter.empty() || kernel.find(m_filter) != string::npos;
+}
+
+void MicroBench::run(const string& kernel, const function<void()>& body)
+{
+    if (!isSelected(kernel)) {
+        return;
+    }
+    
+    LOG_VERBOSE << "Timing kernel " << kernel << ends;
+    
+    // Warm up the caches and find how many calls fill a batch
+    body();
+    unsigned long iterations = 1;
+    const unsigned long maximumIterations = 1ul << 24;
+    while (iterations < maximumIterations) {
+        auto start = steady_clock::now();
+        for (unsigned long i = 0; i < iterations; ++i) {
+            body();
+        }
+        if (steady_clock::now() - start >= m_batchTime) {
+            break;
+        }
+        iterations *= 2;
+    }
+    
+    vector<double> times;
+    for (unsigned int s = 0; s < m_samples; ++s) {
+        auto start = steady_clock::now();
+        for (unsigned long i = 0; i < iterations; ++i) {
+            body();
+        }
+        times.push_back(duration<double, nano>(steady_clock::now() - start).count() / iterations);
+    }
+    sort(times.begin(), times.end());
+    
+    Result result;
+    result.kernel = kernel;
+    result.iterations = iterations;
+    result.samples = m_samples;
+    result.minimum = times.front();
+    result.median = times.size() % 2 ? times[times.size() / 2]
+        : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2;
+    result.mean = accumulate(times.begin(), times.end(), 0.0) / times.size();
+    m_results.push_back(result);
+    
+    ostringstream line;
+    line << setw(48) << left << kernel << setw(14) << right << fixed << setprecision(1) << result.median;
+    LOG_INFO << line.str() << " ns/call" << ends;
+}
+
+void MicroBench::write(ostream& output, Format format) const
+{
+    output << fixed << setprecision(1);
+    
+    if (format == CSV) {
+        // The configuration is repeated on every line so that files can be concatenated
+        output << "kernel";
+        for (auto& entry: m_configuration) {
+            output << "," << entry.first;
+        }
+        output << ",iterations,samples,min_ns,median_ns,mean_ns" << endl;
+        for (auto& result: m_results) {
+            output << result.kernel;
+            for (auto& entry: m_configuration) {
+                output << "," << entry.second;
+            }
+            output << "," << result.iterations << "," << result.samples
+                   << "," << result.minimum << "," << result.median << "," << result.mean << endl;
+        }
+    } else {
+        output << "{" << endl << "  \"configuration\": {";
+        for (auto it = m_configuration.begin(); it != m_configuration.end(); ++it) {
+            output << (it == m_configuration.begin() ? "" : ",") << endl
+                   << "    \"" << it->first << "\": \"" << it->second << "\"";
+        }
+        output << endl << "  }," << endl << "  \"results\": [";
+        for (auto it = m_results.begin(); it != m_results.end(); ++it) {
+            output << (it == m_results.begin() ? "" : ",") << endl
+                   << "    { \"kernel\": \"" << it->kernel << "\""
+                   << ", \"iterations\": " << it->iterations
+                   << ", \"samples\": " << it->samples
+                   << ", \"min_ns\": " << it->minimum
+                   << ", \"median_ns\": " << it->median
+                   << ", \"mean_ns\": " << it->mean << " }";
+        }
+        output << endl << "  ]" << endl << "}" << endl;
+    }
+}
+
+MicroBench::Format MicroBench::parseFormat(const string& value)
+{
+    if (value == "csv") {
+        return CSV;
+    } else if (value == "json") {
+        return JSON;
+    }
+    throw ugp3::Exception("Unknown output format \"" + value + "\" (expected \"csv\" or \"json\").", LOCATION);
+}
@@ -0,0 +1,109 @@
+/***********************************************************************\
+|                                                                       |
+| MicroBench.h                                                          |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#ifndef HEADER_UGP3_MICROBENCH_MICROBENCH
+#define HEADER_UGP3_MICROBENCH_MICROBENCH
+
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ugp3 {
+namespace microbench {
+
+/**
+ * Times small kernels of the engine in isolation.
+ * 
+ * Each kernel is called once to warm up, then the number of calls per batch
+ * is doubled until a batch lasts at least the requested batch time. The
+ * kernel is then timed over several batches, and the minimum, median and
+ * mean time per call are recorded. Results are written as CSV or JSON, along
+ * with the configuration of the problem, so that they can be compared
+ * between commits.
+ */
+class MicroBench
+{
+public:
+    typedef enum {
+        CSV,
+        JSON
+    } Format;
+    
+    struct Result
+    {
+        std::string kernel;
+        unsigned long iterations;   // calls per batch
+        unsigned int samples;       // number of batches
+        double minimum;             // nanoseconds per call
+        double median;
+        double mean;
+    };
+    
+private:
+    unsigned int m_samples;
+    std::chrono::nanoseconds m_batchTime;
+    std::string m_filter;
+    std::vector<std::pair<std::string, std::string>> m_configuration;
+    std::vector<Result> m_results;
+    
+public:
+    /**
+     * @param samples Number of timed batches for each kernel.
+     * @param batchTime Minimum duration of a batch.
+     * @param filter Only the kernels whose name contains this string are run.
+     */
+    MicroBench(unsigned int samples, std::chrono::milliseconds batchTime, const std::string& filter);
+    
+    /**
+     * Adds a (name, value) pair to the description of the run.
+     */
+    void addConfiguration(const std::string& name, const std::string& value);
+    
+    /**
+     * @return True if the given kernel passes the filter.
+     */
+    bool isSelected(const std::string& kernel) const;
+    
+    /**
+     * Times the given kernel, if selected. Each call of the body must perform
+     * one operation: the body is responsible for cycling over its inputs.
+     */
+    void run(const std::string& kernel, const std::function<void()>& body);
+    
+    const std::vector<Result>& getResults() const { return m_results; }
+    
+    void write(std::ostream& output, Format format) const;
+    
+    static Format parseFormat(const std::string& value);
+};
+
+}
+}
+
+#endif
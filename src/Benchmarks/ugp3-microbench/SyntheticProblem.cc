@@ -0,0 +1,226 @@
+/***********************************************************************\
+|                                                                       |
+| SyntheticProblem.cc                                                   |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#include <cstdio>
+#include <fstream>
+
+#include "EvolutionaryCore.h"
+#include "SyntheticProblem.h"
+
+using namespace std;
+using namespace ugp3;
+using namespace ugp3::core;
+using namespace ugp3::microbench;
+
+void BenchmarkPopulation::assignRandomFitness()
+{
+    m_fitnessValues.clear();
+    for (auto individual: m_individuals) {
+        vector<double> values;
+        for (unsigned int k = 0; k < getParameters().getFitnessParametersCount(); ++k) {
+            values.push_back(Random::nextDouble(0, 100));
+        }
+        individual->getRawFitness().setValues(values);
+        individual->getFitness().setValues(values);
+        m_fitnessValues.push_back(values);
+    }
+}
+
+void BenchmarkPopulation::resurrect()
+{
+    // detectAndHandleClones() sorts the individuals, use the placeholders to find their values
+    for (auto individual: m_individuals) {
+        if (individual->isDead()) {
+            individual->setState(CandidateSolution::ALIVE);
+            individual->getRawFitness().setValues(m_fitnessValues[individual->getPlaceholder()]);
+            individual->getFitness().setValues(m_fitnessValues[individual->getPlaceholder()]);
+        }
+    }
+}
+
+SyntheticProblem::SyntheticProblem(const Configuration& configuration)
+: m_configuration(configuration),
+  m_constraintsFile("microbench.constraints.xml"),
+  m_parametersFile("microbench.population.xml"),
+  m_algorithm(new EvolutionaryAlgorithm()),
+  m_population(nullptr)
+{
+    if (m_configuration.macros == 0 || m_configuration.nodes == 0 || m_configuration.population < 2) {
+        throw Exception("The synthetic problem needs at least one macro, one node and two individuals.", LOCATION);
+    }
+    
+    // The files are not needed once the constraints are loaded
+    unique_ptr<BenchmarkPopulation> population(new BenchmarkPopulation(*m_algorithm));
+    try {
+        writeConstraints();
+        writeParameters();
+        xml::Document parametersFile;
+        parametersFile.LoadFile(m_parametersFile);
+        population->getParameters().readXml(*parametersFile.RootElement());
+    } catch (...) {
+        removeFiles();
+        throw;
+    }
+    removeFiles();
+    
+    population->setName("microbench");
+    m_population = population.get();
+    m_algorithm->addPopulation(move(population));
+    
+    LOG_VERBOSE << "Creating " << m_configuration.population << " random individuals" << ends;
+    while (m_population->getIndividualCount() < m_configuration.population) {
+        unique_ptr<MOIndividual> individual = m_population->newRandomSpecificIndividual();
+        if (individual->validate()) {
+            m_population->addIndividual(move(individual));
+        }
+    }
+    for (unsigned int i = 0; i < m_configuration.clones; ++i) {
+        const Individual& original = getIndividual(Random::nextUInteger(0, m_configuration.population - 1));
+        unique_ptr<Individual> copy = original.clone(*m_population);
+        copy->getGraphContainer().attachFloatingEdges();
+        m_population->addIndividual(move(copy));
+    }
+    m_population->assignRandomFitness();
+    
+    // Fill the caches of the individuals, as the engine does before using
+    // them, so that the kernels do not depend on the order in which they run
+    for (unsigned int i = 0; i < m_population->getIndividualCount(); ++i) {
+        const Individual& individual = getIndividual(i);
+        individual.getHashCode(Hashable::GENOTYPE);
+        individual.getNormalizedPhenotype();
+        individual.getExternalRepresentation();
+        individual.getMessage();
+        individual.getGraphContainer().getNodeHashSequence();
+    }
+}
+
+void SyntheticProblem::removeFiles() const
+{
+    std::remove(m_constraintsFile.c_str());
+    std::remove(m_parametersFile.c_str());
+}
+
+void SyntheticProblem::writeConstraints() const
+{
+    ofstream output(m_constraintsFile);
+    if (!output) {
+        throw Exception("Could not write file \"" + m_constraintsFile + "\".", LOCATION);
+    }
+    
+    const unsigned int nodes = m_configuration.nodes;
+    
+    output << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << endl
+           << "<constraints id=\"microbench\">" << endl
+           << "  <typeDefinitions>" << endl
+           << "    <item type=\"constant\" name=\"register\">" << endl;
+    for (unsigned int r = 0; r < 8; ++r) {
+        output << "      <value>r" << r << "</value>" << endl;
+    }
+    output << "    </item>" << endl
+           << "  </typeDefinitions>" << endl
+           << "  <commentFormat><value/></commentFormat>" << endl
+           << "  <identifierFormat>n<value/></identifierFormat>" << endl
+           << "  <labelFormat><value/>: </labelFormat>" << endl
+           << "  <uniqueTagFormat><value/></uniqueTagFormat>" << endl
+           << "  <prologue id=\"globalPrologue\"/>" << endl
+           << "  <epilogue id=\"globalEpilogue\"/>" << endl
+           << "  <sections>" << endl
+           << "    <section id=\"code\" prologueEpilogueCompulsory=\"false\">" << endl
+           << "      <prologue id=\"codePrologue\"/>" << endl
+           << "      <epilogue id=\"codeEpilogue\"/>" << endl
+           << "      <subSections>" << endl
+           << "        <subSection id=\"main\" maxOccurs=\"1\" minOccurs=\"1\" maxReferences=\"0\">" << endl
+           << "          <prologue id=\"mainPrologue\"/>" << endl
+           << "          <epilogue id=\"mainEpilogue\"/>" << endl
+           << "          <macros maxOccurs=\"" << 2 * nodes << "\" minOccurs=\"" << (nodes + 1) / 2
+           << "\" averageOccurs=\"" << nodes << "\" sigma=\"" << (nodes + 3) / 4 << "\">" << endl;
+    
+    // Cycle over the parameter kinds so that every operator finds something to work on
+    for (unsigned int m = 0; m < m_configuration.macros; ++m) {
+        output << "            <macro id=\"macro" << m << "\">" << endl
+               << "              <expression>op" << m << " <param ref=\"dst\"/>, <param ref=\"src\"/></expression>" << endl
+               << "              <parameters>" << endl
+               << "                <item type=\"definedType\" ref=\"register\" name=\"dst\"/>" << endl;
+        switch (m % 5) {
+        case 0:
+            output << "                <item type=\"definedType\" ref=\"register\" name=\"src\"/>" << endl;
+            break;
+        case 1:
+            output << "                <item type=\"integer\" minimum=\"0\" maximum=\"65535\" name=\"src\"/>" << endl;
+            break;
+        case 2:
+            output << "                <item type=\"float\" minimum=\"-1\" maximum=\"1\" name=\"src\"/>" << endl;
+            break;
+        case 3:
+            output << "                <item type=\"bitArray\" length=\"16\" base=\"hex\" name=\"src\"/>" << endl;
+            break;
+        default:
+            output << "                <item type=\"innerGenericLabel\" name=\"src\" itself=\"true\" prologue=\"true\" epilogue=\"true\"/>" << endl;
+            break;
+        }
+        output << "              </parameters>" << endl
+               << "            </macro>" << endl;
+    }
+    
+    output << "          </macros>" << endl
+           << "        </subSection>" << endl
+           << "      </subSections>" << endl
+           << "    </section>" << endl
+           << "  </sections>" << endl
+           << "</constraints>" << endl;
+}
+
+void SyntheticProblem::writeParameters() const
+{
+    ofstream output(m_parametersFile);
+    if (!output) {
+        throw Exception("Could not write file \"" + m_parametersFile + "\".", LOCATION);
+    }
+    
+    const unsigned int size = m_configuration.population + m_configuration.clones;
+    
+    output << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << endl
+           << "<parameters type=\"" << MOPopulation::XML_SCHEMA_TYPE << "\">" << endl
+           << "  <cloneScalingFactor value=\"0\"/>" << endl
+           << "  <eliteSize value=\"0\"/>" << endl
+           << "  <mu value=\"" << size << "\"/>" << endl
+           << "  <nu value=\"" << size << "\"/>" << endl
+           << "  <lambda value=\"" << size << "\"/>" << endl
+           << "  <inertia value=\"0.9\"/>" << endl
+           << "  <fitnessParameters value=\"" << m_configuration.objectives << "\"/>" << endl
+           << "  <maximumAge value=\"100\"/>" << endl
+           << "  <sigma value=\"0.9\"/>" << endl
+           << "  <invalidateFitnessAfterGeneration value=\"0\"/>" << endl
+           << "  <constraints value=\"" << m_constraintsFile << "\"/>" << endl
+           << "  <selection type=\"tournamentWithFitnessHole\" tau=\"2\" tauMin=\"1\" tauMax=\"4\" fitnessHole=\"0\"/>" << endl
+           << "  <evaluation>" << endl
+           << "    <evaluatorPathName value=\"true\"/>" << endl
+           << "    <evaluatorInputPathName value=\"individual.in\"/>" << endl
+           << "    <evaluatorOutputPathName value=\"fitness.out\"/>" << endl
+           << "  </evaluation>" << endl
+           << "  <operators default=\"all\"/>" << endl
+           << "</parameters>" << endl;
+}
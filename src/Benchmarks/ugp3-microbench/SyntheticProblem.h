@@ -0,0 +1,121 @@
+/***********************************************************************\
+|                                                                       |
+| SyntheticProblem.h                                                    |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#ifndef HEADER_UGP3_MICROBENCH_SYNTHETICPROBLEM
+#define HEADER_UGP3_MICROBENCH_SYNTHETICPROBLEM
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EvolutionaryCore.h"
+
+namespace ugp3 {
+namespace microbench {
+
+/**
+ * Multi-objective population that gives access to the internals timed by
+ * the micro-benchmarks.
+ */
+class BenchmarkPopulation : public core::MOPopulation
+{
+private:
+    // Fitness values given to each individual, used to undo the selection
+    std::vector<std::vector<double>> m_fitnessValues;
+    
+public:
+    BenchmarkPopulation(const core::EvolutionaryAlgorithm& parent)
+    : MOPopulation(parent)
+    {}
+    
+    using MOPopulation::computeLevels;
+    
+    void detectAndHandleClones() {
+        Population::detectAndHandleClones(m_individuals.begin(), m_individuals.end());
+    }
+    
+    /**
+     * Gives random fitness values to all the individuals and remembers them.
+     */
+    void assignRandomFitness();
+    
+    /**
+     * Brings back to life the individuals killed by the clone detection,
+     * with their original fitness.
+     */
+    void resurrect();
+};
+
+/**
+ * Constraints and population of configurable size, built from scratch.
+ * 
+ * The constraints describe one section of macros drawn from a pool of
+ * definedType, integer, float, bitArray and inner label parameters. They are
+ * written to a file (as are the population parameters) because constraints
+ * can only be loaded from a file; both files are removed once loaded.
+ */
+class SyntheticProblem
+{
+public:
+    struct Configuration
+    {
+        unsigned int macros = 8;        // distinct macros in the constraints
+        unsigned int nodes = 100;       // average macro instances per individual
+        unsigned int population = 50;   // random individuals
+        unsigned int clones = 5;        // additional copies of random individuals
+        unsigned int objectives = 2;    // fitness components
+    };
+    
+private:
+    Configuration m_configuration;
+    std::string m_constraintsFile;
+    std::string m_parametersFile;
+    std::unique_ptr<core::EvolutionaryAlgorithm> m_algorithm;
+    BenchmarkPopulation* m_population;
+    
+    void writeConstraints() const;
+    void writeParameters() const;
+    void removeFiles() const;
+    
+public:
+    SyntheticProblem(const Configuration& configuration);
+    
+    const Configuration& getConfiguration() const { return m_configuration; }
+    
+    BenchmarkPopulation& getPopulation() { return *m_population; }
+    
+    /**
+     * @return The i-th individual, modulo the size of the population.
+     */
+    core::Individual& getIndividual(unsigned int i) const {
+        return m_population->getIndividual(i % m_population->getIndividualCount());
+    }
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,220 @@
+#include "ugp3-genealogy.h"
+#include <iomanip>
+using namespace std;
+using namespace ugp3;
+using namespace ugp3::log;
+using namespace ugp3::core;
+
+string  inputFileName = "";
+string  individualID = "";
+string  groupID = "";
+int     levels = 0;
+
+#define PROGRAM_NAME            "ugp3-genealogy"
+#define OPTION_INDIVIDUALID     "individualID"
+#define OPTION_GROUPID          "groupID"
+#define OPTION_LEVELS           "levels"
+#define OPTION_HELP             "help"
+
+Handler* consoleHandler = nullptr;
+
+void showHelp(const string& programName)
+{
+    consoleHandler->pushFormatter(*new PlainFormatter());
+
+    LOG_INFO << "Usage: " << programName << " [options] genealogy.bin" << endl
+             << "Options: " << endl
+             << "  --" OPTION_INDIVIDUALID " <id>" << endl
+             << "  --" OPTION_GROUPID " <id>" << endl
+             << "  --" OPTION_LEVELS " <number> [0 = all the ancestors]" << ends;
+
+    LOG_INFO << "Description: "
+             << "    Queries a genealogy file written by ugp3 --genealogyFile. Without options, shows how many"
+             << " candidates each operator created and how many of them improved on their parents."
+             << " With an id, shows the lineage depth, the ancestry and the operator success chain of that candidate."
+
+             << endl << ends;
+
+    consoleHandler->popFormatter();
+}
+
+bool parseArguments(unsigned int argc, char* argv[])
+{
+    bool exitRequired = false;
+    const string& programName = argv[0];
+
+    if(argc <= 1)
+    {
+       showHelp(programName);
+       exitRequired = true;
+    }
+
+    for(unsigned int i = 1; i < argc && exitRequired == false; i += 2)
+    {
+        const string& command = argv[i];
+
+        // the last parameter is the name of the input file
+        if(i == argc - 1)
+        {
+            inputFileName = command;
+            continue;
+        }
+
+        if(command[0] != '-' || command[1] != '-')
+        {
+            throw Exception("Commandline syntax error: every command should start with '--'.", LOCATION);
+        }
+
+        if(command == "--" OPTION_HELP)
+        {
+            showHelp(programName);
+            exit(EXIT_SUCCESS);
+        }
+
+        // all the commands need an argument
+        if(i + 1 >= argc)
+        {
+            throw Exception("Missing commandline argument for option '" + command + "'.", LOCATION);
+        }
+
+        const string& value = argv[i + 1];
+        if(command == "--" OPTION_INDIVIDUALID)
+        {
+            individualID = value;
+        }
+        else if(command == "--" OPTION_GROUPID)
+        {
+            groupID = value;
+        }
+        else if(command == "--" OPTION_LEVELS)
+        {
+            levels = Convert::toInt(value);
+        }
+        else throw Exception("Unknown command '" + command + "'.", LOCATION);
+    }
+
+    return exitRequired;
+}
+
+string describe(const Genealogy& genealogy, const Genealogy::Record& record)
+{
+    ostringstream description;
+    description << (record.kind == Genealogy::GROUP ? "group " : "individual ")
+        << CandidateSolution::numberToId(record.id)
+        << " (generation " << record.generation
+        << ", operator " << genealogy.getOperatorNames()[record.operatorId]
+        << ", fitness";
+    if(record.racedOut)
+    {
+        description << " unknown, raced out";
+    }
+    else if(record.fitness.empty())
+    {
+        description << " unknown";
+    }
+    for(auto value: record.fitness)
+    {
+        description << " " << value;
+    }
+    description << ")";
+    return description.str();
+}
+
+void showCandidate(const Genealogy& genealogy, Genealogy::Kind kind, const string& id)
+{
+    const Genealogy::Record* record = genealogy.find(kind, CandidateSolution::idToNumber(id));
+    if(record == nullptr)
+    {
+        LOG_INFO << "No candidate with id='" << id << "' was found" << ends;
+        return;
+    }
+
+    LOG_INFO << describe(genealogy, *record) << endl
+             << "  lineage depth: " << genealogy.getLineageDepth(*record) << ends;
+
+    const vector<const Genealogy::Record*>& ancestry = genealogy.getAncestry(*record, levels);
+    LOG_INFO << "Ancestry (" << ancestry.size() << " known ancestors):" << ends;
+    for(auto ancestor: ancestry)
+    {
+        LOG_INFO << "  " << describe(genealogy, *ancestor) << ends;
+    }
+
+    LOG_INFO << "Operator success chain (following the fittest parent):" << ends;
+    for(const Genealogy::ChainLink& link: genealogy.getSuccessChain(*record))
+    {
+        LOG_INFO << "  " << (link.improvement ? "+ " : "  ") << describe(genealogy, *link.record) << ends;
+    }
+}
+
+void showOperators(const Genealogy& genealogy)
+{
+    const vector<Genealogy::OperatorSuccess>& success = genealogy.getOperatorSuccess();
+
+    LOG_INFO << genealogy.getRecords().size() << " candidates created by "
+             << success.size() << " operators" << ends;
+
+    ostringstream table;
+    table << setw(50) << left << "operator" << setw(12) << right << "births"
+          << setw(14) << "improvements" << setw(10) << "rate";
+    for(unsigned int i = 0; i < success.size(); i++)
+    {
+        const double rate = success[i].births ? (double)success[i].improvements / success[i].births : 0;
+        table << endl << setw(50) << left << genealogy.getOperatorNames()[i]
+              << setw(12) << right << success[i].births
+              << setw(14) << success[i].improvements
+              << setw(10) << fixed << setprecision(3) << rate;
+    }
+    LOG_INFO << table.str() << ends;
+}
+
+void runQueries()
+{
+    if(inputFileName.empty())
+    {
+        throw Exception("Commandline error: the genealogy file was not specified.", LOCATION);
+    }
+
+    LOG_INFO << "Loading genealogy ..." << ends;
+    Genealogy genealogy(inputFileName);
+    LOG_INFO << "Genealogy loaded" << ends;
+
+    consoleHandler->pushFormatter(*new PlainFormatter());
+    if(individualID != "")
+    {
+        showCandidate(genealogy, Genealogy::INDIVIDUAL, individualID);
+    }
+    if(groupID != "")
+    {
+        showCandidate(genealogy, Genealogy::GROUP, groupID);
+    }
+    if(individualID == "" && groupID == "")
+    {
+        showOperators(genealogy);
+    }
+    consoleHandler->popFormatter();
+}
+
+void setupLogging()
+{
+    consoleHandler = new ConsoleHandler();
+    consoleHandler->setLevel(Level::Info);
+    log_.addHandler(*consoleHandler);
+}
+
+#ifndef HAVE_CONFIG_H
+#define VERSION_REVISION 0
+#define VERSION_MAJOR 3
+#define VERSION_MINOR 0
+#define COPYRIGHT_NOTE "GPL public license"
+#endif
+
+void displayHeader()
+{
+    consoleHandler->pushFormatter(*new PlainFormatter());
+
+    LOG_INFO << endl << PROGRAM_NAME << " 1.0." << VERSION_REVISION << " for MicroGP++ v"
+             << VERSION_MAJOR << "." << VERSION_MINOR << ends;
+    LOG_INFO << COPYRIGHT_NOTE << ends;
+
+    consoleHandler->popFormatter();
+}
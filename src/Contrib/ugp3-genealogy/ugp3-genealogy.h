@@ -0,0 +1,23 @@
+#ifndef HEADER_UGP3_GENEALOGY
+#define HEADER_UGP3_GENEALOGY
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <exception>
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "ConsoleHandler.h"
+#include "PlainFormatter.h"
+#include "EvolutionaryCore.h"
+#include "Convert.h"
+
+void setupLogging();
+void displayHeader();
+bool parseArguments(unsigned int argc, char* argv[]);
+void runQueries();
+
+#endif
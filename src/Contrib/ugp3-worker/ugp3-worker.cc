@@ -0,0 +1,397 @@
+#include "ugp3-worker.h"
+
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#ifndef WINDOWS
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace ugp3;
+using namespace ugp3::log;
+using namespace ugp3::core;
+
+string  serverName = "localhost";
+unsigned int port = 0;
+string  sandbox = "";
+string  workerName = "";
+string  token = "";
+
+#define PROGRAM_NAME            "ugp3-worker"
+#define OPTION_SERVER           "server"
+#define OPTION_PORT             "port"
+#define OPTION_SANDBOX          "sandbox"
+#define OPTION_NAME             "name"
+#define OPTION_TOKEN            "token"
+#define OPTION_HELP             "help"
+
+// Seconds spent trying to reach a farm that is not listening yet
+#define CONNECTION_ATTEMPTS     30
+
+Handler* consoleHandler = nullptr;
+
+// Received with the SETUP message
+string scriptFile;
+string outputFile;
+chrono::milliseconds evaluationTimeout(0);
+chrono::milliseconds heartbeat(1000);
+bool removeTemporaryFiles = false;
+
+void showHelp(const string& programName)
+{
+    consoleHandler->pushFormatter(*new PlainFormatter());
+
+    LOG_INFO << "Usage: " << programName << " [options]" << endl
+             << "Options: " << endl
+             << "  --" OPTION_SERVER " <host> [default: localhost]" << endl
+             << "  --" OPTION_PORT " <number>" << endl
+             << "  --" OPTION_SANDBOX " <directory>" << endl
+             << "  --" OPTION_NAME " <name> [default: host:pid]" << endl
+             << "  --" OPTION_TOKEN " <token> [default: $UGP3_FARM_TOKEN]" << ends;
+
+    LOG_INFO << "Description: "
+             << "    Connects to the evaluation farm of a ugp3 run (see the element <farm> of the evaluator settings)"
+             << " and runs the evaluator script on the candidates it receives, in the current directory."
+             << " With --" OPTION_SANDBOX ", the worker creates the directory, links there the files of the current"
+             << " directory and evaluates inside it, so that several workers can share the same files."
+             << " The token must match the one of the farm; prefer the environment variable UGP3_FARM_TOKEN,"
+             << " since the command line is visible to the other users of the host."
+             << " The worker exits when the farm closes the connection."
+
+             << endl << ends;
+
+    consoleHandler->popFormatter();
+}
+
+bool parseArguments(unsigned int argc, char* argv[])
+{
+    bool exitRequired = false;
+    const string& programName = argv[0];
+
+    if(argc <= 1)
+    {
+       showHelp(programName);
+       exitRequired = true;
+    }
+
+    for(unsigned int i = 1; i < argc && exitRequired == false; i += 2)
+    {
+        const string& command = argv[i];
+
+        if(command[0] != '-' || command[1] != '-')
+        {
+            throw Exception("Commandline syntax error: every command should start with '--'.", LOCATION);
+        }
+
+        if(command == "--" OPTION_HELP)
+        {
+            showHelp(programName);
+            exit(EXIT_SUCCESS);
+        }
+
+        // all the commands need an argument
+        if(i + 1 >= argc)
+        {
+            throw Exception("Missing commandline argument for option '" + command + "'.", LOCATION);
+        }
+
+        const string& value = argv[i + 1];
+        if(command == "--" OPTION_SERVER)
+        {
+            serverName = value;
+        }
+        else if(command == "--" OPTION_PORT)
+        {
+            port = Convert::toUInt(value);
+        }
+        else if(command == "--" OPTION_SANDBOX)
+        {
+            sandbox = value;
+        }
+        else if(command == "--" OPTION_NAME)
+        {
+            workerName = value;
+        }
+        else if(command == "--" OPTION_TOKEN)
+        {
+            token = value;
+        }
+        else throw Exception("Unknown command '" + command + "'.", LOCATION);
+    }
+
+    return exitRequired;
+}
+
+void enterSandbox()
+{
+#ifdef WINDOWS
+    throw Exception("The option --" OPTION_SANDBOX " is not supported on this platform.", LOCATION);
+#else
+    File::createDirectory(sandbox);
+
+    DIR* directory = opendir(".");
+    if(directory == nullptr)
+    {
+        throw Exception("Could not read the current directory.", LOCATION);
+    }
+    vector<string> names;
+    while(struct dirent* entry = readdir(directory))
+    {
+        names.push_back(entry->d_name);
+    }
+    closedir(directory);
+
+    char* cwd = getcwd(nullptr, 0);
+    const string parent = cwd ? cwd : ".";
+    free(cwd);
+    if(chdir(sandbox.c_str()) != 0)
+    {
+        throw Exception("Could not enter the directory \"" + sandbox + "\".", LOCATION);
+    }
+
+    for(const string& name: names)
+    {
+        // The evaluator writes the fitness file: a link would overwrite the one of the farm
+        if(name == "." || name == ".." || name == sandbox || name == outputFile
+            || name.compare(0, 5, "farm.") == 0 || File::exists(name))
+        {
+            continue;
+        }
+        if(symlink((parent + "/" + name).c_str(), name.c_str()) != 0)
+        {
+            LOG_WARNING << "Could not link \"" << name << "\" in the sandbox" << ends;
+        }
+    }
+    LOG_INFO << "Evaluating in the sandbox \"" << sandbox << "\"" << ends;
+#endif
+}
+
+void setup(const string& payload)
+{
+    istringstream input(payload);
+    string value;
+    getline(input, scriptFile);
+    getline(input, outputFile);
+    getline(input, value);
+    evaluationTimeout = chrono::milliseconds(Convert::toULong(value));
+    getline(input, value);
+    heartbeat = chrono::milliseconds(Convert::toULong(value));
+    getline(input, value);
+    removeTemporaryFiles = value == "1";
+
+    LOG_INFO << "Evaluator \"" << scriptFile << "\", fitness file \"" << outputFile << "\"" << ends;
+}
+
+/**
+ * Sends a heartbeat if one is due. Returns false if the farm is lost.
+ */
+bool beat(Socket& farm, chrono::steady_clock::time_point& lastBeat)
+{
+    const auto now = chrono::steady_clock::now();
+    if(now - lastBeat < heartbeat)
+    {
+        return true;
+    }
+    lastBeat = now;
+    return farm.send(FarmProtocol::HEARTBEAT, 0);
+}
+
+void evaluate(Socket& farm, unsigned long id, const string& payload, chrono::steady_clock::time_point& lastBeat)
+{
+    vector<string> inputFiles;
+    const string& arguments = FarmProtocol::unpackFiles(payload, inputFiles);
+
+    // Same environment as an evaluator run by ugp3
+    istringstream argumentStream(arguments);
+    ofstream individualsListFile("individualsToEvaluate.txt");
+    unsigned int candidates = 0;
+    string fileName;
+    while(argumentStream >> fileName)
+    {
+        individualsListFile << fileName << endl;
+        candidates++;
+    }
+    individualsListFile.close();
+    SETENV("UGP3_OFFSPRING", arguments.c_str());
+    SETENV("UGP3_FITNESS_FILE", outputFile);
+    SETENV("UGP3_STAGE", "1");
+    SETENV("UGP3_STAGES", "1");
+    File::remove(outputFile);
+
+    const string commandLine = scriptFile + " " + arguments;
+    LOG_VERBOSE << "Job " << id << ": executing \"" << commandLine << "\"" << ends;
+    int pid = Process::spawn(commandLine);
+    if(pid < 0)
+    {
+        throw Exception("Could not run the evaluator \"" + commandLine + "\".", LOCATION);
+    }
+
+    // Keep beating while the evaluator runs
+    const auto deadline = chrono::steady_clock::now() + evaluationTimeout * candidates;
+    bool timedOut = false;
+    int status = 0;
+    while(Process::hasExited(pid, status) == false)
+    {
+        if(evaluationTimeout.count() != 0 && chrono::steady_clock::now() >= deadline)
+        {
+            Process::kill(pid);
+            timedOut = true;
+            break;
+        }
+        if(beat(farm, lastBeat) == false)
+        {
+            Process::kill(pid);
+            return;
+        }
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+
+    if(timedOut)
+    {
+        LOG_WARNING << "Job " << id << ": the evaluator has been killed after exceeding the time limit" << ends;
+        farm.send(FarmProtocol::TIMEOUT, id);
+    }
+    else
+    {
+        ifstream fitnessFile(outputFile.c_str(), ios::binary);
+        if(fitnessFile.is_open() == false)
+        {
+            farm.send(FarmProtocol::FAILURE, id, "the evaluator did not create the fitness file \"" + outputFile + "\".");
+        }
+        else
+        {
+            ostringstream output;
+            output << fitnessFile.rdbuf();
+            farm.send(FarmProtocol::RESULT, id, output.str());
+        }
+    }
+
+    // clean up the temporary files
+    File::remove(outputFile);
+    File::remove("individualsToEvaluate.txt");
+    if(removeTemporaryFiles)
+    {
+        for(auto& file: inputFiles)
+        {
+            File::remove(file);
+        }
+    }
+}
+
+void runWorker()
+{
+    if(port == 0)
+    {
+        throw Exception("Commandline error: the port of the farm was not specified.", LOCATION);
+    }
+
+    // The evaluator does not need to know the token
+    if(token.empty())
+    {
+        token = GETENV("UGP3_FARM_TOKEN");
+    }
+    SETENV("UGP3_FARM_TOKEN", "");
+
+    if(workerName.empty())
+    {
+#ifdef WINDOWS
+        workerName = "worker";
+#else
+        char host[256] = "";
+        gethostname(host, sizeof(host) - 1);
+        workerName = string(host) + ":" + Convert::toString(getpid());
+#endif
+    }
+
+    Socket farm;
+    for(unsigned int attempt = 1; farm.isOpen() == false; attempt++)
+    {
+        try
+        {
+            farm.connect(serverName, port);
+        }
+        catch(const Exception&)
+        {
+            if(attempt == CONNECTION_ATTEMPTS)
+            {
+                throw;
+            }
+            this_thread::sleep_for(chrono::seconds(1));
+        }
+    }
+    LOG_INFO << "Connected to the farm at " << serverName << ":" << port << " as " << workerName << ends;
+    farm.send(FarmProtocol::HELLO, 0, workerName + "\n" + token);
+
+    auto lastBeat = chrono::steady_clock::now();
+    vector<Socket*> sockets(1, &farm);
+    vector<bool> ready;
+    unsigned long jobs = 0;
+    while(true)
+    {
+        Socket::wait(sockets, heartbeat, ready);
+        if(ready[0])
+        {
+            if(farm.receive() == false)
+            {
+                break;
+            }
+
+            string keyword;
+            unsigned long id;
+            string payload;
+            while(farm.nextMessage(keyword, id, payload))
+            {
+                if(keyword == FarmProtocol::SETUP)
+                {
+                    setup(payload);
+                    if(sandbox.empty() == false)
+                    {
+                        enterSandbox();
+                    }
+                }
+                else if(keyword == FarmProtocol::JOB)
+                {
+                    evaluate(farm, id, payload, lastBeat);
+                    jobs++;
+                }
+                else
+                {
+                    LOG_WARNING << "Ignoring the unknown message " << keyword << ends;
+                }
+            }
+        }
+        if(beat(farm, lastBeat) == false)
+        {
+            break;
+        }
+    }
+    LOG_INFO << "The farm closed the connection after " << jobs << " jobs" << ends;
+}
+
+void setupLogging()
+{
+    consoleHandler = new ConsoleHandler();
+    consoleHandler->setLevel(Level::Info);
+    log_.addHandler(*consoleHandler);
+}
+
+#ifndef HAVE_CONFIG_H
+#define VERSION_REVISION 0
+#define VERSION_MAJOR 3
+#define VERSION_MINOR 0
+#define COPYRIGHT_NOTE "GPL public license"
+#endif
+
+void displayHeader()
+{
+    consoleHandler->pushFormatter(*new PlainFormatter());
+
+    LOG_INFO << endl << PROGRAM_NAME << " 1.0." << VERSION_REVISION << " for MicroGP++ v"
+             << VERSION_MAJOR << "." << VERSION_MINOR << ends;
+    LOG_INFO << COPYRIGHT_NOTE << ends;
+
+    consoleHandler->popFormatter();
+}
@@ -0,0 +1,28 @@
+#ifndef HEADER_UGP3_WORKER
+#define HEADER_UGP3_WORKER
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <exception>
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "ConsoleHandler.h"
+#include "PlainFormatter.h"
+#include "EvolutionaryCore.h"
+#include "EvaluatorFarmDispatcher.h"
+#include "Convert.h"
+#include "Environment.h"
+#include "File.h"
+#include "Process.h"
+#include "Socket.h"
+
+void setupLogging();
+void displayHeader();
+bool parseArguments(unsigned int argc, char* argv[]);
+void runWorker();
+
+#endif
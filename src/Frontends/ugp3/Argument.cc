@@ -51,12 +51,23 @@ const string Argument::TextOnly = "text-only";
 const string Argument::Brief = "brief";
 const string Argument::Extended = "extended";
 const string Argument::Log = "log";
+const string Argument::LogQueueSize = "logQueueSize";
+const string Argument::LogOverflow = "logOverflow";
+const string Argument::LogProgressInterval = "logProgressInterval";
 
 // evolution
 const string Argument::RandomSeed = "randomSeed";
 const string Argument::StatisticsPathName = "statisticsPathName";
 const string Argument::Population = "population";
 const string Argument::Merge = "merge";
+const string Argument::Profile = "profile";
+const string Argument::ProfileTrace = "profileTrace";
+const string Argument::GenealogyFile = "genealogyFile";
+const string Argument::MemoryStatistics = "memoryStatistics";
+const string Argument::Benchmark = "benchmark";
+const string Argument::BenchmarkCost = "benchmarkCost";
+const string Argument::EntropicSketchSize = "entropicSketchSize";
+const string Argument::EntropicSketchCheck = "entropicSketchCheck";
 const string Argument::Migration = "migration";
 
 // evaluation
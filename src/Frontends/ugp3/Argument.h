@@ -88,6 +88,12 @@ namespace ugp3
             static const std::string Brief;
             /** To specify that the log have to be written the extended format. */
             static const std::string Extended;
+            /** To specify the size of the queue of the log writer thread (0 = no writer thread). */
+            static const std::string LogQueueSize;
+            /** To specify what to do when the queue of the log writer is full (block or drop). */
+            static const std::string LogOverflow;
+            /** To specify the minimum time in milliseconds between two updates of a progress bar. */
+            static const std::string LogProgressInterval;
             /** To print all available operators and their descriptions. */
             static const std::string Operators;
 
@@ -112,6 +118,22 @@ namespace ugp3
             static const std::string Population;
             /** To specify populations to merge before start. */
             static const std::string Merge;
+            /** To add the time spent in each phase of a generation to the statistics. */
+            static const std::string Profile;
+            /** To specify a file where a trace of the phases is written (Chrome trace-event format). */
+            static const std::string ProfileTrace;
+            /** To specify a file where the genealogy of all the candidates is appended. */
+            static const std::string GenealogyFile;
+            /** To add the memory retained by each population to the statistics. */
+            static const std::string MemoryStatistics;
+            /** To run the given number of generations with the synthetic evaluator and report the speed of the engine. */
+            static const std::string Benchmark;
+            /** To specify the time (in microseconds) spent by the synthetic evaluator on each candidate. */
+            static const std::string BenchmarkCost;
+            /** To specify the number of symbols kept by the sketches used by the approximate entropic distance. */
+            static const std::string EntropicSketchSize;
+            /** To log the error of the approximate entropic distance on the populations. */
+            static const std::string EntropicSketchCheck;
 
             /** To specify how and when migration of individuals between populations should happen. */
             static const std::string Migration;
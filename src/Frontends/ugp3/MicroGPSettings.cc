@@ -77,6 +77,38 @@ void MicroGPSettings::initialize()
 	context->getOption(Argument::StatisticsPathName).setDescription(
 	    "File where evolution statistics are to be saved.");
 
+	context->addOption(Argument::Profile, "false", "boolean");
+	context->getOption(Argument::Profile).setDescription(
+	    "Add the time spent in each phase of a generation (in milliseconds) to the statistics.");
+
+	context->addOption(Argument::ProfileTrace, "", "string");
+	context->getOption(Argument::ProfileTrace).setDescription(
+	    "File where a trace of the phases of each generation is written, in the Chrome trace-event format. Implies profiling.");
+
+	context->addOption(Argument::GenealogyFile, "", "string");
+	context->getOption(Argument::GenealogyFile).setDescription(
+	    "Binary file where the parents, operator and fitness of every new candidate are appended (see ugp3-genealogy).");
+
+	context->addOption(Argument::MemoryStatistics, "false", "boolean");
+	context->getOption(Argument::MemoryStatistics).setDescription(
+	    "Add the memory retained by the candidates, the lineage and the evaluation cache of each population (in bytes) and the allocator statistics to the statistics.");
+
+	context->addOption(Argument::Benchmark, "0", "integer");
+	context->getOption(Argument::Benchmark).setDescription(
+	    "Run the given number of generations with the synthetic evaluator, then report generations per second, offspring per second and peak memory. 0 = disabled.");
+
+	context->addOption(Argument::EntropicSketchSize, "128", "integer");
+	context->getOption(Argument::EntropicSketchSize).setDescription(
+	    "Number of symbols kept by the sketch of each entropic message, used by the approximate entropic distance.");
+
+	context->addOption(Argument::EntropicSketchCheck, "false", "boolean");
+	context->getOption(Argument::EntropicSketchCheck).setDescription(
+	    "Compare the approximate and the exact entropic distances on each population at every generation, and log the error.");
+
+	context->addOption(Argument::BenchmarkCost, "0", "integer");
+	context->getOption(Argument::BenchmarkCost).setDescription(
+	    "Time (in microseconds) spent by the synthetic evaluator on each candidate in benchmark mode.");
+
     	// Is it true? Indexes or "names"???? (!)20090717gx
     	context->addOption(Argument::Merge, "", "string");
 	context->getOption(Argument::Merge).setDescription(
@@ -121,6 +153,20 @@ void MicroGPSettings::initialize()
         "Only essential information on standard output");
 
     this->addContext(std::move(context));
+
+    // log writer
+    context = unique_ptr<SettingsContext>( new SettingsContext("logWriter") );
+    context->addOption(Argument::LogQueueSize, "4096", "integer");
+    context->getOption(Argument::LogQueueSize).setDescription(
+        "Messages waiting to be written by the log thread. Set to 0 to write them from the evolution thread.");
+    context->addOption(Argument::LogOverflow, "block", "string");
+    context->getOption(Argument::LogOverflow).setDescription(
+        "When the log queue is full, 'block' waits for the log thread, 'drop' discards the message (errors and warnings are never discarded).");
+    context->addOption(Argument::LogProgressInterval, "100", "integer");
+    context->getOption(Argument::LogProgressInterval).setDescription(
+        "Minimum time in milliseconds between two updates of a progress bar.");
+
+    this->addContext(std::move(context));
 }
 
 void MicroGPSettings::initializeSettingsFile()
@@ -189,4 +235,15 @@ void MicroGPSettings::initializeSettingsFile()
         "Debug information, stored in 'debug.log'");
 
     this->addContext(std::move(context));
+
+    // log writer
+    context = unique_ptr<SettingsContext>( new SettingsContext("logWriter") );
+    context->addOption(Argument::LogQueueSize, "4096", "integer");
+    context->getOption(Argument::LogQueueSize).setDescription(
+        "Messages waiting to be written by the log thread. Set to 0 to write them from the evolution thread.");
+    context->addOption(Argument::LogOverflow, "block", "string");
+    context->getOption(Argument::LogOverflow).setDescription(
+        "When the log queue is full, 'block' waits for the log thread, 'drop' discards the message.");
+
+    this->addContext(std::move(context));
 }
@@ -33,6 +33,7 @@
 
 #include "ugp3_config.h"
 #include "Program.h"
+#include "Process.h"
 
 // ADD HERE: include headers of new types of populations and genetic operators
 #include "EnhancedPopulation.h"
@@ -413,6 +414,46 @@ void Program::run()
 #endif
     }
 
+    // Benchmark mode: measure the overhead of the engine, without external evaluators
+    const unsigned long benchmarkGenerations = settings.getOption("evolution", Argument::Benchmark).toLong();
+    if (benchmarkGenerations > 0)
+    {
+        const chrono::microseconds cost(settings.getOption("evolution", Argument::BenchmarkCost).toLong());
+        for (unsigned int i = 0; i < algorithm->getPopulationCount(); i++)
+        {
+            Evaluator& evaluator = algorithm->getPopulation(i).getParameters().getEvaluator();
+            evaluator.setType(Evaluator::TYPE_SYNTHETIC);
+            evaluator.setSyntheticCost(cost);
+        }
+        LOG_INFO << "Benchmark mode: " << benchmarkGenerations << " generations with the synthetic evaluator ("
+            << cost.count() << " microseconds per evaluation)" << ends;
+    }
+
+    // Measure the phases of each generation (the columns are added to the statistics)
+    const string& traceFile = settings.getOption("evolution", Argument::ProfileTrace).getValue();
+    if (traceFile.empty() == false)
+    {
+        Profiler::openTrace(traceFile);
+    }
+    else if (settings.getOption("evolution", Argument::Profile).toBool())
+    {
+        Profiler::setEnabled(true);
+    }
+    
+    // Measure the memory retained by each population (the columns are added to the statistics)
+    MemoryUsage::setEnabled(settings.getOption("evolution", Argument::MemoryStatistics).toBool());
+    
+    // Sketches used by the approximate entropic distance
+    MessageSketch::setSize(settings.getOption("evolution", Argument::EntropicSketchSize).toLong());
+    MessageSketch::setCheckEnabled(settings.getOption("evolution", Argument::EntropicSketchCheck).toBool());
+    
+    // Keep the history of all the new candidates on disk
+    const string& genealogyFile = settings.getOption("evolution", Argument::GenealogyFile).getValue();
+    if (genealogyFile.empty() == false)
+    {
+        Genealogy::open(genealogyFile);
+    }
+
     // Initialize statistics stream for the algorithm (where all population's statistics will be written to)
     algorithm->openStatisticsStream();
     
@@ -485,10 +526,52 @@ void Program::run()
         }
     }
 
+    vector<unsigned int> startGenerations;
+    if (benchmarkGenerations > 0)
+    {
+        for (unsigned int i = 0; i < algorithm->getPopulationCount() ; i++)
+        {
+            startGenerations.push_back(algorithm->getPopulation(i).getGeneration());
+            algorithm->getPopulation(i).getParameters().setMaximumGenerations(startGenerations.back() + benchmarkGenerations);
+            algorithm->getPopulation(i).getParameters().clearStopConditions();
+        }
+    }
+    const uint64_t startIndividuals = InfinityString::toNumber(Individual::getIndividualCounter());
+    const uint64_t startGroups = InfinityString::toNumber(Group::getGroupCounter());
+    const auto startTime = chrono::steady_clock::now();
+
     // Run the evolution.
     LOG_DEBUG << "Starting evolution" << ends;
 
     algorithm->run();
+    Profiler::closeTrace();
+    Genealogy::close();
+
+    if (benchmarkGenerations > 0)
+    {
+        const double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+        // offspring are the candidates created by the operators (individuals, and groups in group populations)
+        const uint64_t offspring = InfinityString::toNumber(Individual::getIndividualCounter()) - startIndividuals
+            + InfinityString::toNumber(Group::getGroupCounter()) - startGroups;
+        unsigned int generations = 0;
+        for (unsigned int i = 0; i < algorithm->getPopulationCount() ; i++)
+        {
+            generations = max(generations, algorithm->getPopulation(i).getGeneration() - startGenerations[i]);
+        }
+        if (generations < benchmarkGenerations)
+        {
+            LOG_WARNING << "The evolution stopped after " << generations << " generations instead of " << benchmarkGenerations << ends;
+        }
+
+        ostringstream report;
+        report.setf(ios::fixed);
+        report.precision(2);
+        report << "Benchmark: " << generations << " generations, " << offspring << " offspring in " << seconds << " s: "
+            << (seconds > 0 ? generations / seconds : 0) << " generations/s, "
+            << (seconds > 0 ? offspring / seconds : 0) << " offspring/s, peak memory "
+            << Process::getPeakMemory() / 1024.0 << " MiB";
+        LOG_INFO << report.str() << ends;
+    }
 
     // Write best individuals to file
     for (unsigned int i = 0; i < algorithm->getPopulationCount() ; i++)
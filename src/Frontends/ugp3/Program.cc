@@ -118,6 +118,20 @@ void Program::setupLogger()
         }
 
     }
+
+    // from now on, messages are written by a background thread (if enabled)
+    if (Program::settings.hasContext("logWriter"))
+    {
+        SettingsContext& writerContext = Program::settings.getContext("logWriter");
+        unsigned int queueSize = writerContext.getOption(Argument::LogQueueSize).toUInt();
+        if (queueSize > 0)
+        {
+            Log::OverflowPolicy policy = Log::parseOverflowPolicy(writerContext.getOption(Argument::LogOverflow).getValue());
+            unsigned int progressInterval = writerContext.hasOption(Argument::LogProgressInterval) ?
+                writerContext.getOption(Argument::LogProgressInterval).toUInt() : 0;
+            ::log_.startWriter(queueSize, policy, std::chrono::milliseconds(progressInterval));
+        }
+    }
 }
 
 
@@ -395,6 +409,14 @@ bool Program::parseArguments(
                     index += 3;
                 } else throw Exception(Argument::Log, LOCATION);
             } 
+            else if (argument == Argument::LogQueueSize || argument == Argument::LogOverflow)
+            {
+                if (index + 1 < argumentCount)
+                {
+                    settings.getOption("logWriter", argument).setValue(arguments[index + 1]);
+                    index++;
+                } else throw Exception(argument, LOCATION);
+            }
             else if (argument == Argument::FitnessRemoveTempFiles)
             {
                 if (index + 1 < argumentCount)
@@ -440,6 +462,68 @@ bool Program::parseArguments(
                     index++;
                 } else throw Exception(Argument::RandomSeed, LOCATION);
             }
+            else if (argument == Argument::Profile)
+            {
+                settings.getOption("evolution", Argument::Profile).setValue("true");
+            }
+            else if (argument == Argument::MemoryStatistics)
+            {
+                settings.getOption("evolution", Argument::MemoryStatistics).setValue("true");
+            }
+            else if (argument == Argument::ProfileTrace)
+            {
+                if (index + 1 < argumentCount)
+                {
+                    settings.getOption("evolution", Argument::ProfileTrace)
+                    .setValue(arguments[index + 1]);
+                    
+                    index++;
+                } else throw Exception(Argument::ProfileTrace, LOCATION);
+            }
+            else if (argument == Argument::GenealogyFile)
+            {
+                if (index + 1 < argumentCount)
+                {
+                    settings.getOption("evolution", Argument::GenealogyFile)
+                    .setValue(arguments[index + 1]);
+                    
+                    index++;
+                } else throw Exception(Argument::GenealogyFile, LOCATION);
+            }
+            else if (argument == Argument::Benchmark)
+            {
+                if (index + 1 < argumentCount)
+                {
+                    settings.getOption("evolution", Argument::Benchmark)
+                    .setValue(arguments[index + 1]);
+                    
+                    index++;
+                } else throw Exception(Argument::Benchmark, LOCATION);
+            }
+            else if (argument == Argument::BenchmarkCost)
+            {
+                if (index + 1 < argumentCount)
+                {
+                    settings.getOption("evolution", Argument::BenchmarkCost)
+                    .setValue(arguments[index + 1]);
+                    
+                    index++;
+                } else throw Exception(Argument::BenchmarkCost, LOCATION);
+            }
+            else if (argument == Argument::EntropicSketchSize)
+            {
+                if (index + 1 < argumentCount)
+                {
+                    settings.getOption("evolution", Argument::EntropicSketchSize)
+                    .setValue(arguments[index + 1]);
+                    
+                    index++;
+                } else throw Exception(Argument::EntropicSketchSize, LOCATION);
+            }
+            else if (argument == Argument::EntropicSketchCheck)
+            {
+                settings.getOption("evolution", Argument::EntropicSketchCheck).setValue("true");
+            }
             else if (argument == Argument::StatisticsPathName)
             {
                 if (index + 1 < argumentCount)
@@ -715,7 +799,15 @@ void Program::displayArgumentsUsage()
     << "    --further <num>" << endl
     << "    --" << Argument::AllOperatorsEnabled << " | --" << Argument::AllOperatorsDisabled << endl
     << "    --log <file> <level> <format>" << endl
+    << "    --" << Argument::LogQueueSize << " <num> [0 = no log thread]" << endl
+    << "    --" << Argument::LogOverflow << " block | drop" << endl
     << "    --statisticsPathName <file.csv>" << endl
+    << "    --" << Argument::Profile << ", --" << Argument::ProfileTrace << " <trace.json>" << endl
+    << "    --" << Argument::GenealogyFile << " <genealogy.bin>" << endl
+    << "    --" << Argument::MemoryStatistics << " [UGP3_MEMORY_REQUESTED or SIGUSR1: detailed report]" << endl
+    << "    --" << Argument::Benchmark << " <generations> [synthetic evaluator]" << endl
+    << "    --" << Argument::BenchmarkCost << " <microseconds>" << endl
+    << "    --" << Argument::EntropicSketchSize << " <num>, --" << Argument::EntropicSketchCheck << endl
     << "    --randomSeed <num> [0 = seconds from The Epoch]" << endl
     << ends;
     
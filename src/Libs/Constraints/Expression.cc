@@ -30,6 +30,7 @@
 using namespace std;
 using namespace ugp3::constraints;
 
+constexpr const char* Expression::TagEscape;
 
 Expression::Expression(const GenericMacro *parent, const vector<ExpressionElement*> *elements)
 	: parent(parent)
@@ -42,11 +43,59 @@ Expression::Expression(const GenericMacro *parent, const vector<ExpressionElemen
 	}
 
 	this->elements = *elements;
+	this->compile();
 }
 
 void Expression::clear()
 {
 	this->elements.clear();
+	this->program.clear();
+}
+
+void Expression::compile()
+{
+	_STACK;
+
+	this->program.clear();
+
+	for(unsigned int i = 0; i < this->elements.size(); i++)
+	{
+		const Parameter* parameter = this->elements[i]->getParameter();
+
+		if(parameter == nullptr)
+		{
+			// merge adjacent fixed texts
+			if(this->program.empty() == false && this->program.back().kind == LITERAL)
+			{
+				this->program.back().text += *this->elements[i]->getCharacters();
+			}
+			else
+			{
+				this->program.push_back(EmissionStep{LITERAL, *this->elements[i]->getCharacters()});
+			}
+		}
+		else if(dynamic_cast<const DataParameter*>(parameter) != nullptr)
+		{
+			this->program.push_back(EmissionStep{DATA, TagEscape + parameter->getName()});
+		}
+		else if(dynamic_cast<const UniqueTagParameter*>(parameter) != nullptr)
+		{
+			this->program.push_back(EmissionStep{UNIQUETAG, TagEscape + parameter->getName()});
+		}
+		else if(dynamic_cast<const SelfRefParameter*>(parameter) != nullptr)
+		{
+			this->program.push_back(EmissionStep{SELFREF, TagEscape + parameter->getName()});
+		}
+		else if(dynamic_cast<const InnerLabelParameter*>(parameter) != nullptr)
+		{
+			this->program.push_back(EmissionStep{INNERLABEL, parameter->getName()});
+		}
+		else if(dynamic_cast<const OuterLabelParameter*>(parameter) != nullptr)
+		{
+			this->program.push_back(EmissionStep{OUTERLABEL, parameter->getName()});
+		}
+		// other parameters do not appear in the phenotype
+	}
 }
 
 
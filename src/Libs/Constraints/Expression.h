@@ -50,14 +50,53 @@ namespace ugp3
             @author Aimo Alessandro, Salomone Alessandro. */
         class Expression : public xml::XMLIFace
         {
+        public:
+            /** Kinds of steps of an emission program. */
+            typedef enum
+            {
+                /** A chunk of fixed text */
+                LITERAL,
+                /** The value of a data parameter, stored in a node tag */
+                DATA,
+                /** The value of a unique tag parameter, stored in a node tag */
+                UNIQUETAG,
+                /** The value of a self reference parameter, stored in a node tag */
+                SELFREF,
+                /** The label of the target of an inner label parameter */
+                INNERLABEL,
+                /** The label (or the expansion) of the target of an outer label parameter */
+                OUTERLABEL
+            } EmissionKind;
+
+            /** A step of the emission program: a literal chunk or a typed parameter slot. */
+            struct EmissionStep
+            {
+                EmissionKind kind;
+                /** The literal text for LITERAL, the name of the node tag
+                    holding the value for DATA, UNIQUETAG and SELFREF,
+                    the name of the parameter (and of the edge) for
+                    INNERLABEL and OUTERLABEL. */
+                std::string text;
+            };
+
+            /** Prefix of the names of the node tags that hold the values of the parameters. */
+            static constexpr const char* TagEscape = "$";
+
         private: // Fields
             /** The elements of the expression. */
             std::vector<ExpressionElement*> elements;
 
             /** The macro containing this expression. */
             const GenericMacro *parent;
+
+            /** The expression compiled to a flat list of steps, so that
+                phenotypes are written without inspecting the parameters. */
+            std::vector<EmissionStep> program;
             
             void clear();
+
+            /** Builds the emission program from the elements. */
+            void compile();
             static const std::string XML_NAME;
 
         public: // Constructors and destructors
@@ -75,6 +114,11 @@ namespace ugp3
  			/** Gets The elements of the expression. 
                 @return The elements of the expression. */
             const std::vector<ExpressionElement*>& getElements() const;
+
+            /** Gets the emission program of the expression, built when the constraints are loaded.
+                Adjacent fixed texts are merged in a single LITERAL step.
+                @return The steps of the emission program. */
+            const std::vector<EmissionStep>& getProgram() const;
 		
 		/** Gets the regex for the whole expression, building on the regex for the parameters and fixed parts.
 		    @return A const string containing the regex for the expression.*/
@@ -96,6 +140,11 @@ namespace ugp3
         {
             return elements;
         }
+
+        inline const std::vector<Expression::EmissionStep>& Expression::getProgram() const
+        {
+            return program;
+        }
         
         inline const std::string& Expression::getXmlName() const
 		{
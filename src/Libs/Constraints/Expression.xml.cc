@@ -98,6 +98,8 @@ void Expression::readXml(const xml::Element& element)
 
 		exprNode = element.IterateChildren(exprNode);
 	}
+
+	this->compile();
 }
 
 void Expression::writeXml(ostream& output) const
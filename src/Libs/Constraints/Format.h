@@ -58,6 +58,9 @@ public:
 	
 	virtual std::string get(const std::string& value) const;
 
+	/** Appends the formatted value to the buffer, like get() without building a temporary string. */
+	void appendTo(std::string& buffer, const std::string& value) const;
+
 	const std::string& getTextBefore() const;
 	const std::string& getTextAfter() const;
 	
@@ -93,6 +96,8 @@ public:
     LabelFormat();
     LabelFormat(const std::string& textBefore, const std::string& textAfter);
     virtual std::string get(const std::string& value) const;
+    /** Appends get(identifier.get(value)) to the buffer. */
+    void appendTo(std::string& buffer, const Format& identifier, const std::string& value) const;
     virtual const std::string& getXmlName() const;
     virtual void writeXml(std::ostream& output) const;
 	virtual void readXml(const xml::Element& element);
@@ -138,6 +143,23 @@ inline std::string Format::get(const std::string& value) const
 	return textBefore + value + textAfter;
 }
 
+inline void Format::appendTo(std::string& buffer, const std::string& value) const
+{
+	buffer += textBefore;
+	buffer += value;
+	buffer += textAfter;
+}
+
+inline void LabelFormat::appendTo(std::string& buffer, const Format& identifier, const std::string& value) const
+{
+	buffer += textBefore;
+	if(this->textAfter != "")
+	{
+		identifier.appendTo(buffer, value);
+		buffer += textAfter;
+	}
+}
+
 inline UniqueTagFormat::UniqueTagFormat()
 { }
 
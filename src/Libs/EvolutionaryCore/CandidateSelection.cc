@@ -50,6 +50,24 @@ void CandidateSelection::sortByFitness(const Population& population, CandVecIt b
     });
 }
 
+void CandidateSelection::sortSelectableByFitness(const Population& population) const
+{
+    if (m_range == nullptr) {
+        sortByFitness(population, m_selectable.begin(), m_selectable.end());
+    } else if (m_reverse) {
+        Assert(m_selectable.size() == m_range->byFitness.size());
+        m_selectable.assign(m_range->byFitness.rbegin(), m_range->byFitness.rend());
+    } else {
+        Assert(m_selectable.size() == m_range->byFitness.size());
+        m_selectable.assign(m_range->byFitness.begin(), m_range->byFitness.end());
+    }
+}
+
+const SelectionKeys& CandidateSelection::getSelectionKeys(const Population& population)
+{
+    return population.getSelectionKeys();
+}
+
 void CandidateSelection::sortByHole(const Population& population, CandVecIt begin, CandVecIt end) const 
 {
     std::sort(begin, end, [&] (CandidateSolution* a, CandidateSolution* b) {
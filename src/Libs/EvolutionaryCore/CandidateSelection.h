@@ -35,6 +35,7 @@
 #define HEADER_UGP3_CORE_INDIVIDUALSELECTION
 
 #include "CandidateSolution.h"
+#include "SelectionKeys.h"
 #include "Random.h"
 
 #include <numeric>
@@ -72,12 +73,26 @@ protected:
     mutable bool m_reverse = false;
     // List of candidates among which the selection is performed.
     mutable std::vector<CandidateSolution*> m_selectable;
+    // Selection index of the population for m_selectable, if any.
+    mutable const SelectionKeys::Range* m_range = nullptr;
     
     typedef std::vector<CandidateSolution*>::iterator CandVecIt;
     
     void sortByFitness(const Population& population, CandVecIt begin, CandVecIt end) const;
     void sortByHole(const Population& population, CandVecIt begin, CandVecIt end) const;
     
+    /**
+     * Sorts the whole m_selectable by fitness, like sortByFitness(), using
+     * the order precomputed by the selection index when there is one.
+     */
+    void sortSelectableByFitness(const Population& population) const;
+    
+    /**
+     * @return The selection keys of the given population.
+     * Defined out of line because Population is incomplete here.
+     */
+    static const SelectionKeys& getSelectionKeys(const Population& population);
+    
     /**
      * Utility function to avoid code duplication.
      * Does `count' times the following operations:
@@ -151,15 +166,22 @@ public:
         if (count == 0) {
             return {};
         }
-        m_selectable.clear();
-        for (auto it = begin; it != end; ++it) {
-            Assert(*it);
-            if ((*it)->isAlive()) {
-                m_selectable.push_back(*it);
+        // While breeding, the live candidates of the population's own
+        // containers are already filtered and sorted
+        m_range = getSelectionKeys(population).findRange(begin, end);
+        if (m_range) {
+            m_selectable.assign(m_range->byId.begin(), m_range->byId.end());
+        } else {
+            m_selectable.clear();
+            for (auto it = begin; it != end; ++it) {
+                Assert(*it);
+                if ((*it)->isAlive()) {
+                    m_selectable.push_back(*it);
+                }
             }
+            // NOTE/DET Sort selectable by id so that the selection depends only on random state and comparison functions.
+            std::sort(m_selectable.begin(), m_selectable.end(), CandidateSolution::OrderById());
         }
-        // NOTE/DET Sort selectable by id so that the selection depends only on random state and comparison functions.
-        std::sort(m_selectable.begin(), m_selectable.end(), CandidateSolution::OrderById());
         
         if (m_selectable.size() <= count) {
             LOG_VERBOSE << "Candidate selection: not enough candidates to select from, returning all of them." << std::ends;
@@ -31,6 +31,7 @@
 
 #include "CandidateSolution.h"
 #include "Population.h"
+#include "MemoryUsage.h"
 
 using namespace std;
 
@@ -48,8 +49,29 @@ void CandidateSolution::setAllopatricTagCounter(const string& value)
     allopatricTagCounter = newVal;
 }
 
+std::uint64_t CandidateSolution::idToNumber(const string& id)
+{
+    // Temporary groups come after all the others
+    static const string temporaryPrefix = "TMP_";
+    if (id.compare(0, temporaryPrefix.size(), temporaryPrefix) == 0) {
+        return (std::uint64_t(1) << 63) | InfinityString::toNumber(id.substr(temporaryPrefix.size()));
+    }
+    return InfinityString::toNumber(id);
+}
+
+string CandidateSolution::numberToId(std::uint64_t number)
+{
+    static const std::uint64_t temporaryBit = std::uint64_t(1) << 63;
+    if (number & temporaryBit) {
+        return "TMP_" + InfinityString::fromNumber(number & ~temporaryBit);
+    }
+    return InfinityString::fromNumber(number);
+}
+
 CandidateSolution::CandidateSolution(const Population& population, const string& id)
 : m_id(id),
+m_numericId(idToNumber(id)),
+m_selectionKey(std::numeric_limits<unsigned int>::max()),
 m_allopatricTag(allopatricTagCounter.toString()),
 m_state(ALIVE),
 m_birthGen(0),
@@ -134,6 +156,21 @@ void CandidateSolution::step(bool age)
     }
 }
 
+void CandidateSolution::computeMemoryUsage(MemoryUsage& usage) const
+{
+    usage.add(MemoryUsage::CANDIDATES, MemoryUsage::ofString(m_id) + MemoryUsage::ofString(m_allopatricTag));
+    usage.addFitness(MemoryUsage::CANDIDATES, m_rawFitness);
+    usage.addFitness(MemoryUsage::CANDIDATES, getFitness());
+    usage.add(MemoryUsage::PHENOTYPES, MemoryUsage::ofString(m_normalizedPhenotype) + MemoryUsage::ofString(m_cacheKey));
+    
+    // Operator names are shared by all the lineages
+    usage.add(MemoryUsage::LINEAGE, MemoryUsage::ofVector(getLineage().getParentIds()));
+    
+    if (isZombie()) {
+        usage.countZombie();
+    }
+}
+
 const string CandidateSolution::toString() const
 {
     // add an asterisk if it is a hero
@@ -200,8 +237,8 @@ void CandidateSolution::outputLineage(ostream& lineageFile, unsigned int recursi
     indent << "id: " << getId() << "\n" <<
     indent << "operator: " << getLineage().getOperatorName() << "\n" <<
     indent << "parent_ids: [";
-    for (auto id: getLineage().getParentNames()) {
-        lineageFile << id << ", ";
+    for (auto id: getLineage().getParentIds()) {
+        lineageFile << numberToId(id) << ", ";
     }
     lineageFile << "]\n";
 }
@@ -46,12 +46,14 @@
 #include "ScaledFitness.h"
 
 #include <map>
+#include <cstdint>
 
 namespace ugp3 {
 namespace core {
     
 class Population;
 class Lineage;
+class MemoryUsage;
 
 class CandidateSolution :
     public xml::XMLIFace,
@@ -71,6 +73,10 @@ public:
 private:
     // Individual id
     std::string m_id;
+    // Numeric form of the id, used for sorting
+    std::uint64_t m_numericId;
+    // Position of the candidate in the selection keys of its population
+    mutable unsigned int m_selectionKey;
     /** Allopatric tag for this individual */
     std::string m_allopatricTag;
     
@@ -86,11 +92,19 @@ private:
 
     // Normalized phenotype of the individual. If empty, means it should be computed.
     mutable std::string m_normalizedPhenotype;
+    // Canonical form of the phenotype used as cache key, and mask of the
+    // canonicalization rules that changed it. If empty, means it should be computed.
+    mutable std::string m_cacheKey;
+    mutable std::uint64_t m_cacheKeyRules = 0;
     
     // Population where the individual exists
     const Population* m_population;
     // Fitness of the individual according to the evaluator
     Fitness m_rawFitness;
+    // Wall-clock time spent by the evaluator on this candidate, in seconds
+    double m_evaluationTime = 0;
+    // Racing stage at which the evaluation was abandoned, 0 if it was completed
+    unsigned int m_racedOutStage = 0;
     
     // Contribution of this individual to global entropy
     DeltaEntropy m_deltaEntropy;
@@ -124,7 +138,7 @@ protected:
     /**
      * Subclasses must call this function when the change their DNA.
      */
-    void invalidateNormalizedPhenotype() { m_normalizedPhenotype.clear(); }
+    void invalidateNormalizedPhenotype() { m_normalizedPhenotype.clear(); m_cacheKey.clear(); }
     
 public:
     virtual ~CandidateSolution();
@@ -135,6 +149,21 @@ public:
     
     const std::string& getId() const { return m_id; }
     
+    /**
+     * Number that orders candidates like their creation, derived from the id.
+     * Faster to compare than the id itself.
+     */
+    std::uint64_t getNumericId() const { return m_numericId; }
+    static std::uint64_t idToNumber(const std::string& id);
+    static std::string numberToId(std::uint64_t number);
+    
+    /**
+     * Index of the candidate in the SelectionKeys of its population.
+     * Only meaningful for the SelectionKeys that set it.
+     */
+    unsigned int getSelectionKey() const { return m_selectionKey; }
+    void setSelectionKey(unsigned int key) const { m_selectionKey = key; }
+    
     const std::string& getAllopatricTag() const { return m_allopatricTag; }
     void setAllopatricTag(const std::string& tag) { m_allopatricTag = tag; }
     
@@ -177,6 +206,23 @@ public:
     Fitness& getRawFitness() { return m_rawFitness; }
     const Fitness& getRawFitness() const { return m_rawFitness; }
     
+    /**
+     * Time spent by the evaluator to compute the raw fitness, in seconds.
+     * Zero when the fitness came from the cache. When several candidates are
+     * evaluated together, each one gets its share of the time.
+     */
+    double getEvaluationTime() const { return m_evaluationTime; }
+    void setEvaluationTime(double seconds) { m_evaluationTime = seconds; }
+    
+    /**
+     * Stage of a racing evaluation after which the candidate was dropped,
+     * or 0 if its evaluation was completed. The raw fitness of a dropped
+     * candidate is a pessimistic placeholder, not a measure.
+     */
+    unsigned int getRacedOutStage() const { return m_racedOutStage; }
+    void setRacedOutStage(unsigned int stage) { m_racedOutStage = stage; }
+    bool isRacedOut() const { return m_racedOutStage != 0; }
+    
     /**
      * This fitness value is used for comparisons, selections, tournaments,
      * slaughtering... it should be some kind of scaled fitness.
@@ -192,6 +238,11 @@ public:
 
     virtual const Message& getMessage() const = 0;
     
+    /**
+     * Sketch of the entropic message, for the approximate entropic distance.
+     */
+    virtual const MessageSketch& getSketch() const = 0;
+    
     virtual void setFitnessStructure(Fitness fitness);
     
     /** 
@@ -247,6 +298,17 @@ public:
         return getNormalizedPhenotype() == other.getNormalizedPhenotype();
     }
     
+    /**
+     * Canonical phenotype stored by the evaluator, empty until computed.
+     * @see Canonicalizer
+     */
+    const std::string& getCacheKey() const { return m_cacheKey; }
+    std::uint64_t getCacheKeyRules() const { return m_cacheKeyRules; }
+    void setCacheKey(const std::string& key, std::uint64_t rules) const {
+        m_cacheKey = key;
+        m_cacheKeyRules = rules;
+    }
+    
     /**
      * Compares the genotype of two candidates. This is used for clone detection.
      * This function should take noncoding DNA into account.
@@ -261,6 +323,12 @@ public:
      */
     virtual const std::string getDisplayTypeName() const = 0;
     
+    /**
+     * Add the memory retained by this candidate to the given accounting.
+     * Subclasses add the objects they own, then call this method.
+     */
+    virtual void computeMemoryUsage(MemoryUsage& usage) const;
+    
 public:
     virtual const std::string& getType() const = 0;
     virtual const std::string& getXmlName() const = 0;
@@ -294,7 +362,7 @@ public:
      */
     struct OrderById {
         bool operator()(CandidateSolution* a, CandidateSolution* b) {
-            return a->getId() < b->getId();
+            return a->getNumericId() < b->getNumericId();
         }
     };
 };
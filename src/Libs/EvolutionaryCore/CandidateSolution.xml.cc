@@ -44,6 +44,7 @@ void CandidateSolution::readXml(const xml::Element& element)
     _STACK;
     
     m_id = xml::Utility::attributeValueToString(element, XML_ATTRIBUTE_ID);
+    m_numericId = idToNumber(m_id);
     m_allopatricTag = xml::Utility::attributeValueToString(element, XML_ATTRIBUTE_ALLOPATRIC_TAG);
     m_deltaEntropy.setValue(xml::Utility::attributeValueToDouble(element, XML_ATTRIBUTE_DELTAENTROPY));
     
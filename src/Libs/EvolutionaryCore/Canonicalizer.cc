@@ -0,0 +1,241 @@
+/***********************************************************************\
+|                                                                       |
+| Canonicalizer.cc                                                      |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#include "ugp3_config.h"
+#include "EvolutionaryCore.h"
+#include "Canonicalizer.h"
+#include "Process.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace ugp3::core;
+
+namespace {
+
+// Numbers the temporary files of the calls of this process
+std::atomic<unsigned long> commandCallCount(0);
+
+}
+
+const string Canonicalizer::TYPE_NAMES[] = {
+    "truncateAfter",
+    "dropLines",
+    "sortRuns",
+    "replace",
+    "command"
+};
+
+const string& Canonicalizer::typeToString(RuleType type)
+{
+    return TYPE_NAMES[type];
+}
+
+Canonicalizer::RuleType Canonicalizer::stringToType(const string& name)
+{
+    for (unsigned int i = TRUNCATE_AFTER; i <= COMMAND; ++i) {
+        if (TYPE_NAMES[i] == name) {
+            return (RuleType) i;
+        }
+    }
+    throw ArgumentException("Unknown canonicalization rule '" + name + "'.", LOCATION);
+}
+
+void Canonicalizer::addRule(RuleType type, const string& pattern, const string& format)
+{
+    _STACK;
+    
+    if (m_rules.size() == MAX_RULES) {
+        throw ArgumentException("Too many canonicalization rules (at most " + Convert::toString(MAX_RULES) + ").", LOCATION);
+    }
+    if (pattern.empty()) {
+        throw ArgumentException("The canonicalization rule '" + typeToString(type) + "' needs a pattern.", LOCATION);
+    }
+    
+    Rule rule;
+    rule.type = type;
+    rule.pattern = pattern;
+    rule.format = format;
+    rule.changed = 0;
+    rule.hits = 0;
+    if (type != COMMAND) {
+        try {
+            rule.regex = regex(pattern, regex::ECMAScript | regex::optimize);
+        } catch (const regex_error& e) {
+            throw ArgumentException("Bad pattern '" + pattern + "' in canonicalization rule '"
+                + typeToString(type) + "': " + e.what(), LOCATION);
+        }
+    }
+    m_rules.push_back(rule);
+}
+
+vector<string> Canonicalizer::splitLines(const string& text)
+{
+    // A text ending with a newline gives an empty last line: joining restores it
+    vector<string> lines;
+    size_t begin = 0;
+    size_t end;
+    while ((end = text.find('\n', begin)) != string::npos) {
+        lines.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    lines.push_back(text.substr(begin));
+    return lines;
+}
+
+string Canonicalizer::joinLines(const vector<string>& lines)
+{
+    string text;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (i > 0) {
+            text += '\n';
+        }
+        text += lines[i];
+    }
+    return text;
+}
+
+string Canonicalizer::runCommand(const string& command, const string& text)
+{
+    /*
+     * Concurrent evaluations, and the farm workers sharing the working
+     * directory, may canonicalize at the same time: each call has its own files
+     */
+    const string prefix = "canonicalization." + Convert::toString(Process::getId())
+        + "." + Convert::toString(commandCallCount++);
+    const string inputFile = prefix + ".input";
+    const string outputFile = prefix + ".output";
+    
+    ofstream input(inputFile);
+    if (!input.is_open()) {
+        throw Exception("Could not create the file \"" + inputFile + "\".", LOCATION);
+    }
+    input << text;
+    input.close();
+    
+    bool timedOut = false;
+    int returnValue = Process::run(command + " " + inputFile + " " + outputFile, chrono::milliseconds(0), timedOut);
+    if (returnValue != 0) {
+        File::remove(inputFile);
+        File::remove(outputFile);
+        throw Exception("The canonicalization command \"" + command + "\" exited with code "
+            + Convert::toString(returnValue) + ".", LOCATION);
+    }
+    
+    ifstream output(outputFile);
+    if (!output.is_open()) {
+        File::remove(inputFile);
+        throw Exception("The canonicalization command \"" + command + "\" did not create the file \""
+            + outputFile + "\".", LOCATION);
+    }
+    ostringstream result;
+    result << output.rdbuf();
+    output.close();
+    
+    File::remove(inputFile);
+    File::remove(outputFile);
+    return result.str();
+}
+
+string Canonicalizer::applyRule(const Rule& rule, const string& text) const
+{
+    if (rule.type == COMMAND) {
+        return runCommand(rule.pattern, text);
+    }
+    
+    vector<string> lines = splitLines(text);
+    switch (rule.type) {
+    case TRUNCATE_AFTER: {
+        auto it = find_if(lines.begin(), lines.end(), [&] (const string& line) {
+            return regex_search(line, rule.regex);
+        });
+        if (it != lines.end() && it + 1 != lines.end()) {
+            // Keep the newline that ended the matching line
+            lines.erase(it + 1, lines.end());
+            lines.push_back(string());
+        }
+        break;
+    }
+    case DROP_LINES:
+        lines.erase(remove_if(lines.begin(), lines.end(), [&] (const string& line) {
+            return regex_search(line, rule.regex);
+        }), lines.end());
+        break;
+    case SORT_RUNS:
+        for (auto begin = lines.begin(); begin != lines.end(); ) {
+            auto end = find_if(begin, lines.end(), [&] (const string& line) {
+                return !regex_search(line, rule.regex);
+            });
+            sort(begin, end);
+            begin = end == lines.end() ? end : end + 1;
+        }
+        break;
+    case REPLACE:
+        for (string& line: lines) {
+            line = regex_replace(line, rule.regex, rule.format);
+        }
+        break;
+    default:
+        break;
+    }
+    return joinLines(lines);
+}
+
+string Canonicalizer::canonicalize(const string& text, uint64_t& rules)
+{
+    rules = 0;
+    string result = text;
+    for (size_t r = 0; r < m_rules.size(); ++r) {
+        string next = applyRule(m_rules[r], result);
+        if (next != result) {
+            rules |= uint64_t(1) << r;
+            ++m_rules[r].changed;
+            result.swap(next);
+        }
+    }
+    return result;
+}
+
+void Canonicalizer::countHit(uint64_t rules)
+{
+    for (size_t r = 0; r < m_rules.size(); ++r) {
+        if (rules & (uint64_t(1) << r)) {
+            ++m_rules[r].hits;
+        }
+    }
+}
+
+void Canonicalizer::showStatistics() const
+{
+    for (size_t r = 0; r < m_rules.size(); ++r) {
+        const Rule& rule = m_rules[r];
+        LOG_INFO << "Canonicalization rule " << r + 1 << " (" << typeToString(rule.type) << " \"" << rule.pattern << "\"): "
+        << rule.changed << " phenotypes changed, " << rule.hits << " cache hits" << ends;
+    }
+}
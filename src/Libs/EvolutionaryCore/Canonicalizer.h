@@ -0,0 +1,148 @@
+/***********************************************************************\
+|                                                                       |
+| Canonicalizer.h                                                       |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#ifndef HEADER_UGP3_CORE_CANONICALIZER
+#define HEADER_UGP3_CORE_CANONICALIZER
+
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "XMLIFace.h"
+
+namespace ugp3 {
+namespace core {
+
+/**
+ * Rewrites the normalized phenotype of a candidate into the key used by
+ * the evaluation cache, so that programs that differ only in ways that
+ * cannot change their fitness share the same key and are evaluated once.
+ * 
+ * The rules are applied in order to the text, line by line:
+ *  - truncateAfter: drop all the lines after the first line matching the
+ *    pattern (e.g. unreachable code after the epilogue);
+ *  - dropLines: drop the lines matching the pattern (e.g. comments, nops);
+ *  - sortRuns: sort each run of consecutive lines matching the pattern
+ *    (e.g. independent instructions that can be freely reordered);
+ *  - replace: replace the matches of the pattern with the format, as in
+ *    std::regex_replace (e.g. equivalent spellings of the same constant);
+ *  - command: user plugin, run as `command input output' on temporary
+ *    files; the output file replaces the text.
+ * Patterns are ECMAScript regular expressions.
+ * 
+ * Each rule counts the candidates whose text it changed, and the cache
+ * hits obtained by candidates whose text it changed.
+ */
+class Canonicalizer : public xml::XMLIFace
+{
+public:
+    typedef enum {
+        TRUNCATE_AFTER = 0,
+        DROP_LINES,
+        SORT_RUNS,
+        REPLACE,
+        COMMAND
+    } RuleType;
+    
+    /**
+     * The rules that changed a text are given as a bit mask.
+     */
+    static const std::size_t MAX_RULES = 64;
+    
+private:
+    struct Rule
+    {
+        RuleType type;
+        // Pattern, or command line for COMMAND
+        std::string pattern;
+        std::string format;
+        std::regex regex;
+        unsigned long changed;
+        unsigned long hits;
+    };
+    
+    std::vector<Rule> m_rules;
+    
+    static const std::string XML_ELEMENT_RULE;
+    static const std::string XML_ATTRIBUTE_TYPE;
+    static const std::string XML_ATTRIBUTE_PATTERN;
+    static const std::string XML_ATTRIBUTE_FORMAT;
+    static const std::string XML_ATTRIBUTE_COMMAND;
+    static const std::string TYPE_NAMES[];
+    
+    static std::vector<std::string> splitLines(const std::string& text);
+    static std::string joinLines(const std::vector<std::string>& lines);
+    static std::string runCommand(const std::string& command, const std::string& text);
+    std::string applyRule(const Rule& rule, const std::string& text) const;
+    
+public:
+    bool isEmpty() const { return m_rules.empty(); }
+    std::size_t getRuleCount() const { return m_rules.size(); }
+    
+    /**
+     * Append a rule.
+     * @param pattern Regular expression, or command line for COMMAND.
+     * @param format Replacement, for REPLACE only.
+     */
+    void addRule(RuleType type, const std::string& pattern, const std::string& format = std::string());
+    
+    /**
+     * Remove all the rules.
+     */
+    void clear() { m_rules.clear(); }
+    
+    /**
+     * Apply all the rules to the given text.
+     * @param rules Set to the mask of the rules that changed the text.
+     */
+    std::string canonicalize(const std::string& text, std::uint64_t& rules);
+    
+    /**
+     * Account for a cache hit that the rules in the mask made possible.
+     */
+    void countHit(std::uint64_t rules);
+    
+    /**
+     * Log the statistics of each rule.
+     */
+    void showStatistics() const;
+    
+    static const std::string& typeToString(RuleType type);
+    static RuleType stringToType(const std::string& name);
+    
+public: // Xml interface
+    virtual void writeXml(std::ostream& output) const;
+    virtual void readXml(const xml::Element& element);
+    virtual const std::string& getXmlName() const { return XML_NAME; }
+    
+    static const std::string XML_NAME;
+};
+
+}
+}
+
+#endif // HEADER_UGP3_CORE_CANONICALIZER
@@ -0,0 +1,86 @@
+/***********************************************************************\
+|                                                                       |
+| Canonicalizer.xml.cc                                                  |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#include "ugp3_config.h"
+#include "EvolutionaryCore.h"
+#include "Canonicalizer.h"
+
+using namespace std;
+using namespace ugp3::core;
+
+const string Canonicalizer::XML_NAME = "canonicalization";
+const string Canonicalizer::XML_ELEMENT_RULE = "rule";
+const string Canonicalizer::XML_ATTRIBUTE_TYPE = "type";
+const string Canonicalizer::XML_ATTRIBUTE_PATTERN = "pattern";
+const string Canonicalizer::XML_ATTRIBUTE_FORMAT = "format";
+const string Canonicalizer::XML_ATTRIBUTE_COMMAND = "command";
+
+void Canonicalizer::readXml(const xml::Element& element)
+{
+    _STACK;
+    
+    if (element.ValueStr() != XML_NAME) {
+        throw xml::SchemaException("expected element '" + XML_NAME + "' (found '" + element.ValueStr() + "').", LOCATION);
+    }
+    
+    clear();
+    const xml::Element* childElement = element.FirstChildElement();
+    while (childElement) {
+        if (childElement->ValueStr() != XML_ELEMENT_RULE) {
+            throw xml::SchemaException("unexpected element '" + childElement->ValueStr() + "' in '" + XML_NAME + "'.", LOCATION);
+        }
+        
+        RuleType type = stringToType(xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_TYPE));
+        if (type == COMMAND) {
+            addRule(type, xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_COMMAND));
+        } else if (type == REPLACE) {
+            addRule(type, xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_PATTERN),
+                xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_FORMAT));
+        } else {
+            addRule(type, xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_PATTERN));
+        }
+        
+        childElement = childElement->NextSiblingElement();
+    }
+}
+
+void Canonicalizer::writeXml(ostream& output) const
+{
+    output << " <" << XML_NAME << ">" << endl;
+    for (const Rule& rule: m_rules) {
+        output << "  <" << XML_ELEMENT_RULE << " " << XML_ATTRIBUTE_TYPE << "=\"" << typeToString(rule.type) << "\"";
+        if (rule.type == COMMAND) {
+            output << " " << XML_ATTRIBUTE_COMMAND << "=\"" << xml::Utility::transformXmlEscChar(rule.pattern) << "\"";
+        } else {
+            output << " " << XML_ATTRIBUTE_PATTERN << "=\"" << xml::Utility::transformXmlEscChar(rule.pattern) << "\"";
+        }
+        if (rule.type == REPLACE) {
+            output << " " << XML_ATTRIBUTE_FORMAT << "=\"" << xml::Utility::transformXmlEscChar(rule.format) << "\"";
+        }
+        output << " />" << endl;
+    }
+    output << " </" << XML_NAME << ">" << endl;
+}
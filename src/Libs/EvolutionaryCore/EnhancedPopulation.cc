@@ -99,16 +99,14 @@ void EnhancedPopulation::handleClone(CandidateSolution& master, CandidateSolutio
     if (number == 0) {
         // For the master, the fitness is exactly the raw fitness
         master.getFitness().setScalingFactor(ScaledFitness::CLONE_SCALING, 1);
-        master.getFitness().setAdditionalDescription(ScaledFitness::CLONE_SCALING,
-            (total > 1 ? " [master of " + ugp3::Convert::toString(total) + " clones]" : ""));
+        master.getFitness().setCloneMasterDescription(total);
     } else {
         // !! if you want to change this formula you must change also the inverted formula in natural selection
         double scalingFactor = pow(getParameters().getCloneScalingFactor(), number);
         // TODO check that the formula is still the same in natural selection
         clone.getFitness().setScalingFactor(ScaledFitness::CLONE_SCALING, scalingFactor);
         clone.getFitness().setCloneCount(total); // FIXME why? Who uses it?
-        clone.getFitness().setAdditionalDescription(ScaledFitness::CLONE_SCALING,
-            " [clone #" + ugp3::Convert::toString(total) + " of " + master.toString() + "]");
+        clone.getFitness().setCloneDescription(total, master.toString());
     }
 }
 
@@ -125,5 +123,7 @@ EnhancedPopulation::~EnhancedPopulation()
     _STACK;
     
     LOG_DEBUG << "Destructor: ugp3::core::EnhancedPopulation" << ends;
+    
+    discardInFlightCandidates();
 }
 
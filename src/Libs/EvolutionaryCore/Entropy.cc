@@ -26,6 +26,7 @@
 
 #include "ugp3_config.h"
 #include "EvolutionaryCore.h"
+#include "RandomStream.h"
 
 using namespace ugp3;
 using namespace std;
@@ -155,6 +156,72 @@ const Message& MessageHolder::getMessage() const
     return m_message;
 }
 
+const MessageSketch& MessageHolder::getSketch() const
+{
+    if (!m_isSketchValid || !m_isMessageValid) {
+        m_sketch.compute(getMessage());
+        m_isSketchValid = true;
+    }
+    
+    return m_sketch;
+}
+
+size_t MessageSketch::s_size = 128;
+bool MessageSketch::s_checkEnabled = false;
+
+void MessageSketch::setSize(size_t value)
+{
+    if (value == 0) {
+        throw ArgumentException("The size of the message sketches cannot be zero.", LOCATION);
+    }
+    
+    s_size = value;
+}
+
+void MessageSketch::compute(const Message& message)
+{
+    m_capacity = s_size;
+    m_symbolCount = message.m_symbols.size();
+    
+    // The symbols are djb hashes, mix them so that the minimums are a uniform sample
+    m_minimums.clear();
+    m_minimums.reserve(m_symbolCount);
+    for (auto it = message.m_symbols.begin(); it != message.m_symbols.end(); ++it) {
+        m_minimums.push_back(RandomStream::mix(it->first, 0));
+    }
+    if (m_minimums.size() > m_capacity) {
+        std::nth_element(m_minimums.begin(), m_minimums.begin() + m_capacity, m_minimums.end());
+        m_minimums.resize(m_capacity);
+    }
+    std::sort(m_minimums.begin(), m_minimums.end());
+    m_minimums.shrink_to_fit();
+}
+
+double MessageSketch::estimateJaccard(const MessageSketch& other) const
+{
+    // The k smallest symbols of the union are the k smallest of the two sketches,
+    // and for each of them we know whether it belongs to both sets
+    const size_t k = min(m_capacity, other.m_capacity);
+    size_t i = 0, j = 0, unionCount = 0, shared = 0;
+    while (unionCount < k && (i < m_minimums.size() || j < other.m_minimums.size())) {
+        if (j == other.m_minimums.size() || (i < m_minimums.size() && m_minimums[i] < other.m_minimums[j])) {
+            ++i;
+        } else if (i == m_minimums.size() || other.m_minimums[j] < m_minimums[i]) {
+            ++j;
+        } else {
+            ++shared;
+            ++i;
+            ++j;
+        }
+        ++unionCount;
+    }
+    
+    if (unionCount == 0) {
+        return 1;
+    }
+    return shared / (double) unionCount;
+}
+
 
 #if 0
 void Message::operator+=(const ctgraph::CGraphContainer &container)
@@ -28,6 +28,7 @@
 #define HEADER_UGP3_ENTROPY
 
 #include <unordered_map>
+#include <vector>
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -42,9 +43,14 @@
 
 namespace ugp3
 {
+
+class MessageSketch;
     
 class Message
 {
+    friend class MessageSketch;
+    
+
 public:
     /**
      * Extract from a sequence of entropic hash values the following symbols:
@@ -90,6 +96,15 @@ public:
      * FIXME: Number of different symbols, or total number of symbols?
      */
     size_t getSize() const { return m_symbols.size(); }
+    
+    /**
+     * Approximate number of bytes allocated for the set of symbols
+     * (buckets and nodes of the hash table).
+     */
+    size_t getMemoryUsage() const {
+        return m_symbols.bucket_count() * sizeof(void*)
+            + m_symbols.size() * (sizeof(std::pair<const hash_t, unsigned int>) + sizeof(void*));
+    }
 	
     /**
      * Return the map of symbols
@@ -107,11 +122,61 @@ private:
     std::unordered_map<hash_t, unsigned int> m_symbols;
 };
 
+/**
+ * Bottom-k MinHash sketch of the set of symbols of a message: the k smallest
+ * values of a mix of its distinct symbols, along with the exact number of
+ * distinct symbols.
+ * 
+ * Two sketches give an estimate of the Jaccard similarity of the two sets of
+ * symbols, hence of their entropic distance, in O(k) instead of copying and
+ * merging both messages. The estimate is exact when the union of the two sets
+ * has no more than k symbols.
+ */
+class MessageSketch
+{
+private:
+    // Number of minimums kept by the sketches computed from now on
+    static std::size_t s_size;
+    // Compare approximate and exact distances in the statistics
+    static bool s_checkEnabled;
+    
+    // Smallest mixed symbols, in increasing order
+    std::vector<hash_t> m_minimums;
+    // Number of minimums the sketch was computed with
+    std::size_t m_capacity = 0;
+    // Number of distinct symbols of the message
+    std::size_t m_symbolCount = 0;
+    
+public:
+    static std::size_t getSize() { return s_size; }
+    static void setSize(std::size_t value);
+    
+    static bool getCheckEnabled() { return s_checkEnabled; }
+    static void setCheckEnabled(bool value) { s_checkEnabled = value; }
+    
+    /**
+     * Replace the sketch with the one of the given message.
+     */
+    void compute(const Message& message);
+    
+    std::size_t getSymbolCount() const { return m_symbolCount; }
+    
+    /**
+     * Estimate of |A & B| / |A | B|, where A and B are the sets of symbols
+     * of the two messages. Two empty messages are identical.
+     */
+    double estimateJaccard(const MessageSketch& other) const;
+    
+    size_t getMemoryUsage() const { return m_minimums.capacity() * sizeof(hash_t); }
+};
+
 class MessageHolder
 {
 private:
     mutable bool m_isMessageValid = false;
     mutable Message m_message;
+    mutable bool m_isSketchValid = false;
+    mutable MessageSketch m_sketch;
     
 public:
     
@@ -123,7 +188,18 @@ public:
     
     const Message& getMessage() const;
     
-    void invalidateMessage() const { m_isMessageValid = false; }
+    /**
+     * Sketch of the message, computed along with it the first time it is needed.
+     */
+    const MessageSketch& getSketch() const;
+    
+    void invalidateMessage() const { m_isMessageValid = false; m_isSketchValid = false; }
+    
+    /**
+     * Bytes retained by the cached message and sketch, valid or not.
+     * Does not compute them.
+     */
+    size_t getMessageMemoryUsage() const { return m_message.getMemoryUsage() + m_sketch.getMemoryUsage(); }
 };
 
 }
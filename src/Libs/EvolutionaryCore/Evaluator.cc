@@ -48,6 +48,23 @@ void Evaluator::clear()
     m_outputFile = "fitness.output";
     m_removeTemporaryFiles = false;
     m_concurrentEvaluations = 1;
+    m_batchEvaluations = 1;
+    m_evaluationTimeout = chrono::milliseconds(0);
+    m_timeoutRetries = 0;
+    m_timeoutPenalty = 0;
+    m_speculativeRedispatch = false;
+    m_evaluationStages = 1;
+    m_canonicalizer.clear();
+    m_farmPort = 0;
+    m_farmBind = "127.0.0.1";
+    m_farmToken.clear();
+    m_farmLocalWorkers = 0;
+    m_farmWorker = "ugp3-worker";
+    m_farmHeartbeat = chrono::milliseconds(1000);
+    m_farmWaitTimeout = chrono::milliseconds(60000);
+    m_type.clear();
+    m_syntheticCost = chrono::microseconds(0);
+    m_syntheticSeed = 0;
     m_totalMilliSeconds = chrono::milliseconds(0);
     m_externalStopRequest = false;
     m_cacheSize = 10000; // FIXME Completely arbitrary
@@ -76,6 +93,11 @@ void Evaluator::flush(std::function<void(double)> showProgress)
     m_totalMilliSeconds += duration_cast<milliseconds>(stop - m_startNewEvaluations);
 }
 
+void Evaluator::flushSome()
+{
+    flush([] (double) {});
+}
+
 /* (!)20090825
 void Evaluator::setEnvironmentVariable(const string& name, const string& value)
 {
@@ -115,6 +137,17 @@ void Evaluator::setScriptFile(const string& fileName)
     m_scriptFile = fileName;
 }
 
+void Evaluator::setType(const string& type)
+{
+    _STACK;
+    
+    if (type.empty() == false && type != TYPE_SYNTHETIC) {
+        throw ArgumentException("Unknown evaluator type '" + type + "'.", LOCATION);
+    }
+    
+    m_type = type;
+}
+
 void Evaluator::setInputFile(const string& fileName)
 {
     _STACK;
@@ -35,6 +35,7 @@
 #include <functional>
 
 #include "XMLIFace.h"
+#include "Canonicalizer.h"
 
 // forward declaration
 namespace Ui
@@ -64,6 +65,28 @@ private:
     bool m_removeTemporaryFiles;
     std::size_t m_cacheSize;
     unsigned int m_concurrentEvaluations;
+    unsigned int m_batchEvaluations;
+    // Time limit and failure handling
+    std::chrono::milliseconds m_evaluationTimeout;
+    unsigned int m_timeoutRetries;
+    double m_timeoutPenalty;
+    bool m_speculativeRedispatch;
+    // Racing evaluation
+    unsigned int m_evaluationStages;
+    // Canonicalization of the phenotypes used as cache keys
+    Canonicalizer m_canonicalizer;
+    // Evaluation farm: remote workers connected over TCP
+    unsigned int m_farmPort;
+    std::string m_farmBind;
+    std::string m_farmToken;
+    unsigned int m_farmLocalWorkers;
+    std::string m_farmWorker;
+    std::chrono::milliseconds m_farmHeartbeat;
+    std::chrono::milliseconds m_farmWaitTimeout;
+    // In-process synthetic evaluation
+    std::string m_type;
+    std::chrono::microseconds m_syntheticCost;
+    unsigned long m_syntheticSeed;
     // External stop request
 #ifdef UGP3_USE_LUA
     std::atomic<bool> m_externalStopRequest;
@@ -82,6 +105,22 @@ private:
     static const std::string XML_CHILDELEMENT_TOTALMILLISECONDS;
     static const std::string XML_CHILDELEMENT_CONCURRENTEVALUATIONS;
     static const std::string XML_CHILDELEMENT_CACHESIZE;
+    static const std::string XML_CHILDELEMENT_BATCHEVALUATIONS;
+    static const std::string XML_CHILDELEMENT_EVALUATIONTIMEOUT;
+    static const std::string XML_CHILDELEMENT_TIMEOUTRETRIES;
+    static const std::string XML_CHILDELEMENT_TIMEOUTPENALTY;
+    static const std::string XML_CHILDELEMENT_SPECULATIVEREDISPATCH;
+    static const std::string XML_CHILDELEMENT_EVALUATIONSTAGES;
+    static const std::string XML_CHILDELEMENT_FARM;
+    static const std::string XML_ATTRIBUTE_PORT;
+    static const std::string XML_ATTRIBUTE_BIND;
+    static const std::string XML_ATTRIBUTE_TOKEN;
+    static const std::string XML_ATTRIBUTE_LOCALWORKERS;
+    static const std::string XML_ATTRIBUTE_WORKER;
+    static const std::string XML_ATTRIBUTE_HEARTBEAT;
+    static const std::string XML_ATTRIBUTE_WAITTIMEOUT;
+    static const std::string XML_CHILDELEMENT_SYNTHETICCOST;
+    static const std::string XML_CHILDELEMENT_SYNTHETICSEED;
 
 public:
     Evaluator();
@@ -130,6 +169,133 @@ public:
     unsigned int getConcurrentEvaluations() const { return m_concurrentEvaluations; }
     void setConcurrentEvaluations(unsigned int value) { m_concurrentEvaluations = value; }
     
+    /**
+     * Maximum number of candidates that a Lua worker takes from the queue
+     * at once. When greater than one and the script defines an
+     * `evaluate_batch' function, the whole batch is evaluated in a single call.
+     */
+    unsigned int getBatchEvaluations() const { return m_batchEvaluations; }
+    void setBatchEvaluations(unsigned int value) { m_batchEvaluations = value; }
+    
+    /**
+     * Wall-clock time limit for the evaluation of one candidate.
+     * Set to zero to disable. When a batch of candidates is evaluated by a
+     * single call, the limit is multiplied by the size of the batch.
+     */
+    std::chrono::milliseconds getEvaluationTimeout() const { return m_evaluationTimeout; }
+    void setEvaluationTimeout(std::chrono::milliseconds value) { m_evaluationTimeout = value; }
+    
+    /**
+     * Number of times the evaluation of a candidate that timed out is
+     * attempted again before giving it the penalty fitness.
+     */
+    unsigned int getTimeoutRetries() const { return m_timeoutRetries; }
+    void setTimeoutRetries(unsigned int value) { m_timeoutRetries = value; }
+    
+    /**
+     * Value given to all the fitness components of a candidate whose
+     * evaluation timed out too many times.
+     */
+    double getTimeoutPenalty() const { return m_timeoutPenalty; }
+    void setTimeoutPenalty(double value) { m_timeoutPenalty = value; }
+    
+    /**
+     * When true, idle Lua workers duplicate the slowest evaluations still
+     * running at the end of a generation; the first result wins.
+     */
+    bool getSpeculativeRedispatch() const { return m_speculativeRedispatch; }
+    void setSpeculativeRedispatch(bool value) { m_speculativeRedispatch = value; }
+    
+    /**
+     * Racing evaluation: number of stages in which the evaluator splits the
+     * evaluation of each candidate (1 = no racing). After each stage but the
+     * last, the evaluator reports the best fitness that each candidate can
+     * still reach; the candidates that cannot survive with that fitness are
+     * not evaluated further and keep it as their final fitness.
+     */
+    unsigned int getEvaluationStages() const { return m_evaluationStages; }
+    void setEvaluationStages(unsigned int value) { m_evaluationStages = value; }
+    
+    /**
+     * Rules that rewrite the normalized phenotypes into the keys of the
+     * evaluation cache. Without rules, the key is the normalized phenotype.
+     */
+    const Canonicalizer& getCanonicalizer() const { return m_canonicalizer; }
+    Canonicalizer& getCanonicalizer() { return m_canonicalizer; }
+    
+    /**
+     * Evaluation farm: when the port is not zero, the evaluator listens on it
+     * and sends the candidates to the ugp3-worker processes that connect,
+     * each one running the evaluator script on up to concurrentEvaluations
+     * candidates at a time.
+     */
+    unsigned int getFarmPort() const { return m_farmPort; }
+    void setFarmPort(unsigned int value) { m_farmPort = value; }
+    bool isFarm() const { return m_farmPort != 0; }
+    
+    /**
+     * Address of the interface where the farm listens: the loopback one by
+     * default, "0.0.0.0" for all the interfaces.
+     */
+    const std::string& getFarmBind() const { return m_farmBind; }
+    void setFarmBind(const std::string& value) { m_farmBind = value; }
+    
+    /**
+     * Secret that the workers must present to join the farm, empty if
+     * anybody who reaches the port is accepted. The local workers receive
+     * it in the environment variable UGP3_FARM_TOKEN.
+     */
+    const std::string& getFarmToken() const { return m_farmToken; }
+    void setFarmToken(const std::string& value) { m_farmToken = value; }
+    
+    /**
+     * Number of workers started on this host when the farm opens, each
+     * one in its own directory, using the given worker command.
+     */
+    unsigned int getFarmLocalWorkers() const { return m_farmLocalWorkers; }
+    void setFarmLocalWorkers(unsigned int value) { m_farmLocalWorkers = value; }
+    const std::string& getFarmWorker() const { return m_farmWorker; }
+    void setFarmWorker(const std::string& value) { m_farmWorker = value; }
+    
+    /**
+     * Interval between the heartbeats of the workers. A worker silent for
+     * three intervals is considered lost, and its candidates are sent to
+     * another worker.
+     */
+    std::chrono::milliseconds getFarmHeartbeat() const { return m_farmHeartbeat; }
+    void setFarmHeartbeat(std::chrono::milliseconds value) { m_farmHeartbeat = value; }
+    
+    /**
+     * Time the farm waits for a worker while candidates are waiting for
+     * evaluation and no worker is connected; then the run fails. Zero to
+     * wait forever.
+     */
+    std::chrono::milliseconds getFarmWaitTimeout() const { return m_farmWaitTimeout; }
+    void setFarmWaitTimeout(std::chrono::milliseconds value) { m_farmWaitTimeout = value; }
+    
+    /**
+     * Kind of evaluator: empty for an external script (or a Lua script,
+     * depending on its extension), TYPE_SYNTHETIC for the built-in
+     * evaluator that measures the overhead of the engine itself.
+     */
+    const std::string& getType() const { return m_type; }
+    virtual void setType(const std::string& type);
+    bool isSynthetic() const { return m_type == TYPE_SYNTHETIC; }
+    
+    /**
+     * Time that the synthetic evaluator spends on each candidate,
+     * simulating the cost of a real evaluation.
+     */
+    std::chrono::microseconds getSyntheticCost() const { return m_syntheticCost; }
+    void setSyntheticCost(std::chrono::microseconds value) { m_syntheticCost = value; }
+    
+    /**
+     * Seed mixed with the hash of the phenotype by the synthetic evaluator:
+     * the same candidate always gets the same fitness for a given seed.
+     */
+    unsigned long getSyntheticSeed() const { return m_syntheticSeed; }
+    void setSyntheticSeed(unsigned long value) { m_syntheticSeed = value; }
+    
     bool getExternalStopRequest() { return m_externalStopRequest; }
     void setExternalStopRequest(bool value) { m_externalStopRequest = value; }
     
@@ -147,7 +313,40 @@ public:
      * Perform all requested evaluations and return.
      */
     virtual void flush(std::function<void(double)> showProgress);
+
+    /**
+     * Wait until at least one of the requested evaluations is complete,
+     * or until no evaluation is left. Used by asynchronous populations,
+     * which keep breeding while the other evaluations go on.
+     */
+    virtual void flushSome();
+    
+    /**
+     * Drop all the requested evaluations that are not complete yet.
+     * Their objects will not be updated and can be deleted.
+     */
+    virtual void cancel() = 0;
+
+    /**
+     * @return True if the fitness of the given object has been computed.
+     * Safe to call while evaluations are running.
+     */
+    virtual bool isEvaluated(const CandidateSolution& object) const = 0;
+    
+    /**
+     * Runs the action while no evaluation can update the fitness of the
+     * objects, e.g. to save the objects still under evaluation.
+     * The action must not call the evaluator.
+     */
+    virtual void whileResultsFrozen(const std::function<void()>& action) const = 0;
     
+    /**
+     * @return True if the fitness of a clone of the given object is in the
+     * cache, or is being computed: evaluating it would cost nothing.
+     * Not const, since it may canonicalize the phenotype of the object.
+     */
+    virtual bool isCached(const CandidateSolution& object) = 0;
+
     /**
      * Must be called at the end of each generation. Performs cache management.
      * @param generation Number of the generation that is about to begin.
@@ -169,6 +368,11 @@ public:
      */
     virtual void dumpStatisticsHeader(const std::string& name, std::ostream& output) const = 0;
     virtual void dumpStatistics(std::ostream& output) const = 0;
+    
+    /**
+     * Approximate number of bytes retained by the evaluation cache.
+     */
+    virtual std::size_t getCacheMemoryUsage() const = 0;
         
 public:
     /**
@@ -185,6 +389,7 @@ public: // Xml interface
 	
     static const std::string XML_NAME;
     static const std::string XML_ATTRIBUTE_TYPE;
+    static const std::string TYPE_SYNTHETIC;
     
     void parseEnvironmentVariables(const xml::Element& element);
 
@@ -37,6 +37,24 @@ const string Evaluator::XML_CHILDELEMENT_EVALUATORPATHNAME = "evaluatorPathName"
 const string Evaluator::XML_CHILDELEMENT_REMOVETEMPFILES = "removeTempFiles";
 const string Evaluator::XML_CHILDELEMENT_TOTALMILLISECONDS = "totalMilliseconds";
 const string Evaluator::XML_CHILDELEMENT_CACHESIZE = "cacheSize";
+const string Evaluator::XML_CHILDELEMENT_BATCHEVALUATIONS = "batchEvaluations";
+const string Evaluator::XML_CHILDELEMENT_EVALUATIONTIMEOUT = "evaluationTimeout";
+const string Evaluator::XML_CHILDELEMENT_TIMEOUTRETRIES = "timeoutRetries";
+const string Evaluator::XML_CHILDELEMENT_TIMEOUTPENALTY = "timeoutPenalty";
+const string Evaluator::XML_CHILDELEMENT_SPECULATIVEREDISPATCH = "speculativeRedispatch";
+const string Evaluator::XML_CHILDELEMENT_EVALUATIONSTAGES = "evaluationStages";
+const string Evaluator::XML_CHILDELEMENT_FARM = "farm";
+const string Evaluator::XML_ATTRIBUTE_PORT = "port";
+const string Evaluator::XML_ATTRIBUTE_BIND = "bind";
+const string Evaluator::XML_ATTRIBUTE_TOKEN = "token";
+const string Evaluator::XML_ATTRIBUTE_LOCALWORKERS = "localWorkers";
+const string Evaluator::XML_ATTRIBUTE_WORKER = "worker";
+const string Evaluator::XML_ATTRIBUTE_HEARTBEAT = "heartbeat";
+const string Evaluator::XML_ATTRIBUTE_WAITTIMEOUT = "waitTimeout";
+const string Evaluator::XML_CHILDELEMENT_SYNTHETICCOST = "syntheticCost";
+const string Evaluator::XML_CHILDELEMENT_SYNTHETICSEED = "syntheticSeed";
+const string Evaluator::XML_ATTRIBUTE_TYPE = "type";
+const string Evaluator::TYPE_SYNTHETIC = "synthetic";
 
 
 void Evaluator::readXml(const xml::Element& element)
@@ -53,6 +71,16 @@ void Evaluator::readXml(const xml::Element& element)
 		throw xml::SchemaException("expected element '/evolutionaryAlgorithm/evaluation'", LOCATION);
 	}
 
+	if (xml::Utility::hasAttribute(element, XML_ATTRIBUTE_TYPE))
+	{
+		const string& type = xml::Utility::attributeValueToString(element, XML_ATTRIBUTE_TYPE);
+		if (type != TYPE_SYNTHETIC)
+		{
+			throw xml::SchemaException("unknown type \"" + type + "\" for '/evolutionaryAlgorithm/evaluation'", LOCATION);
+		}
+		m_type = type;
+	}
+
 	bool filesFound = false;
 	bool scriptFileFound = false;
 	bool inputFileFound = false;
@@ -67,6 +95,87 @@ void Evaluator::readXml(const xml::Element& element)
         {
             m_concurrentEvaluations = xml::Utility::attributeValueToUInt(*childElement, "value");
         }
+        else if(elementName == XML_CHILDELEMENT_BATCHEVALUATIONS /*"batchEvaluations"*/)
+        {
+            m_batchEvaluations = xml::Utility::attributeValueToUInt(*childElement, "value");
+            if (m_batchEvaluations == 0) {
+                throw xml::SchemaException("the value of '/evolutionaryAlgorithm/evaluation/batchEvaluations' must be at least 1", LOCATION);
+            }
+        }
+        else if(elementName == XML_CHILDELEMENT_EVALUATIONTIMEOUT /*"evaluationTimeout"*/)
+        {
+            // expressed in seconds
+            double seconds = xml::Utility::attributeValueToDouble(*childElement, "value");
+            if (seconds < 0) {
+                throw xml::SchemaException("the value of '/evolutionaryAlgorithm/evaluation/evaluationTimeout' cannot be negative", LOCATION);
+            }
+            m_evaluationTimeout = std::chrono::milliseconds((long long)(seconds * 1000));
+        }
+        else if(elementName == XML_CHILDELEMENT_TIMEOUTRETRIES /*"timeoutRetries"*/)
+        {
+            m_timeoutRetries = xml::Utility::attributeValueToUInt(*childElement, "value");
+        }
+        else if(elementName == XML_CHILDELEMENT_TIMEOUTPENALTY /*"timeoutPenalty"*/)
+        {
+            m_timeoutPenalty = xml::Utility::attributeValueToDouble(*childElement, "value");
+            if (m_timeoutPenalty < 0) {
+                throw xml::SchemaException("the value of '/evolutionaryAlgorithm/evaluation/timeoutPenalty' cannot be negative", LOCATION);
+            }
+        }
+        else if(elementName == XML_CHILDELEMENT_SPECULATIVEREDISPATCH /*"speculativeRedispatch"*/)
+        {
+            m_speculativeRedispatch = xml::Utility::attributeValueToBool(*childElement, "value");
+        }
+        else if(elementName == XML_CHILDELEMENT_EVALUATIONSTAGES /*"evaluationStages"*/)
+        {
+            m_evaluationStages = xml::Utility::attributeValueToUInt(*childElement, "value");
+            if (m_evaluationStages == 0) {
+                throw xml::SchemaException("the value of '/evolutionaryAlgorithm/evaluation/evaluationStages' must be at least 1", LOCATION);
+            }
+        }
+        else if(elementName == XML_CHILDELEMENT_FARM /*"farm"*/)
+        {
+            m_farmPort = xml::Utility::attributeValueToUInt(*childElement, XML_ATTRIBUTE_PORT);
+            if (m_farmPort == 0 || m_farmPort > 65535) {
+                throw xml::SchemaException("the attribute '/evolutionaryAlgorithm/evaluation/farm/port' must be a valid TCP port", LOCATION);
+            }
+            if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_BIND)) {
+                m_farmBind = xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_BIND);
+            }
+            if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_TOKEN)) {
+                m_farmToken = xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_TOKEN);
+            }
+            if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_LOCALWORKERS)) {
+                m_farmLocalWorkers = xml::Utility::attributeValueToUInt(*childElement, XML_ATTRIBUTE_LOCALWORKERS);
+            }
+            if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_WORKER)) {
+                m_farmWorker = xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_WORKER);
+            }
+            if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_HEARTBEAT)) {
+                // expressed in milliseconds
+                m_farmHeartbeat = std::chrono::milliseconds(xml::Utility::attributeValueToUInt(*childElement, XML_ATTRIBUTE_HEARTBEAT));
+                if (m_farmHeartbeat.count() == 0) {
+                    throw xml::SchemaException("the attribute '/evolutionaryAlgorithm/evaluation/farm/heartbeat' must be at least 1", LOCATION);
+                }
+            }
+            if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_WAITTIMEOUT)) {
+                // expressed in milliseconds
+                m_farmWaitTimeout = std::chrono::milliseconds(xml::Utility::attributeValueToUInt(*childElement, XML_ATTRIBUTE_WAITTIMEOUT));
+            }
+        }
+        else if(elementName == XML_CHILDELEMENT_SYNTHETICCOST /*"syntheticCost"*/)
+        {
+            // expressed in microseconds
+            double microseconds = xml::Utility::attributeValueToDouble(*childElement, "value");
+            if (microseconds < 0) {
+                throw xml::SchemaException("the value of '/evolutionaryAlgorithm/evaluation/syntheticCost' cannot be negative", LOCATION);
+            }
+            m_syntheticCost = std::chrono::microseconds((long long)microseconds);
+        }
+        else if(elementName == XML_CHILDELEMENT_SYNTHETICSEED /*"syntheticSeed"*/)
+        {
+            m_syntheticSeed = xml::Utility::attributeValueToUInt(*childElement, "value");
+        }
         else if(elementName == XML_CHILDELEMENT_REMOVETEMPFILES /*"removeTempFiles"*/)
         {
             m_removeTemporaryFiles = xml::Utility::attributeValueToBool(*childElement, "value");
@@ -115,6 +224,10 @@ void Evaluator::readXml(const xml::Element& element)
 
 			this->parseEnvironmentVariables(*childElement);
 		}
+		else if (elementName == Canonicalizer::XML_NAME)
+		{
+			m_canonicalizer.readXml(*childElement);
+		}
 		else if (elementName == XML_CHILDELEMENT_CACHESIZE)
         {
              m_cacheSize = xml::Utility::attributeValueToUInt(*childElement, "value");
@@ -123,7 +236,8 @@ void Evaluator::readXml(const xml::Element& element)
 		childElement = childElement->NextSiblingElement();
 	}
 
-	if (!(filesFound || (scriptFileFound && outputFileFound && inputFileFound))) {
+	// the synthetic evaluator does not run any script
+	if (!isSynthetic() && !(filesFound || (scriptFileFound && outputFileFound && inputFileFound))) {
 		throw xml::MissingElementSchemaException("/evolutionaryAlgorithm/evaluation/script", LOCATION);
 	}
 }
@@ -169,11 +283,70 @@ void Evaluator::writeXml(ostream& output) const
 
     LOG_DEBUG << "Serializing object ugp3::core::Evaluator" << ends;
 
-	output
-	<< "<" << this->getXmlName() << ">" << endl
+	output << "<" << this->getXmlName();
+	if (m_type.empty() == false)
+	{
+		output << " " << XML_ATTRIBUTE_TYPE << "=\"" << m_type << "\"";
+	}
+	output << ">" << endl
         << " <" << XML_CHILDELEMENT_CONCURRENTEVALUATIONS << " value=\"" << m_concurrentEvaluations << "\" />" << endl
         << " <" << XML_CHILDELEMENT_CACHESIZE << " value=\"" << getCacheSize() << "\" />" << endl;
 
+        if (m_batchEvaluations != 1)
+        {
+        output
+        << " <" << XML_CHILDELEMENT_BATCHEVALUATIONS << " value=\"" << m_batchEvaluations << "\" />" << endl;
+        }
+
+        if (m_evaluationTimeout.count() != 0)
+        {
+        output
+        << " <" << XML_CHILDELEMENT_EVALUATIONTIMEOUT << " value=\"" << m_evaluationTimeout.count() / 1000.0 << "\" />" << endl
+        << " <" << XML_CHILDELEMENT_TIMEOUTRETRIES << " value=\"" << m_timeoutRetries << "\" />" << endl
+        << " <" << XML_CHILDELEMENT_TIMEOUTPENALTY << " value=\"" << m_timeoutPenalty << "\" />" << endl;
+        }
+
+        if (m_speculativeRedispatch)
+        {
+        output
+        << " <" << XML_CHILDELEMENT_SPECULATIVEREDISPATCH << " value=\"true\" />" << endl;
+        }
+
+        if (m_evaluationStages != 1)
+        {
+        output
+        << " <" << XML_CHILDELEMENT_EVALUATIONSTAGES << " value=\"" << m_evaluationStages << "\" />" << endl;
+        }
+
+        if (isFarm())
+        {
+        output
+        << " <" << XML_CHILDELEMENT_FARM 
+        << " " << XML_ATTRIBUTE_PORT << "=\"" << m_farmPort << "\""
+        << " " << XML_ATTRIBUTE_BIND << "=\"" << xml::Utility::transformXmlEscChar(m_farmBind) << "\"";
+        if (!m_farmToken.empty())
+        {
+        output << " " << XML_ATTRIBUTE_TOKEN << "=\"" << xml::Utility::transformXmlEscChar(m_farmToken) << "\"";
+        }
+        output
+        << " " << XML_ATTRIBUTE_LOCALWORKERS << "=\"" << m_farmLocalWorkers << "\""
+        << " " << XML_ATTRIBUTE_WORKER << "=\"" << xml::Utility::transformXmlEscChar(m_farmWorker) << "\""
+        << " " << XML_ATTRIBUTE_HEARTBEAT << "=\"" << m_farmHeartbeat.count() << "\""
+        << " " << XML_ATTRIBUTE_WAITTIMEOUT << "=\"" << m_farmWaitTimeout.count() << "\" />" << endl;
+        }
+
+        if (!m_canonicalizer.isEmpty())
+        {
+        m_canonicalizer.writeXml(output);
+        }
+
+        if (isSynthetic())
+        {
+        output
+        << " <" << XML_CHILDELEMENT_SYNTHETICCOST << " value=\"" << m_syntheticCost.count() << "\" />" << endl
+        << " <" << XML_CHILDELEMENT_SYNTHETICSEED << " value=\"" << m_syntheticSeed << "\" />" << endl;
+        }
+
         if (m_totalMilliSeconds.count() != 0) // discriminate between status.xml (totalMilliSeconds != 0) and population.settings.xml (totalMilliseconds == 0)
         {
         output
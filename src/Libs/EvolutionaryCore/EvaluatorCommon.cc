@@ -36,8 +36,13 @@
 #include "EvaluatorDispatcher.h"
 #include "EvaluatorLuaDispatcher.h"
 #include "EvaluatorFileDispatcher.h"
+#include "EvaluatorFarmDispatcher.h"
+#include "EvaluatorSyntheticDispatcher.h"
+#include "MemoryUsage.h"
 
 #include <algorithm>
+#include <iterator>
+#include <type_traits>
 #include <unordered_set>
 
 namespace ugp3 {
@@ -59,6 +64,14 @@ template <class T>
 const std::string EvaluatorCommon<T>::XML_ATTRIBUTE_CACHE = "cache";
 template <class T>
 const std::string EvaluatorCommon<T>::XML_ATTRIBUTE_PHENOTYPE = "phenotype";
+template <class T>
+const std::string EvaluatorCommon<T>::XML_ATTRIBUTE_TIMEOUTS = "timeouts";
+template <class T>
+const std::string EvaluatorCommon<T>::XML_ATTRIBUTE_PENALTIES = "penalties";
+template <class T>
+const std::string EvaluatorCommon<T>::XML_ATTRIBUTE_RACEDOUT = "racedOut";
+template <class T>
+const std::string EvaluatorCommon<T>::XML_ATTRIBUTE_CANONICAL = "canonical";
 
 template <class T>
 EvaluatorCommon<T>::EvaluatorCommon()
@@ -87,6 +100,11 @@ void EvaluatorCommon<T>::clear()
     m_actualEvaluationCount = 0;
     m_duplicateRequestCount = 0;
     m_cacheResolvedCount = 0;
+    m_timeoutCount = 0;
+    m_penaltyCount = 0;
+    m_incrementalCount = 0;
+    m_racedOutCount.clear();
+    m_canonicalHitCount = 0;
     
     m_cache.clear();
     if (m_dispatcher) 
@@ -105,11 +123,23 @@ void EvaluatorCommon<T>::evaluate(CandidateSolution& object)
     std::lock_guard<std::mutex> lock(m_cacheMutex);
 #endif
     
+    // Set again by the cache entry if the evaluation is abandoned
+    object.setRacedOutStage(0);
+    
     LOG_DEBUG << "Eval: req. for " << object << " = " << object.getNormalizedPhenotype() << std::ends;
-    CacheEntry* entry = findCacheEntry(object.getNormalizedPhenotype());
+    const std::string& key = getCacheKey(object);
+    CacheEntry* entry = findCacheEntry(key);
 
     if (entry) 
     {
+        if (entry->getPhenotypeHash() != 0 
+            && entry->getPhenotypeHash() != std::hash<std::string>()(object.getNormalizedPhenotype())) 
+        {
+            LOG_DEBUG << "Eval: cache entry shared through canonicalization." << std::ends;
+            ++m_canonicalHitCount;
+            getCanonicalizer().countHit(object.getCacheKeyRules());
+        }
+        
         bool immediate = entry->read(object, m_generation);
         if (immediate) 
 	{
@@ -127,7 +157,7 @@ void EvaluatorCommon<T>::evaluate(CandidateSolution& object)
     {
         // The entry will be updated when the object gets evaluated.
         LOG_DEBUG << "Eval: creating cache entry." << std::ends;
-        createCacheEntry(object.getNormalizedPhenotype());
+        createCacheEntry(key, object);
         ++m_actualEvaluationCount;
         Assert(m_dispatcher);
         m_dispatcher->evaluate(static_cast<T&>(object));
@@ -146,9 +176,29 @@ CacheEntry* EvaluatorCommon<T>::findCacheEntry(const std::string& code)
 }
 
 template <class T>
-void EvaluatorCommon<T>::createCacheEntry(const std::string& code)
+void EvaluatorCommon<T>::createCacheEntry(const std::string& code, const CandidateSolution& object)
 {
-    m_cache.insert(std::make_pair(code, CacheEntry(m_generation)));
+    // The hash tells apart the hits due to canonicalization
+    std::size_t hash = getCanonicalizer().isEmpty() ? 0 : std::hash<std::string>()(object.getNormalizedPhenotype());
+    m_cache.insert(std::make_pair(code, CacheEntry(m_generation, hash)));
+}
+
+template <class T>
+const std::string& EvaluatorCommon<T>::getCacheKey(const CandidateSolution& object)
+{
+    // Group phenotypes are made of the phenotypes of their members
+    if (getCanonicalizer().isEmpty() || std::is_same<T, Group>::value) 
+    {
+        return object.getNormalizedPhenotype();
+    }
+    
+    if (object.getCacheKey().empty()) 
+    {
+        std::uint64_t rules = 0;
+        std::string key = getCanonicalizer().canonicalize(object.getNormalizedPhenotype(), rules);
+        object.setCacheKey(key, rules);
+    }
+    return object.getCacheKey();
 }
         
     
@@ -161,6 +211,64 @@ void EvaluatorCommon<T>::flush(std::function<void(double)> showProgress)
     Evaluator::flush(showProgress);
 }
 
+template <class T>
+void EvaluatorCommon<T>::flushSome()
+{
+    Assert(m_dispatcher);
+    m_dispatcher->flushSome();
+    
+    Evaluator::flush([] (double) {});
+}
+
+template <class T>
+void EvaluatorCommon<T>::cancel()
+{
+#ifdef UGP3_USE_LUA
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+#endif
+    
+    Assert(m_dispatcher);
+    m_dispatcher->cancel();
+    
+    // Forget the entries that were waiting for those evaluations
+    auto it = m_cache.begin();
+    while (it != m_cache.end()) 
+    {
+        it = it->second.isPending() ? m_cache.erase(it) : std::next(it);
+    }
+}
+
+template <class T>
+bool EvaluatorCommon<T>::isEvaluated(const CandidateSolution& object) const
+{
+#ifdef UGP3_USE_LUA
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+#endif
+    
+    return object.getRawFitness().getIsValid();
+}
+
+template <class T>
+void EvaluatorCommon<T>::whileResultsFrozen(const std::function<void()>& action) const
+{
+#ifdef UGP3_USE_LUA
+    // The workers write the results while holding the cache mutex
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+#endif
+    
+    action();
+}
+
+template <class T>
+bool EvaluatorCommon<T>::isCached(const CandidateSolution& object)
+{
+#ifdef UGP3_USE_LUA
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+#endif
+    
+    return m_cache.find(getCacheKey(object)) != m_cache.end();
+}
+
 template <class T>
 void EvaluatorCommon<T>::readXml(const xml::Element& element)
 {
@@ -184,6 +292,27 @@ void EvaluatorCommon<T>::readXml(const xml::Element& element)
                 m_cacheResolvedCount = xml::Utility::attributeValueToUInt(*childElement, XML_ATTRIBUTE_CACHE);
             }
 
+            if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_TIMEOUTS)) 
+	    {
+                m_timeoutCount = xml::Utility::attributeValueToUInt(*childElement, XML_ATTRIBUTE_TIMEOUTS);
+            }
+
+            if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_PENALTIES)) 
+	    {
+                m_penaltyCount = xml::Utility::attributeValueToUInt(*childElement, XML_ATTRIBUTE_PENALTIES);
+            }
+
+            if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_RACEDOUT)) 
+	    {
+                istringstream stream(xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_RACEDOUT));
+                m_racedOutCount.assign(istream_iterator<unsigned int>(stream), istream_iterator<unsigned int>());
+            }
+
+            if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_CANONICAL)) 
+	    {
+                m_canonicalHitCount = xml::Utility::attributeValueToUInt(*childElement, XML_ATTRIBUTE_CANONICAL);
+            }
+
         } 
 	else if (elementName == XML_CHILDELEMENT_CACHE) 
 	{
@@ -206,19 +335,66 @@ void EvaluatorCommon<T>::readXml(const xml::Element& element)
         childElement = childElement->NextSiblingElement();
     }
     
-#ifdef UGP3_USE_LUA
-    const std::string& file = getScriptFile();
-    if (file.substr(file.length() - 4, file.length()) == ".lua") 
+    if (getCanonicalizer().isEmpty() == false && std::is_same<T, Group>::value) 
     {
-        m_dispatcher = new EvaluatorLuaDispatcher<T>(*this);
-    } 
-    else 
+        LOG_WARNING << "Canonicalization rules only apply to individuals: the group cache will use the plain phenotypes" << ends;
+    }
+    
+    createDispatcher();
+}
+
+template <class T>
+void EvaluatorCommon<T>::createDispatcher()
+{
+    if (m_dispatcher) 
     {
-        m_dispatcher = new EvaluatorFileDispatcher<T>(*this);
+        delete m_dispatcher;
+        m_dispatcher = nullptr;
+    }
+    
+    if (isSynthetic()) 
+    {
+        m_dispatcher = new EvaluatorSyntheticDispatcher<T>(*this);
     }
+    else if (isFarm() && std::is_same<T, Group>::value == false) 
+    {
+        m_dispatcher = new EvaluatorFarmDispatcher<T>(*this);
+    }
+    else 
+    {
+#ifdef UGP3_USE_LUA
+        const std::string& file = getScriptFile();
+        if (file.substr(file.length() - 4, file.length()) == ".lua") 
+        {
+            m_dispatcher = new EvaluatorLuaDispatcher<T>(*this);
+        } 
+        else 
+        {
+            m_dispatcher = new EvaluatorFileDispatcher<T>(*this);
+        }
 #else
-    m_dispatcher = new EvaluatorFileDispatcher<T>(*this);
+        m_dispatcher = new EvaluatorFileDispatcher<T>(*this);
 #endif
+    }
+    
+    if (isFarm() && std::is_same<T, Group>::value) 
+    {
+        LOG_WARNING << "The evaluation farm does not support groups, whose member files are kept on this host:"
+        << " the groups will be evaluated locally" << ends;
+    }
+    
+    if (getEvaluationStages() > 1 && m_dispatcher->supportsRacing() == false) 
+    {
+        LOG_WARNING << "Racing evaluation is only supported by external evaluators: the "
+        << getEvaluationStages() << " evaluation stages will be ignored" << ends;
+    }
+}
+
+template <class T>
+void EvaluatorCommon<T>::setType(const std::string& type)
+{
+    Evaluator::setType(type);
+    createDispatcher();
 }
 
 template <class T>
@@ -228,7 +404,19 @@ void EvaluatorCommon<T>::writeInnerXml(ostream& output) const
     << " " << XML_ATTRIBUTE_VALUE << "='" << m_actualEvaluationCount << "'"
     << " " << XML_ATTRIBUTE_DUPLICATE << "='" << m_duplicateRequestCount << "'"
     << " " << XML_ATTRIBUTE_CACHE << "='" << m_cacheResolvedCount << "'"
-    << " />" << std::endl;
+    << " " << XML_ATTRIBUTE_TIMEOUTS << "='" << m_timeoutCount << "'"
+    << " " << XML_ATTRIBUTE_PENALTIES << "='" << m_penaltyCount << "'";
+    if (m_racedOutCount.empty() == false) 
+    {
+        output << " " << XML_ATTRIBUTE_RACEDOUT << "='";
+        copy(m_racedOutCount.begin(), m_racedOutCount.end() - 1, ostream_iterator<unsigned int>(output, " "));
+        output << m_racedOutCount.back() << "'";
+    }
+    if (getCanonicalizer().isEmpty() == false) 
+    {
+        output << " " << XML_ATTRIBUTE_CANONICAL << "='" << m_canonicalHitCount << "'";
+    }
+    output << " />" << std::endl;
     
 #ifdef UGP3_USE_LUA
     std::lock_guard<std::mutex> lock(m_cacheMutex);
@@ -239,6 +427,11 @@ void EvaluatorCommon<T>::writeInnerXml(ostream& output) const
 	output << "<" << XML_CHILDELEMENT_CACHE << ">" << std::endl;
 	for (auto& entry: m_cache) 
 	{
+		// a pending entry would never be resolved after a recovery,
+		// and a raced-out entry is not a final result
+		if (entry.second.isPending() || entry.second.isRacedOut())
+			continue;
+		
 		output << "<" << XML_CHILDELEMENT_CACHEENTRY
 		<< " " << XML_ATTRIBUTE_PHENOTYPE << "='" << xml::Utility::transformXmlEscChar(entry.first) << "'"
 		<< ">" << std::endl;
@@ -250,11 +443,49 @@ void EvaluatorCommon<T>::writeInnerXml(ostream& output) const
 }
 
 template <class T>
-void EvaluatorCommon<T>::cacheFitness(const std::string& code, const Fitness& fitness)
+void EvaluatorCommon<T>::cacheFitness(const std::string& code, const Fitness& fitness, const std::string& state)
+{
+    CacheEntry* entry = findCacheEntry(code);
+    Assert(entry);
+    entry->store(fitness, state);
+}
+
+template <class T>
+void EvaluatorCommon<T>::cacheRacedOut(const std::string& code, const Fitness& fitness, unsigned int stage)
 {
+    Assert(stage > 0);
     CacheEntry* entry = findCacheEntry(code);
     Assert(entry);
-    entry->store(fitness);
+    entry->store(fitness, std::string(), stage);
+}
+
+template <class T>
+const std::string* EvaluatorCommon<T>::findCachedState(const std::string& code)
+{
+    CacheEntry* entry = findCacheEntry(code);
+    if (entry == nullptr || entry->isPending() || entry->getState().empty()) 
+    {
+        return nullptr;
+    }
+    return &entry->getState();
+}
+
+template <class T>
+void EvaluatorCommon<T>::countTimeouts(unsigned int timeouts, unsigned int penalties)
+{
+    m_timeoutCount += timeouts;
+    m_penaltyCount += penalties;
+}
+
+template <class T>
+void EvaluatorCommon<T>::countRacedOut(unsigned int stage, unsigned int count)
+{
+    Assert(stage > 0);
+    if (m_racedOutCount.size() < stage) 
+    {
+        m_racedOutCount.resize(stage, 0);
+    }
+    m_racedOutCount[stage - 1] += count;
 }
 
 template <class T>
@@ -265,11 +496,33 @@ void EvaluatorCommon<T>::step(unsigned int generation)
 #endif
     
     m_generation = generation;
+    
+    // A candidate dropped by a racing evaluation was judged against the
+    // survivors of its generation: its clones must be evaluated again
+    auto racedOut = m_cache.begin();
+    while (racedOut != m_cache.end()) 
+    {
+        racedOut = racedOut->second.isRacedOut() ? m_cache.erase(racedOut) : std::next(racedOut);
+    }
+    
+    /*
+     * Asynchronous populations leave evaluations running across generations:
+     * their entries are pending and cannot be evicted.
+     */
+    std::size_t pendingEntries = std::count_if(m_cache.begin(), m_cache.end(),
+        [] (const std::pair<const std::string, CacheEntry>& entry) {
+            return entry.second.isPending();
+        });
+    
     if (getCacheSize() == 0) 
     {
-        m_cache.clear();
+        auto it = m_cache.begin();
+        while (it != m_cache.end()) 
+	{
+            it = it->second.isPending() ? std::next(it) : m_cache.erase(it);
+        }
     } 
-    else if (m_cache.size() > getCacheSize()) 
+    else if (m_cache.size() > getCacheSize() + pendingEntries) 
     {
         LOG_VERBOSE << "Resizing the evaluator cache using LRU. Current size: " 
         << m_cache.size() << ", target: " << getCacheSize() << ends;
@@ -278,12 +531,15 @@ void EvaluatorCommon<T>::step(unsigned int generation)
         std::vector<std::size_t> generationHistogram(m_generation + 1, 0);
         for (auto& entry : m_cache) 
 	{
-            ++generationHistogram[entry.second.getGenerationLastUsed()];
+            if (!entry.second.isPending()) 
+	    {
+                ++generationHistogram[entry.second.getGenerationLastUsed()];
+            }
         } 
 
         // Erase the tail of the histogram
         std::vector<std::size_t> toDeleteHistogram(m_generation + 1, 0);
-        std::size_t toDelete = m_cache.size() - getCacheSize();
+        std::size_t toDelete = m_cache.size() - getCacheSize() - pendingEntries;
         for (unsigned int i = 0; i < m_generation + 1; ++i) 
 	{
             std::size_t toDeleteThisGen = std::min(toDelete, generationHistogram[i]);
@@ -303,7 +559,7 @@ void EvaluatorCommon<T>::step(unsigned int generation)
         while (it != m_cache.end()) 
 	{
             auto gen = it->second.getGenerationLastUsed();
-            if (toDeleteHistogram[gen] > 0) 
+            if (!it->second.isPending() && toDeleteHistogram[gen] > 0) 
 	    {
                 --toDeleteHistogram[gen];
                 it = m_cache.erase(it);
@@ -313,7 +569,7 @@ void EvaluatorCommon<T>::step(unsigned int generation)
                 ++it;
             }
         }
-        Assert(m_cache.size() == getCacheSize());
+        Assert(m_cache.size() == getCacheSize() + pendingEntries);
     }
 }
 
@@ -329,6 +585,16 @@ void EvaluatorCommon<T>::dumpStatistics(ostream& output) const
     output << "," << m_actualEvaluationCount;
     output << "," << m_duplicateRequestCount;
     output << "," << m_cacheResolvedCount;
+    output << "," << m_timeoutCount;
+    output << "," << m_penaltyCount;
+    for (unsigned int stage = 1; stage < getEvaluationStages(); ++stage) 
+    {
+        output << "," << (stage <= m_racedOutCount.size() ? m_racedOutCount[stage - 1] : 0);
+    }
+    if (getCanonicalizer().isEmpty() == false) 
+    {
+        output << "," << m_canonicalHitCount;
+    }
 }
 
 template <class T>
@@ -337,6 +603,32 @@ void EvaluatorCommon<T>::dumpStatisticsHeader(const string& name, ostream& outpu
     output << "," << name << "_EvalCount";
     output << "," << name << "_DuplicateCount";
     output << "," << name << "_CacheCount";
+    output << "," << name << "_TimeoutCount";
+    output << "," << name << "_PenaltyCount";
+    for (unsigned int stage = 1; stage < getEvaluationStages(); ++stage) 
+    {
+        output << "," << name << "_RacedOutStage" << stage;
+    }
+    if (getCanonicalizer().isEmpty() == false) 
+    {
+        output << "," << name << "_CanonicalHits";
+    }
+}
+
+template <class T>
+size_t EvaluatorCommon<T>::getCacheMemoryUsage() const
+{
+#ifdef UGP3_USE_LUA
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+#endif
+    
+    // Buckets of the hash table, then one node per entry
+    size_t bytes = m_cache.bucket_count() * sizeof(void*);
+    for (const auto& entry: m_cache) {
+        bytes += sizeof(entry) + sizeof(void*)
+            + MemoryUsage::ofString(entry.first) + entry.second.getMemoryUsage();
+    }
+    return bytes;
 }
 
 template <class T>
@@ -355,6 +647,36 @@ void EvaluatorCommon<T>::showStatistics() const
     << m_cache.size() << " elements are stored in the cache)."
     << ends;
     
+    if (getEvaluationTimeout().count() != 0) 
+    {
+        LOG_INFO << "Evaluator timeouts: " << m_timeoutCount << " runs killed, "
+        << m_penaltyCount << " candidates penalized." << ends;
+    }
+    
+    if (getEvaluationStages() > 1) 
+    {
+        ostringstream stages;
+        for (unsigned int stage = 1; stage < getEvaluationStages(); ++stage) 
+	{
+            stages << (stage > 1 ? ", " : "") 
+            << (stage <= m_racedOutCount.size() ? m_racedOutCount[stage - 1] : 0) << " after stage " << stage;
+        }
+        LOG_INFO << "Evaluator racing: candidates dropped " << stages.str() << "." << ends;
+    }
+    
+    if (getCanonicalizer().isEmpty() == false) 
+    {
+        LOG_INFO << "Evaluator canonicalization: " << m_canonicalHitCount 
+        << " cache hits between different phenotypes." << ends;
+        getCanonicalizer().showStatistics();
+    }
+    
+    if (m_incrementalCount > 0) 
+    {
+        LOG_INFO << "Evaluator: " << m_incrementalCount 
+        << " evaluations computed incrementally from the state of a parent." << ends;
+    }
+    
     LOG_INFO << "Evaluator cache: ";
     if (getCacheSize() > 0) 
     {
@@ -378,9 +700,12 @@ void EvaluatorCommon<T>::showStatistics() const
 const std::string CacheEntry::XML_ELEMENT_HISTORY = "history";
 const std::string CacheEntry::XML_ATTRIBUTE_GENERATIONSTORED = "generationStored";
 const std::string CacheEntry::XML_ATTRIBUTE_GENERATIONREAD = "generationRead";
+const std::string CacheEntry::XML_ELEMENT_STATE = "state";
+const std::string CacheEntry::XML_ATTRIBUTE_VALUE = "value";
 
-CacheEntry::CacheEntry(unsigned int generationStored)
-: m_generationStored(generationStored), m_generationRead(generationStored)
+CacheEntry::CacheEntry(unsigned int generationStored, std::size_t phenotypeHash)
+: m_generationStored(generationStored), m_generationRead(generationStored), m_phenotypeHash(phenotypeHash),
+m_racedOutStage(0)
 {
     m_fitness.invalidate();
 }
@@ -390,6 +715,7 @@ bool CacheEntry::read(CandidateSolution& object, unsigned int generationRead)
     if (m_fitness.getIsValid())
     {
         object.getRawFitness() = m_fitness;
+        object.setRacedOutStage(m_racedOutStage);
     } 
     else 
     {
@@ -408,13 +734,24 @@ bool CacheEntry::read(CandidateSolution& object, unsigned int generationRead)
 
 }
 
-void CacheEntry::store(const Fitness& fitness)
+size_t CacheEntry::getMemoryUsage() const
+{
+    return m_fitness.getValues().capacity() * sizeof(double)
+        + MemoryUsage::ofString(m_fitness.getDescription())
+        + MemoryUsage::ofString(m_state)
+        + MemoryUsage::ofVector(m_waiters);
+}
+
+void CacheEntry::store(const Fitness& fitness, const std::string& state, unsigned int racedOutStage)
 {
     Assert(fitness.getIsValid());
     m_fitness = fitness;
+    m_state = state;
+    m_racedOutStage = racedOutStage;
     for (CandidateSolution* object: m_waiters) 
     {
         object->getRawFitness() = m_fitness;
+        object->setRacedOutStage(m_racedOutStage);
     }
     m_waiters.clear();
 }
@@ -434,6 +771,10 @@ void CacheEntry::readXml(const xml::Element& element)
 	{
             m_fitness.readXml(*childElement);
         }
+	else if (elementName == XML_ELEMENT_STATE) 
+	{
+            m_state = xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_VALUE);
+        }
         childElement = childElement->NextSiblingElement();
     }
 }
@@ -446,6 +787,13 @@ void CacheEntry::writeInnerXml(ostream& output) const
     << " />" << std::endl;
     
     m_fitness.writeXml(output);
+    
+    if (!m_state.empty()) 
+    {
+        output << "<" << XML_ELEMENT_STATE
+        << " " << XML_ATTRIBUTE_VALUE << "='" << xml::Utility::transformXmlEscChar(m_state) << "'"
+        << " />" << std::endl;
+    }
 }
 
 // Explicit instanciations
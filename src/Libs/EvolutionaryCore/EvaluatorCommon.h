@@ -47,13 +47,20 @@ class CacheEntry
 {
 private:
     Fitness m_fitness;
+    std::string m_state;
     unsigned int m_generationStored;
     unsigned int m_generationRead;
     std::vector<CandidateSolution*> m_waiters;
+    // Hash of the phenotype that created the entry (0 if unknown)
+    std::size_t m_phenotypeHash;
+    // Racing stage after which the evaluation was abandoned, 0 if it was completed
+    unsigned int m_racedOutStage;
     
     static const std::string XML_ELEMENT_HISTORY;
     static const std::string XML_ATTRIBUTE_GENERATIONSTORED;
     static const std::string XML_ATTRIBUTE_GENERATIONREAD;
+    static const std::string XML_ELEMENT_STATE;
+    static const std::string XML_ATTRIBUTE_VALUE;
     
 public:
     /**
@@ -62,7 +69,7 @@ public:
      * evaluated, the waiters will be updated with the new fitness.
      * The given code is used to match objects to this cache entry.
      */
-    CacheEntry(unsigned int generationStored);
+    CacheEntry(unsigned int generationStored, std::size_t phenotypeHash = 0);
     
     /**
      * If the fitness is valid, update the object with the current fitness.
@@ -73,9 +80,19 @@ public:
     bool read(CandidateSolution& object, unsigned int generationRead);
     
     /**
-     * Update the cache entry with the given fitness.
+     * Update the cache entry with the given fitness and with the
+     * state handle returned by an incremental evaluator (may be empty).
+     * A non-zero racedOutStage marks the fitness as the placeholder of an
+     * abandoned evaluation: it is given only to the clones of the same
+     * generation, and the entry is dropped when the generation changes.
+     */
+    void store(const Fitness& fitness, const std::string& state = std::string(), unsigned int racedOutStage = 0);
+    
+    /**
+     * Return the state handle that the evaluator returned for this entry,
+     * or an empty string.
      */
-    void store(const Fitness& fitness);
+    const std::string& getState() const { return m_state; }
     
     /**
      * Return the generation number used for LRU.
@@ -87,6 +104,29 @@ public:
      */
     unsigned int getGenerationStored() const { return m_generationStored; }
     
+    /**
+     * Return the hash of the normalized phenotype that created the entry,
+     * or 0 for the entries restored from a previous run.
+     */
+    std::size_t getPhenotypeHash() const { return m_phenotypeHash; }
+    
+    /**
+     * Return true while the fitness is still being computed.
+     * Pending entries must not be evicted, or their waiters would never be updated.
+     */
+    bool isPending() const { return !m_fitness.getIsValid(); }
+    
+    /**
+     * Return true if the fitness is the placeholder of a racing evaluation
+     * that was abandoned, and not the result of a complete evaluation.
+     */
+    bool isRacedOut() const { return m_racedOutStage != 0; }
+    
+    /**
+     * Approximate number of bytes owned by the entry.
+     */
+    std::size_t getMemoryUsage() const;
+    
     /**
      * Serialize the cache entry
      */
@@ -107,6 +147,10 @@ private:
     static const std::string XML_ATTRIBUTE_VALUE;
     static const std::string XML_ATTRIBUTE_DUPLICATE;
     static const std::string XML_ATTRIBUTE_CACHE;
+    static const std::string XML_ATTRIBUTE_TIMEOUTS;
+    static const std::string XML_ATTRIBUTE_PENALTIES;
+    static const std::string XML_ATTRIBUTE_RACEDOUT;
+    static const std::string XML_ATTRIBUTE_CANONICAL;
     static const std::string XML_ATTRIBUTE_PHENOTYPE;
     
     /**
@@ -139,6 +183,30 @@ private:
     unsigned int m_actualEvaluationCount = 0;
     unsigned int m_duplicateRequestCount = 0;
     unsigned int m_cacheResolvedCount = 0;
+    
+    /**
+     * Evaluator runs killed because they exceeded the time limit, and
+     * candidates that received the timeout penalty fitness.
+     */
+    unsigned int m_timeoutCount = 0;
+    unsigned int m_penaltyCount = 0;
+    
+    /**
+     * Evaluations computed incrementally from the state of a parent.
+     */
+    unsigned int m_incrementalCount = 0;
+    
+    /**
+     * Racing evaluation: candidates dropped after each stage (the first
+     * element counts the candidates dropped after stage 1).
+     */
+    std::vector<unsigned int> m_racedOutCount;
+    
+    /**
+     * Cache hits between candidates whose normalized phenotypes differ,
+     * made possible by the canonicalization rules.
+     */
+    unsigned int m_canonicalHitCount = 0;
 
     /** An internal flag, that is used to decide whether the cache will be saved
     */
@@ -149,13 +217,18 @@ private:
      * Before calling this function, the class must own the cache mutex.
      * @return The entry of a clone of nullptr.
      */
-    CacheEntry* findCacheEntry(const std::string& normalizedPhenotype);
+    CacheEntry* findCacheEntry(const std::string& cacheKey);
     
     /**
      * Creates a new cache entry for the given candidate solution.
      * Before calling this function, the class must own the cache mutex.
      */
-    void createCacheEntry(const std::string& normalizedPhenotype);
+    void createCacheEntry(const std::string& cacheKey, const CandidateSolution& object);
+    
+    /**
+     * Replaces the dispatcher with the one matching the current type and script.
+     */
+    void createDispatcher();
     
     
 public:
@@ -167,12 +240,23 @@ public:
     
     virtual void evaluate(CandidateSolution& object);
     virtual void flush(std::function<void(double)> showProgress);
+    virtual void flushSome();
+    virtual void cancel();
+    virtual bool isEvaluated(const CandidateSolution& object) const;
+    virtual void whileResultsFrozen(const std::function<void()>& action) const;
+    virtual bool isCached(const CandidateSolution& object);
     virtual void step(unsigned int generation);
     virtual void clear();
     virtual unsigned int getTotalEvaluations() const { return m_actualEvaluationCount; }
     virtual void showStatistics() const;
     virtual void dumpStatistics(std::ostream& output) const;
     virtual void dumpStatisticsHeader(const std::string& name, std::ostream& output) const;
+    virtual std::size_t getCacheMemoryUsage() const;
+    
+    /**
+     * Changing the type replaces the dispatcher: do not call while evaluations are in progress.
+     */
+    virtual void setType(const std::string& type);
     
 public: // API for dispatchers
     /**
@@ -180,6 +264,14 @@ public: // API for dispatchers
      */
     unsigned int getCurrentGeneration() const { return m_generation; }
     
+    /**
+     * Return the key of the given object in the cache: its normalized
+     * phenotype rewritten by the canonicalization rules, computed once
+     * and stored in the object. Groups are not canonicalized.
+     * Same locking requirements as cacheFitness().
+     */
+    const std::string& getCacheKey(const CandidateSolution& object);
+    
     /**
      * Put the current fitness of the given objet in the cache.
      * 
@@ -187,7 +279,44 @@ public: // API for dispatchers
      * mutex (returned by the following function) is already locked 
      * by the caller.
      */
-    void cacheFitness(const std::string& code, const Fitness& fitness);
+    void cacheFitness(const std::string& code, const Fitness& fitness, const std::string& state = std::string());
+    
+    /**
+     * Put the placeholder fitness of a candidate dropped by a racing
+     * evaluation in the cache. It is not a final result: only the clones
+     * evaluated in the same generation share it, and they are dropped too.
+     * Same locking requirements as cacheFitness().
+     * @param stage Stage after which the candidate was dropped (from 1).
+     */
+    void cacheRacedOut(const std::string& code, const Fitness& fitness, unsigned int stage);
+    
+    /**
+     * Return the state handle stored with the fitness of the given code,
+     * or nullptr if the code is not in the cache or has no state.
+     * Same locking requirements as cacheFitness().
+     */
+    const std::string* findCachedState(const std::string& code);
+    
+    /**
+     * Account for evaluations that exceeded the time limit.
+     * Same locking requirements as cacheFitness().
+     * @param timeouts Number of evaluator runs killed.
+     * @param penalties Number of candidates that got the penalty fitness.
+     */
+    void countTimeouts(unsigned int timeouts, unsigned int penalties);
+    
+    /**
+     * Account for an evaluation computed from the state of a parent.
+     * Same locking requirements as cacheFitness().
+     */
+    void countIncremental() { ++m_incrementalCount; }
+    
+    /**
+     * Account for candidates dropped by a racing evaluation.
+     * Same locking requirements as cacheFitness().
+     * @param stage Stage after which the candidates were dropped (from 1).
+     */
+    void countRacedOut(unsigned int stage, unsigned int count);
 
     /**
 	Clears all values currently in the cache.
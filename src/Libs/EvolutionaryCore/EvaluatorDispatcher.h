@@ -52,6 +52,24 @@ public:
     virtual void evaluate(T& object) = 0;
     virtual void flush(std::function<void(double)>& showProgress) = 0;
     
+    /**
+     * Return as soon as at least one request has been completed,
+     * or when there are no requests left.
+     */
+    virtual void flushSome() = 0;
+    
+    /**
+     * Drop all the requests that are not complete yet:
+     * their objects will not be updated.
+     */
+    virtual void cancel() = 0;
+    
+    /**
+     * @return True if the dispatcher can split the evaluations in stages
+     * (see Evaluator::getEvaluationStages()).
+     */
+    virtual bool supportsRacing() const { return false; }
+    
     EvaluatorCommon<T>& getEvaluator() const { return m_evaluator; }
 };
 
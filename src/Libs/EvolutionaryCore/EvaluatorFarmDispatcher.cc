@@ -0,0 +1,615 @@
+/***********************************************************************\
+|                                                                       |
+| EvaluatorFarmDispatcher.cc                                            |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file EvaluatorFarmDispatcher.cc
+ *
+ */
+
+#include "EvaluatorFarmDispatcher.h"
+#include "Individual.h"
+#include "EvaluatorCommon.h"
+#include "Population.h"
+#include "Group.h"
+#include "GroupPopulation.h"
+
+#include "Log.h"
+#include "File.h"
+#include "Debug.h"
+#include "Process.h"
+#include "Environment.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+namespace ugp3 {
+namespace core {
+
+const string FarmProtocol::HELLO = "HELLO";
+const string FarmProtocol::SETUP = "SETUP";
+const string FarmProtocol::JOB = "JOB";
+const string FarmProtocol::HEARTBEAT = "HEARTBEAT";
+const string FarmProtocol::RESULT = "RESULT";
+const string FarmProtocol::TIMEOUT = "TIMEOUT";
+const string FarmProtocol::FAILURE = "FAILURE";
+
+string FarmProtocol::packFiles(const string& arguments, const vector<string>& files)
+{
+    ostringstream payload;
+    payload << arguments << "\n";
+    for (const string& file: files) 
+    {
+        ifstream input(file.c_str(), ios::binary);
+        if (input.is_open() == false) 
+        {
+            throw Exception("The file \"" + file + "\" is not accessible.", LOCATION);
+        }
+        ostringstream content;
+        content << input.rdbuf();
+        payload << file << "\n" << content.str().size() << "\n" << content.str();
+    }
+    return payload.str();
+}
+
+string FarmProtocol::unpackFiles(const string& payload, vector<string>& files)
+{
+    istringstream input(payload);
+    string arguments;
+    getline(input, arguments);
+    
+    files.clear();
+    string file;
+    while (getline(input, file)) 
+    {
+        string size;
+        getline(input, size);
+        string content(Convert::toULong(size), '\0');
+        input.read(&content[0], content.size());
+        if (input.fail()) 
+        {
+            throw Exception("Truncated content of the file \"" + file + "\".", LOCATION);
+        }
+        
+        // The name may be taken by a link to the files of the farm
+        File::remove(file);
+        ofstream output(file.c_str(), ios::binary);
+        if (output.is_open() == false) 
+        {
+            throw Exception("Could not create the file \"" + file + "\".", LOCATION);
+        }
+        output << content;
+        files.push_back(file);
+    }
+    return arguments;
+}
+
+template <class T>
+const chrono::seconds EvaluatorFarmDispatcher<T>::WAIT_REPORT_INTERVAL(10);
+
+template <class T>
+EvaluatorFarmDispatcher<T>::EvaluatorFarmDispatcher(EvaluatorCommon< T >& evaluator)
+: EvaluatorFileDispatcher<T>(evaluator), m_nextJobId(0), m_completedJobs(0)
+{
+}
+
+template <class T>
+EvaluatorFarmDispatcher<T>::~EvaluatorFarmDispatcher()
+{
+    // The workers exit when the connection is closed
+    m_workers.clear();
+    m_server.close();
+    for (int pid: m_localWorkers) 
+    {
+        if (pid >= 0) 
+        {
+            Process::kill(pid);
+        }
+    }
+}
+
+template <class T>
+void EvaluatorFarmDispatcher<T>::start()
+{
+    if (m_server.isOpen()) 
+    {
+        return;
+    }
+    
+    const Evaluator& evaluator = EvaluatorDispatcher<T>::getEvaluator();
+    const string& address = evaluator.getFarmBind();
+    m_server.listen(address, evaluator.getFarmPort());
+    LOG_INFO << "Evaluation farm listening on " << address << ":" << evaluator.getFarmPort() << ends;
+    
+    const bool loopback = address.compare(0, 4, "127.") == 0 || address == "::1";
+    if (evaluator.getFarmToken().empty() && loopback == false) 
+    {
+        LOG_WARNING << "The evaluation farm has no token: any host that reaches the port can join it" << ends;
+    }
+    
+    if (evaluator.getFarmLocalWorkers() == 0) 
+    {
+        return;
+    }
+    
+    // The token is inherited by the workers, and stays out of their command line
+    SETENV("UGP3_FARM_TOKEN", evaluator.getFarmToken());
+    const string host = address == "0.0.0.0" || address == "::" ? "localhost" : address;
+    for (unsigned int i = 1; i <= evaluator.getFarmLocalWorkers(); ++i) 
+    {
+        const string name = "farm.worker" + Convert::toString(i);
+        const string commandLine = evaluator.getFarmWorker() + " --server " + host + " --port " 
+            + Convert::toString(evaluator.getFarmPort()) + " --sandbox " + name + " > " + name + ".log 2>&1";
+        int pid = Process::spawn(commandLine);
+        if (pid < 0) 
+        {
+            LOG_WARNING << "Could not start the local worker \"" << commandLine << "\"" << ends;
+            continue;
+        }
+        LOG_VERBOSE << "Started the local worker \"" << commandLine << "\"" << ends;
+        m_localWorkers.push_back(pid);
+    }
+    SETENV("UGP3_FARM_TOKEN", "");
+}
+
+template <class T>
+void EvaluatorFarmDispatcher<T>::createJobs()
+{
+    const unsigned int concurrentEvaluations = max(1u, EvaluatorDispatcher<T>::getEvaluator().getConcurrentEvaluations());
+    while (!this->m_pendingEvaluations.empty()) 
+    {
+        Job job;
+        job.id = m_nextJobId++;
+        job.retries = 0;
+        job.losses = 0;
+        while (!this->m_pendingEvaluations.empty() && job.objects.size() < concurrentEvaluations) 
+        {
+            job.objects.push_back(this->m_pendingEvaluations.front());
+            this->m_pendingEvaluations.pop();
+        }
+        m_jobs.push_back(job);
+    }
+}
+
+template <class T>
+void EvaluatorFarmDispatcher<T>::dispatchJobs()
+{
+    const Evaluator& evaluator = EvaluatorDispatcher<T>::getEvaluator();
+    
+    for (size_t i = 0; i < m_workers.size() && !m_jobs.empty(); ) 
+    {
+        Worker& worker = *m_workers[i];
+        if (worker.busy || worker.name.empty()) 
+        {
+            ++i;
+            continue;
+        }
+        
+        Job& job = m_jobs.front();
+        string arguments;
+        vector<string> inputFiles;
+        for (T* candidate: job.objects) 
+        {
+            const string& fileName = File::formatToName(evaluator.getInputFile(), candidate->getId());
+            this->writeCode(*candidate, fileName, inputFiles);
+            arguments += (arguments.empty() ? "" : " ") + fileName;
+        }
+        const string& payload = FarmProtocol::packFiles(arguments, inputFiles);
+        for (const string& file: inputFiles) 
+        {
+            File::remove(file);
+        }
+        
+        if (worker.socket->send(FarmProtocol::JOB, job.id, payload) == false) 
+        {
+            // The job is still at the front of the queue
+            dropWorker(i, "does not receive messages");
+            continue;
+        }
+        LOG_DEBUG << "Sent job " << job.id << " (" << job.objects.size() << " " << TypeName<T>::name 
+        << "s) to worker " << worker.name << ends;
+        
+        worker.busy = true;
+        worker.job = job;
+        worker.started = chrono::steady_clock::now();
+        m_jobs.pop_front();
+        ++i;
+    }
+}
+
+template <class T>
+void EvaluatorFarmDispatcher<T>::poll(chrono::milliseconds timeout)
+{
+    vector<Socket*> sockets(1, &m_server);
+    for (auto& worker: m_workers) 
+    {
+        sockets.push_back(worker->socket.get());
+    }
+    vector<bool> ready;
+    Socket::wait(sockets, timeout, ready);
+    const auto now = chrono::steady_clock::now();
+    const auto silence = EvaluatorDispatcher<T>::getEvaluator().getFarmHeartbeat() * FarmProtocol::HEARTBEATS_BEFORE_LOSS;
+    
+    // Backwards, since lost workers are removed
+    for (size_t i = m_workers.size(); i-- > 0; ) 
+    {
+        Worker& worker = *m_workers[i];
+        if (ready[i + 1] == false) 
+        {
+            if (now - worker.lastSeen > silence) 
+            {
+                dropWorker(i, "stopped sending heartbeats");
+            }
+            continue;
+        }
+        
+        if (worker.socket->receive() == false) 
+        {
+            dropWorker(i, "closed the connection");
+            continue;
+        }
+        worker.lastSeen = now;
+        
+        string keyword;
+        unsigned long id = 0;
+        string payload;
+        string reason;
+        while (reason.empty()) 
+        {
+            try 
+            {
+                if (worker.socket->nextMessage(keyword, id, payload) == false) 
+                {
+                    break;
+                }
+            } 
+            catch (const Exception&) 
+            {
+                reason = "does not follow the protocol";
+                break;
+            }
+            handleMessage(worker, keyword, id, payload, reason);
+        }
+        if (reason.empty() == false) 
+        {
+            dropWorker(i, reason);
+        }
+    }
+    
+    if (ready[0]) 
+    {
+        unique_ptr<Worker> worker(new Worker);
+        worker->socket.reset(m_server.accept());
+        // A worker that stops reading must not block the farm longer than a silent one
+        worker->socket->setSendTimeout(silence);
+        worker->busy = false;
+        worker->lastSeen = now;
+        m_workers.push_back(move(worker));
+    }
+}
+
+template <class T>
+bool EvaluatorFarmDispatcher<T>::handleMessage(Worker& worker, const string& keyword, unsigned long id, const string& payload, string& reason)
+{
+    EvaluatorCommon<T>& evaluator = EvaluatorDispatcher<T>::getEvaluator();
+    
+    if (keyword == FarmProtocol::HELLO && worker.name.empty()) 
+    {
+        istringstream hello(payload);
+        string name;
+        string token;
+        getline(hello, name);
+        getline(hello, token);
+        if (token != evaluator.getFarmToken()) 
+        {
+            reason = "did not present the token of the farm (name \"" + name + "\")";
+            return false;
+        }
+        
+        worker.name = name.empty() ? "#" + Convert::toString(m_workers.size()) : name;
+        ostringstream setup;
+        setup << evaluator.getScriptFile() << "\n"
+        << evaluator.getOutputFile() << "\n"
+        << evaluator.getEvaluationTimeout().count() << "\n"
+        << evaluator.getFarmHeartbeat().count() << "\n"
+        << (evaluator.getRemoveTemporaryFiles() ? 1 : 0) << "\n";
+        if (worker.socket->send(FarmProtocol::SETUP, 0, setup.str()) == false) 
+        {
+            reason = "does not receive messages";
+            return false;
+        }
+        LOG_INFO << "Evaluation worker " << worker.name << " joined the farm (" 
+        << count_if(m_workers.begin(), m_workers.end(), 
+            [] (const unique_ptr<Worker>& other) { return other->name.empty() == false; }) 
+        << " workers)" << ends;
+        return true;
+    }
+    
+    // Nothing is accepted from a worker that did not join
+    if (worker.name.empty()) 
+    {
+        reason = "sent " + keyword + " before joining the farm";
+        return false;
+    }
+    
+    if (keyword == FarmProtocol::HEARTBEAT) 
+    {
+        return true;
+    }
+    
+    if (keyword != FarmProtocol::RESULT && keyword != FarmProtocol::TIMEOUT && keyword != FarmProtocol::FAILURE) 
+    {
+        reason = "sent the unknown message " + keyword;
+        return false;
+    }
+    
+    if (worker.busy == false || id != worker.job.id) 
+    {
+        LOG_WARNING << "Ignoring the unexpected message " << keyword << " " << id 
+        << " from evaluation worker " << worker.name << ends;
+        return true;
+    }
+    
+    // The worker cannot run the evaluator: its job goes to another one, see dropWorker()
+    if (keyword == FarmProtocol::FAILURE) 
+    {
+        reason = "failed (" + payload + ")";
+        return false;
+    }
+    
+    // The worker is idle again, the job may have been cancelled meanwhile
+    Job job = worker.job;
+    worker.busy = false;
+    if (job.objects.empty()) 
+    {
+        return true;
+    }
+    
+    if (keyword == FarmProtocol::RESULT) 
+    {
+        // each candidate of the batch gets its share of the time (retries add up)
+        const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - worker.started).count();
+        for (T* candidate: job.objects) 
+        {
+            candidate->setEvaluationTime(candidate->getEvaluationTime() + elapsed / job.objects.size());
+        }
+        
+        istringstream output(payload);
+        this->parseEvaluations(output, job.objects, true);
+        ++m_completedJobs;
+    } 
+    else 
+    {
+        LOG_WARNING << "The process \"" << evaluator.getScriptFile() << "\" has been killed on worker " 
+        << worker.name << " after exceeding the time limit" << ends;
+        handleTimeout(job);
+    }
+    return true;
+}
+
+template <class T>
+void EvaluatorFarmDispatcher<T>::handleTimeout(Job& job)
+{
+    EvaluatorCommon<T>& evaluator = EvaluatorDispatcher<T>::getEvaluator();
+    evaluator.countTimeouts(1, 0);
+    
+    if (job.objects.size() > 1) 
+    {
+        LOG_VERBOSE << "Evaluating the " << job.objects.size() << " " << TypeName<T>::name
+        << "s of the batch one at a time to isolate the failure" << ends;
+        for (auto it = job.objects.rbegin(); it != job.objects.rend(); ++it) 
+        {
+            Job single;
+            single.id = m_nextJobId++;
+            single.objects.push_back(*it);
+            single.retries = 0;
+            single.losses = 0;
+            m_jobs.push_front(single);
+        }
+        return;
+    }
+    
+    if (job.retries < evaluator.getTimeoutRetries()) 
+    {
+        ++job.retries;
+        LOG_VERBOSE << "Evaluating " << TypeName<T>::name << " " << *job.objects.front()
+        << " again (retry " << job.retries << " of " << evaluator.getTimeoutRetries() << ")" << ends;
+        m_jobs.push_front(job);
+        return;
+    }
+    
+    this->assignTimeoutPenalty(*job.objects.front());
+    ++m_completedJobs;
+}
+
+template <class T>
+void EvaluatorFarmDispatcher<T>::dropWorker(size_t index, const string& reason)
+{
+    Worker& worker = *m_workers[index];
+    const string name = worker.name.empty() ? "(unnamed)" : worker.name;
+    
+    if (worker.busy && worker.job.objects.empty() == false) 
+    {
+        Job job = worker.job;
+        if (++job.losses >= MAX_LOSSES) 
+        {
+            throw Exception("Lost " + Convert::toString(job.losses) + " evaluation workers while evaluating the same " 
+                + TypeName<T>::name + "s, the last one " + name + " " + reason + ".", LOCATION);
+        }
+        LOG_WARNING << "Evaluation worker " << name << " " << reason << ": its " << job.objects.size() 
+        << " " << TypeName<T>::name << "s will be evaluated again" << ends;
+        m_jobs.push_front(job);
+    } 
+    else 
+    {
+        LOG_WARNING << "Evaluation worker " << name << " " << reason << ends;
+    }
+    
+    m_workers.erase(m_workers.begin() + index);
+}
+
+template <class T>
+void EvaluatorFarmDispatcher<T>::checkWorkers()
+{
+    const Evaluator& evaluator = EvaluatorDispatcher<T>::getEvaluator();
+    const auto now = chrono::steady_clock::now();
+    
+    for (size_t i = 0; i < m_localWorkers.size(); ++i) 
+    {
+        int status = 0;
+        if (m_localWorkers[i] >= 0 && Process::hasExited(m_localWorkers[i], status)) 
+        {
+            const string name = "farm.worker" + Convert::toString(i + 1);
+            LOG_WARNING << "The local evaluation worker " << name << " exited, see \"" << name << ".log\"" << ends;
+            m_localWorkers[i] = -1;
+        }
+    }
+    
+    // Only the workers that joined can evaluate
+    const bool joined = any_of(m_workers.begin(), m_workers.end(), 
+        [] (const unique_ptr<Worker>& worker) { return worker->name.empty() == false; });
+    if (joined) 
+    {
+        m_waitingSince = chrono::steady_clock::time_point();
+        return;
+    }
+    
+    if (m_waitingSince == chrono::steady_clock::time_point()) 
+    {
+        m_waitingSince = now;
+        m_lastWaitReport = now;
+        LOG_INFO << "Waiting for evaluation workers to connect to " << evaluator.getFarmBind() << ":" 
+        << evaluator.getFarmPort() << " (" << countRemaining() << " " << TypeName<T>::name << "s to evaluate)" << ends;
+        return;
+    }
+    
+    const auto waited = chrono::duration_cast<chrono::seconds>(now - m_waitingSince);
+    if (evaluator.getFarmWaitTimeout().count() != 0 && now - m_waitingSince > evaluator.getFarmWaitTimeout()) 
+    {
+        throw Exception("No evaluation worker connected to the farm for " + Convert::toString(waited.count()) 
+            + " seconds, " + Convert::toString(countRemaining()) + " " + TypeName<T>::name + "s were not evaluated.", LOCATION);
+    }
+    if (now - m_lastWaitReport >= WAIT_REPORT_INTERVAL) 
+    {
+        m_lastWaitReport = now;
+        LOG_WARNING << "No evaluation worker connected to the farm for " << waited.count() << " seconds, " 
+        << countRemaining() << " " << TypeName<T>::name << "s to evaluate" << ends;
+    }
+}
+
+template <class T>
+bool EvaluatorFarmDispatcher<T>::isWorking() const
+{
+    if (!m_jobs.empty()) 
+    {
+        return true;
+    }
+    for (auto& worker: m_workers) 
+    {
+        if (worker->busy && worker->job.objects.empty() == false) 
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T>
+size_t EvaluatorFarmDispatcher<T>::countRemaining() const
+{
+    size_t remaining = 0;
+    for (auto& job: m_jobs) 
+    {
+        remaining += job.objects.size();
+    }
+    for (auto& worker: m_workers) 
+    {
+        remaining += worker->busy ? worker->job.objects.size() : 0;
+    }
+    return remaining;
+}
+
+template <class T>
+void EvaluatorFarmDispatcher<T>::flush(std::function<void(double)>& showProgress)
+{
+    start();
+    createJobs();
+    
+    const chrono::milliseconds timeout = min(chrono::milliseconds(100), EvaluatorDispatcher<T>::getEvaluator().getFarmHeartbeat());
+    while (isWorking()) 
+    {
+        const size_t requests = max<size_t>(this->m_requestsSinceFlush, countRemaining());
+        showProgress((double)(requests - countRemaining()) / requests);
+        checkWorkers();
+        dispatchJobs();
+        poll(timeout);
+    }
+    showProgress(1);
+    this->m_requestsSinceFlush = 0;
+}
+
+template <class T>
+void EvaluatorFarmDispatcher<T>::flushSome()
+{
+    start();
+    createJobs();
+    
+    const chrono::milliseconds timeout = min(chrono::milliseconds(100), EvaluatorDispatcher<T>::getEvaluator().getFarmHeartbeat());
+    const unsigned long completedJobs = m_completedJobs;
+    while (isWorking() && m_completedJobs == completedJobs) 
+    {
+        checkWorkers();
+        dispatchJobs();
+        poll(timeout);
+    }
+    // Keep the idle workers busy while the population breeds
+    dispatchJobs();
+    if (isWorking() == false) 
+    {
+        this->m_requestsSinceFlush = 0;
+    }
+}
+
+template <class T>
+void EvaluatorFarmDispatcher<T>::cancel()
+{
+    EvaluatorFileDispatcher<T>::cancel();
+    m_jobs.clear();
+    
+    // The results of the running jobs will be ignored
+    for (auto& worker: m_workers) 
+    {
+        worker->job.objects.clear();
+    }
+}
+
+template class EvaluatorFarmDispatcher<Group>;
+template class EvaluatorFarmDispatcher<Individual>;
+
+}
+}
@@ -0,0 +1,210 @@
+/***********************************************************************\
+|                                                                       |
+| EvaluatorFarmDispatcher.h                                             |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file EvaluatorFarmDispatcher.h
+ * Evaluation on remote ugp3-worker processes, connected over TCP.
+ */
+
+#ifndef HEADER_UGP3_CORE_EVALUATORFARMDISPATCHER
+#define HEADER_UGP3_CORE_EVALUATORFARMDISPATCHER
+
+#include <EvaluatorFileDispatcher.h>
+#include "Socket.h"
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ugp3 {
+namespace core {
+
+/**
+ * Messages exchanged by the farm and the workers. Each one is sent as a
+ * Socket message: keyword, numeric id and payload.
+ *  - HELLO (worker): first message, the payload is the name of the worker
+ *    and, on the second line, the token of the farm;
+ *  - SETUP (farm): the payload lists, one per line, the evaluator script,
+ *    the fitness file, the time limit per candidate in milliseconds, the
+ *    heartbeat interval in milliseconds and whether to remove the input files;
+ *  - JOB (farm): the files of a batch of candidates, see packFiles();
+ *  - HEARTBEAT (worker): sent periodically, also while evaluating;
+ *  - RESULT (worker): the content of the fitness file for the job id;
+ *  - TIMEOUT (worker): the evaluator exceeded the time limit;
+ *  - FAILURE (worker): the evaluation failed, the payload is the reason.
+ * A worker that sends anything else before a HELLO with the right token is
+ * dropped.
+ */
+class FarmProtocol
+{
+public:
+    static const std::string HELLO;
+    static const std::string SETUP;
+    static const std::string JOB;
+    static const std::string HEARTBEAT;
+    static const std::string RESULT;
+    static const std::string TIMEOUT;
+    static const std::string FAILURE;
+    
+    /**
+     * A worker silent for this many heartbeat intervals is lost.
+     */
+    static const unsigned int HEARTBEATS_BEFORE_LOSS = 3;
+    
+    /**
+     * Encode the command-line arguments of the evaluator and the content
+     * of the given files: the arguments on the first line, then the name,
+     * the size and the bytes of each file.
+     * @throws Exception if a file cannot be read.
+     */
+    static std::string packFiles(const std::string& arguments, const std::vector<std::string>& files);
+    
+    /**
+     * Decode a payload created by packFiles(), writing the files.
+     * @param files Set to the names of the files written
+     * @return The command-line arguments of the evaluator.
+     */
+    static std::string unpackFiles(const std::string& payload, std::vector<std::string>& files);
+};
+
+/**
+ * Sends the candidates to the ugp3-worker processes that connect to the
+ * port of the farm. Each job is a batch of up to concurrentEvaluations
+ * candidates, evaluated by a single run of the evaluator script on the
+ * worker; workers get one job at a time. The jobs of lost or failing
+ * workers are given to other workers, timeouts are handled as in the file
+ * dispatcher.
+ */
+template <class T>
+class EvaluatorFarmDispatcher : public EvaluatorFileDispatcher<T>
+{
+private:
+    struct Job
+    {
+        unsigned long id;
+        std::vector<T*> objects;
+        // Runs killed for exceeding the time limit
+        unsigned int retries;
+        // Workers lost while evaluating this job
+        unsigned int losses;
+    };
+    
+    struct Worker
+    {
+        std::unique_ptr<Socket> socket;
+        std::string name;
+        bool busy;
+        // Meaningful only when busy; no objects if the job was cancelled
+        Job job;
+        std::chrono::steady_clock::time_point started;
+        std::chrono::steady_clock::time_point lastSeen;
+    };
+    
+    /**
+     * A job that loses this many workers is considered the cause.
+     */
+    static const unsigned int MAX_LOSSES = 3;
+    
+    /**
+     * Interval between the reports while no worker is connected.
+     */
+    static const std::chrono::seconds WAIT_REPORT_INTERVAL;
+    
+    Socket m_server;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::deque<Job> m_jobs;
+    // Process ids, -1 once the worker has exited
+    std::vector<int> m_localWorkers;
+    // Since when work is waiting and no worker is connected, if it is
+    std::chrono::steady_clock::time_point m_waitingSince;
+    std::chrono::steady_clock::time_point m_lastWaitReport;
+    unsigned long m_nextJobId;
+    unsigned long m_completedJobs;
+    
+    /**
+     * Open the port and start the local workers, the first time only.
+     */
+    void start();
+    
+    /**
+     * Split the pending evaluations in jobs.
+     */
+    void createJobs();
+    
+    /**
+     * Send the queued jobs to the idle workers.
+     */
+    void dispatchJobs();
+    
+    /**
+     * Wait for messages and connections for at most the given time, then
+     * handle them and drop the workers that stopped sending heartbeats.
+     */
+    void poll(std::chrono::milliseconds timeout);
+    
+    /**
+     * @param reason Set when the worker must be dropped
+     * @return False if the worker must be dropped; its job, if any, is
+     * still assigned to it.
+     */
+    bool handleMessage(Worker& worker, const std::string& keyword, unsigned long id, const std::string& payload, std::string& reason);
+    void dropWorker(std::size_t index, const std::string& reason);
+    
+    /**
+     * Called while waiting for jobs: reports the periods without workers,
+     * and the local workers that exited.
+     * @throws Exception if no worker has been connected for the wait
+     * timeout of the evaluator.
+     */
+    void checkWorkers();
+    void handleTimeout(Job& job);
+    
+    /**
+     * @return True while some jobs are queued or being evaluated.
+     */
+    bool isWorking() const;
+    std::size_t countRemaining() const;
+    
+public:
+    EvaluatorFarmDispatcher(EvaluatorCommon< T >& evaluator);
+    virtual ~EvaluatorFarmDispatcher();
+    
+    virtual void flush(std::function<void(double)>& showProgress);
+    
+    /**
+     * Returns as soon as a job has been completed.
+     */
+    virtual void flushSome();
+    virtual void cancel();
+    virtual bool supportsRacing() const { return false; }
+};
+
+}
+}
+
+#endif // HEADER_UGP3_CORE_EVALUATORFARMDISPATCHER
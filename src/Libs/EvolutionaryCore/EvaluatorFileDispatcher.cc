@@ -44,6 +44,7 @@
 #include "File.h"
 #include "Debug.h"
 #include "Environment.h"
+#include "Process.h"
 
 using namespace std;
 
@@ -83,16 +84,45 @@ void EvaluatorFileDispatcher<T>::flush(std::function<void(double)>& showProgress
             objects.push_back(m_pendingEvaluations.front());
             m_pendingEvaluations.pop();
         }
-        runScript(objects);
+        evaluateWithTimeout(objects);
         objects.clear();
     }
     showProgress(1);
     m_requestsSinceFlush = 0;
 }
 
+template <class T>
+void EvaluatorFileDispatcher<T>::flushSome()
+{
+    unsigned int concurrentEvaluations = EvaluatorDispatcher<T>::getEvaluator().getConcurrentEvaluations();
+    std::vector<T*> objects;
+    objects.reserve(concurrentEvaluations);
+
+    while (!m_pendingEvaluations.empty() && objects.size() < concurrentEvaluations) 
+    {
+        objects.push_back(m_pendingEvaluations.front());
+        m_pendingEvaluations.pop();
+    }
+    if (!objects.empty()) 
+    {
+        evaluateWithTimeout(objects);
+    }
+    if (m_pendingEvaluations.empty()) 
+    {
+        m_requestsSinceFlush = 0;
+    }
+}
 
 template <class T>
-void EvaluatorFileDispatcher<T>::retrieveEvaluations(const vector<T*>& evaluatedCandidates)
+void EvaluatorFileDispatcher<T>::cancel()
+{
+    std::queue<T*>().swap(m_pendingEvaluations);
+    m_requestsSinceFlush = 0;
+}
+
+
+template <class T>
+void EvaluatorFileDispatcher<T>::retrieveEvaluations(const vector<T*>& evaluatedCandidates, bool final)
 {
     _STACK;
     
@@ -112,6 +142,20 @@ void EvaluatorFileDispatcher<T>::retrieveEvaluations(const vector<T*>& evaluated
     }
     
     LOG_DEBUG << "Loading fitness evaluation results from file \"" << outputFile << "\"..." << ends;
+    parseEvaluations(fitnessFile, evaluatedCandidates, final);
+    fitnessFile.close();
+    
+    if (File::remove(outputFile) == false) 
+    {
+        LOG_WARNING << "Could not delete file \"" << outputFile << "\"" << ends;
+    }
+}
+
+template <class T>
+void EvaluatorFileDispatcher<T>::parseEvaluations(istream& fitnessFile, const vector<T*>& evaluatedCandidates, bool final)
+{
+    _STACK;
+    
     for (unsigned int i = 0; i < evaluatedCandidates.size(); i++) 
     {
         if (fitnessFile.eof() == true) 
@@ -165,21 +209,159 @@ void EvaluatorFileDispatcher<T>::retrieveEvaluations(const vector<T*>& evaluated
         }
     }
     
-    fitnessFile.close();
+    if (final == false) 
+    {
+        return;
+    }
+    for (auto candidate: evaluatedCandidates) 
+    {
+        EvaluatorDispatcher<T>::getEvaluator().cacheFitness(EvaluatorDispatcher<T>::getEvaluator().getCacheKey(*candidate), candidate->getRawFitness());
+    }
+}
+
+template <class T>
+bool EvaluatorFileDispatcher<T>::runStages(const vector<T*>& evaluatedCandidates)
+{
+    EvaluatorCommon<T>& evaluator = EvaluatorDispatcher<T>::getEvaluator();
+    const unsigned int stages = evaluator.getEvaluationStages();
     
-    if (File::remove(outputFile) == false) 
+    // The population does not change while the batch is evaluated
+    const CandidateSolution* rival = nullptr;
+    if (stages > 1) 
     {
-        LOG_WARNING << "Could not delete file \"" << outputFile << "\"" << ends;
+        rival = evaluatedCandidates.front()->getPopulation().getRacingRival(*evaluatedCandidates.front());
     }
     
-    for (auto candidate: evaluatedCandidates) 
+    vector<T*> racing(evaluatedCandidates);
+    for (unsigned int stage = 1; stage < stages; ++stage) 
     {
-        EvaluatorDispatcher<T>::getEvaluator().cacheFitness(candidate->getNormalizedPhenotype(), candidate->getRawFitness());
+        if (runScript(racing, stage, stages) == false) 
+        {
+            return false;
+        }
+        if (rival == nullptr) 
+        {
+            continue;
+        }
+        
+        vector<T*> survivors;
+        for (T* candidate: racing) 
+        {
+            if (candidate->getPopulation().cannotSurvive(*rival, candidate->getRawFitness().getValues()) == false) 
+            {
+                survivors.push_back(candidate);
+                continue;
+            }
+            
+            // The bound is not a measure: the candidate gets the lowest
+            // fitness, shared only with its clones of this generation
+            vector<double> values(candidate->getRawFitness().getValues().size(), 0.0);
+            candidate->getRawFitness().setValues(values);
+            candidate->getRawFitness().setDescription("racedOutAtStage" + Convert::toString(stage));
+            candidate->setRacedOutStage(stage);
+            evaluator.cacheRacedOut(evaluator.getCacheKey(*candidate), candidate->getRawFitness(), stage);
+            LOG_VERBOSE << TypeName<T>::name << " " << *candidate << " cannot beat " << *rival
+            << " and leaves the race at stage " << stage << " of " << stages << ends;
+        }
+        evaluator.countRacedOut(stage, racing.size() - survivors.size());
+        
+        racing.swap(survivors);
+        if (racing.empty()) 
+        {
+            return true;
+        }
     }
+    
+    return runScript(racing, stages, stages);
 }
 
 template <class T>
-void EvaluatorFileDispatcher<T>::runScript(const vector<T*>& evaluatedCandidates)
+void EvaluatorFileDispatcher<T>::evaluateWithTimeout(const vector<T*>& evaluatedCandidates)
+{
+    EvaluatorCommon<T>& evaluator = EvaluatorDispatcher<T>::getEvaluator();
+    
+    if (runStages(evaluatedCandidates)) 
+    {
+        return;
+    }
+    evaluator.countTimeouts(1, 0);
+    
+    // The candidates that left the race before the failure are settled
+    vector<T*> unsettled;
+    for (T* candidate: evaluatedCandidates) 
+    {
+        if (candidate->isRacedOut() == false) 
+        {
+            unsettled.push_back(candidate);
+        }
+    }
+    if (unsettled.empty()) 
+    {
+        return;
+    }
+    
+    if (unsettled.size() > 1) 
+    {
+        LOG_VERBOSE << "Evaluating the " << unsettled.size() << " " << TypeName<T>::name
+        << "s of the batch one at a time to isolate the failure" << ends;
+        for (T* candidate: unsettled) 
+        {
+            evaluateWithTimeout(vector<T*>(1, candidate));
+        }
+        return;
+    }
+    
+    for (unsigned int retry = 0; retry < evaluator.getTimeoutRetries(); ++retry) 
+    {
+        LOG_VERBOSE << "Evaluating " << TypeName<T>::name << " " << *unsettled.front()
+        << " again (retry " << retry + 1 << " of " << evaluator.getTimeoutRetries() << ")" << ends;
+        if (runStages(unsettled) || unsettled.front()->isRacedOut()) 
+        {
+            return;
+        }
+        evaluator.countTimeouts(1, 0);
+    }
+    
+    assignTimeoutPenalty(*unsettled.front());
+}
+
+template <class T>
+void EvaluatorFileDispatcher<T>::assignTimeoutPenalty(T& candidate)
+{
+    EvaluatorCommon<T>& evaluator = EvaluatorDispatcher<T>::getEvaluator();
+    
+    vector<double> values(candidate.getPopulation().getParameters().getFitnessParametersCount(), evaluator.getTimeoutPenalty());
+    candidate.getRawFitness().setValues(values);
+    candidate.getRawFitness().setDescription("timeout");
+    
+    LOG_WARNING << "The evaluation of " << TypeName<T>::name << " " << candidate
+    << " exceeded the time limit, assigning the penalty fitness " << candidate.getRawFitness() << ends;
+    
+    // Caching the penalty spares the evaluator from running the same code again
+    evaluator.cacheFitness(evaluator.getCacheKey(candidate), candidate.getRawFitness());
+    evaluator.countTimeouts(0, 1);
+}
+
+template <class T>
+void EvaluatorFileDispatcher<T>::writeCode(T& candidate, const string& fileName, vector<string>& inputFiles)
+{
+    candidate.toCode(fileName, &inputFiles);
+}
+
+template <>
+void EvaluatorFileDispatcher<Group>::writeCode(Group& group, const string& fileName, vector<string>& inputFiles)
+{
+    // Member files are shared between groups and outlive the evaluation
+    if (GroupFitnessEvaluator* evaluator = dynamic_cast<GroupFitnessEvaluator*>(&getEvaluator())) {
+        group.toCode(fileName, evaluator->getMemberFiles(), evaluator->getInputFile());
+        inputFiles.push_back(fileName);
+    } else {
+        group.toCode(fileName, &inputFiles);
+    }
+}
+
+template <class T>
+bool EvaluatorFileDispatcher<T>::runScript(const vector<T*>& evaluatedCandidates, unsigned int stage, unsigned int stages)
 {
     string scriptCommandline = "";
     vector<string> inputFiles;
@@ -198,7 +380,7 @@ void EvaluatorFileDispatcher<T>::runScript(const vector<T*>& evaluatedCandidates
         const string& fileName = File::formatToName(EvaluatorDispatcher<T>::getEvaluator().getInputFile(), candidate->getId());
         
         // generate the code from the individual
-        candidate->toCode(fileName, &inputFiles);
+        writeCode(*candidate, fileName, inputFiles);
         
         // add the file name as a paremeter of the command line
         scriptCommandline = scriptCommandline + fileName + " ";
@@ -213,6 +395,8 @@ void EvaluatorFileDispatcher<T>::runScript(const vector<T*>& evaluatedCandidates
     // set environment
     SETENV("UGP3_OFFSPRING", scriptCommandline.c_str());
     SETENV("UGP3_FITNESS_FILE", EvaluatorDispatcher<T>::getEvaluator().getOutputFile());
+    SETENV("UGP3_STAGE", Convert::toString(stage));
+    SETENV("UGP3_STAGES", Convert::toString(stages));
     
     scriptCommandline = EvaluatorDispatcher<T>::getEvaluator().getScriptFile() + " " + scriptCommandline;
     LOG_DEBUG << "Executing command \"" << scriptCommandline << "\" ... "<< ends;
@@ -229,8 +413,18 @@ void EvaluatorFileDispatcher<T>::runScript(const vector<T*>& evaluatedCandidates
 }
 */
     
-    // call the evaluator
-    int returnValue = system(scriptCommandline.c_str());
+    // call the evaluator, within the time limit (if any)
+    bool timedOut = false;
+    const std::chrono::milliseconds timeout = EvaluatorDispatcher<T>::getEvaluator().getEvaluationTimeout() * evaluatedCandidates.size();
+    const auto start = std::chrono::steady_clock::now();
+    int returnValue = Process::run(scriptCommandline, timeout, timedOut);
+    
+    // each candidate of the batch gets its share of the time (retries add up)
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (T* candidate: evaluatedCandidates) 
+    {
+        candidate->setEvaluationTime(candidate->getEvaluationTime() + elapsed / evaluatedCandidates.size());
+    }
 
     LOG_DEBUG
     << "The process \"" <<  EvaluatorDispatcher<T>::getEvaluator().getScriptFile()
@@ -241,12 +435,21 @@ void EvaluatorFileDispatcher<T>::runScript(const vector<T*>& evaluatedCandidates
     while( returnValue != 0 )
     {
 	LOG_DEBUG << "Re-running the evaluation process..." << ends;
-	returnValue = system(scriptCommandline.c_str());
+	returnValue = Process::run(scriptCommandline, timeout, timedOut);
     }
 #endif
 
-    // retrieve the results
-    retrieveEvaluations(evaluatedCandidates);
+    if (timedOut) 
+    {
+        LOG_WARNING << "The process \"" << EvaluatorDispatcher<T>::getEvaluator().getScriptFile()
+        << "\" has been killed after exceeding the time limit of " << timeout.count() / 1000.0 << " seconds" << ends;
+        File::remove(EvaluatorDispatcher<T>::getEvaluator().getOutputFile());
+    } 
+    else 
+    {
+        // retrieve the results
+        retrieveEvaluations(evaluatedCandidates, stage == stages);
+    }
     
     // clean up the temporary files
     File::remove("individualsToEvaluate.txt");
@@ -255,6 +458,8 @@ void EvaluatorFileDispatcher<T>::runScript(const vector<T*>& evaluatedCandidates
             File::remove(file);
         }
     }
+    
+    return !timedOut;
 }
 
 template class EvaluatorFileDispatcher<Group>;
@@ -34,8 +34,10 @@
 
 #include <EvaluatorDispatcher.h>
 
+#include <istream>
 #include <queue>
 #include <string>
+#include <vector>
 
 namespace ugp3 {
 namespace core {
@@ -46,8 +48,47 @@ class EvaluatorFileDispatcher : public EvaluatorDispatcher<T>
 protected:
     std::queue<T*> m_pendingEvaluations;
     
-    void runScript(const std::vector<T*>& objects);
-    void retrieveEvaluations(const std::vector<T*>& objects);
+    /**
+     * Run the evaluator on the given candidates and read back their fitness.
+     * The stage is exported to the evaluator as UGP3_STAGE and UGP3_STAGES.
+     * @return False if the evaluator has been killed for exceeding the time limit.
+     */
+    bool runScript(const std::vector<T*>& objects, unsigned int stage, unsigned int stages);
+    
+    /**
+     * Read the fitness of the given candidates. Only final fitness values
+     * are cached.
+     */
+    void retrieveEvaluations(const std::vector<T*>& objects, bool final);
+    
+    /**
+     * Parse the fitness of the given candidates from the output of the
+     * evaluator, one line per candidate, optionally followed by "#stop".
+     */
+    void parseEvaluations(std::istream& output, const std::vector<T*>& objects, bool final);
+    
+    /**
+     * Racing evaluation: run all the stages of the evaluation, dropping
+     * after each stage the candidates that cannot survive even with the
+     * best fitness that they can still reach.
+     * @return False if a stage exceeded the time limit.
+     */
+    bool runStages(const std::vector<T*>& objects);
+    
+    /**
+     * Write the code of the given candidate to the given file, and add
+     * the temporary files to remove after the evaluation to the vector.
+     */
+    void writeCode(T& object, const std::string& fileName, std::vector<std::string>& inputFiles);
+    
+    /**
+     * Evaluate the given candidates, handling timeouts: a batch that times out
+     * is split and its candidates are evaluated one at a time, so that a single
+     * hanging candidate does not penalize the others. A single candidate is
+     * retried getTimeoutRetries() times before receiving the penalty fitness.
+     */
+    void evaluateWithTimeout(const std::vector<T*>& objects);
+    void assignTimeoutPenalty(T& object);
     
     void setEnvironmentVariable(const std::string& name, const std::string& value);
     
@@ -62,6 +103,13 @@ public:
     
     virtual void evaluate(T& object);
     virtual void flush(std::function<void(double)>& showProgress);
+    
+    /**
+     * Evaluates a single batch of (at most) concurrentEvaluations requests.
+     */
+    virtual void flushSome();
+    virtual void cancel();
+    virtual bool supportsRacing() const { return true; }
 };
 
 }
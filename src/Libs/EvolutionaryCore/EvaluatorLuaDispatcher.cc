@@ -39,14 +39,19 @@
 #include "GroupPopulation.h"
 #include "GroupPopulationParameters.h"
 
+#include <algorithm>
+
 namespace ugp3 {
 namespace core {
     
 template <class T>
 EvaluatorLuaDispatcher<T>::EvaluatorLuaDispatcher(EvaluatorCommon< T >& evaluator)
-: EvaluatorDispatcher<T>(evaluator), m_workersToStop(0), m_requestsSinceFlush(0)
+: EvaluatorDispatcher<T>(evaluator), m_workersToStop(0), m_incremental(false)
+, m_requestsSinceFlush(0), m_completedSinceFlush(0), m_completedDuration(0)
 {
     setNumberOfWorkers(evaluator.getConcurrentEvaluations());
+    // All the workers load the same script
+    m_incremental = !m_workers.empty() && m_workers.front()->hasIncrementalFunction();
 }
 
 template <class T>
@@ -110,12 +115,17 @@ void EvaluatorLuaDispatcher<T>::evaluate(T& object)
     std::lock_guard<std::mutex> lock(m_mutex);
     m_requestsSinceFlush++;
     
-    m_pending.insert(new EvaluatorLuaDispatcher<T>::Wrapper(object));
+    EvaluatorLuaDispatcher<T>::Wrapper* w = new EvaluatorLuaDispatcher<T>::Wrapper(object);
+    if (m_incremental) {
+        // The evaluator owns the cache mutex while requesting evaluations
+        w->findParentState(EvaluatorDispatcher<T>::getEvaluator());
+    }
+    m_pending.insert(w);
     m_newCondition.notify_one();
 }
 
 template <class T>
-void EvaluatorLuaDispatcher<T>::done(EvaluatorLuaDispatcher<T>::Wrapper* w)
+void EvaluatorLuaDispatcher<T>::done(std::vector<EvaluatorLuaDispatcher<T>::Wrapper*>& requests)
 {
     /* 
      * Get the cache mutex first to avoid deadlocks (since most of the time
@@ -125,13 +135,70 @@ void EvaluatorLuaDispatcher<T>::done(EvaluatorLuaDispatcher<T>::Wrapper* w)
     std::lock_guard<std::mutex> lock(EvaluatorDispatcher<T>::getEvaluator().getCacheMutex());
     std::lock_guard<std::mutex> lock2(m_mutex);
     
-    m_inProgress.erase(w);
-    w->writeFitnessToWrappedObject();
-    EvaluatorDispatcher<T>::getEvaluator().cacheFitness(w->m_code, w->m_object.getRawFitness());
-    delete w;
+    const auto now = std::chrono::steady_clock::now();
+    for (auto w: requests) {
+        m_inProgress.erase(w);
+        if (w->m_abandoned) {
+            // Its twin has already been evaluated
+            delete w;
+            continue;
+        }
+        if (w->m_twin) {
+            w->m_twin->m_abandoned = true;
+            w->m_twin->m_twin = nullptr;
+        }
+        m_completedDuration += now - w->m_started;
+        ++m_completedSinceFlush;
+        
+        w->writeFitnessToWrappedObject();
+        // the candidates of a batch share the time of the call
+        w->m_object.setEvaluationTime(std::chrono::duration<double>(now - w->m_started).count() / requests.size());
+        EvaluatorDispatcher<T>::getEvaluator().cacheFitness(w->m_code, w->m_object.getRawFitness(), w->m_state);
+        EvaluatorDispatcher<T>::getEvaluator().countTimeouts(w->m_timeouts, w->m_penalized ? 1 : 0);
+        if (w->m_hasParentState && !w->m_penalized) {
+            EvaluatorDispatcher<T>::getEvaluator().countIncremental();
+        }
+        delete w;
+    }
+    requests.clear();
     
-    if (m_pending.size() == 0 && m_inProgress.size() == 0) {
-        m_lastCondition.notify_one();
+    // Wake up the main thread, either in flush() or in flushSome()
+    m_lastCondition.notify_one();
+}
+
+template <class T>
+void EvaluatorLuaDispatcher<T>::fail(std::vector<EvaluatorLuaDispatcher<T>::Wrapper*>& requests, std::exception_ptr error)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    for (auto w: requests) {
+        m_inProgress.erase(w);
+        if (w->m_twin) {
+            w->m_twin->m_twin = nullptr;
+        }
+        delete w;
+    }
+    requests.clear();
+    if (!m_error) {
+        m_error = error;
+    }
+    m_lastCondition.notify_one();
+}
+
+template <class T>
+void EvaluatorLuaDispatcher<T>::checkError() const
+{
+    if (!m_error) {
+        return;
+    }
+    try {
+        std::rethrow_exception(m_error);
+    } catch (const std::exception& e) {
+        LOG_ERROR << "A Lua evaluator worker failed: " << e.what() << std::ends;
+        throw;
+    } catch (...) {
+        LOG_ERROR << "A Lua evaluator worker failed" << std::ends;
+        throw;
     }
 }
 
@@ -140,36 +207,130 @@ void EvaluatorLuaDispatcher<T>::flush(std::function<void(double)>& showProgress)
 {
     std::unique_lock<std::mutex> lock(m_mutex);
     
-    // Wait until both sets are empty
+    // Wait until no result is expected
     while (!m_lastCondition.wait_for(lock, std::chrono::milliseconds(1000), [&] {
-        return m_pending.size() == 0 && m_inProgress.size() == 0;
+        return isIdle() || m_error;
     })) {
-        showProgress((double)(m_requestsSinceFlush - m_pending.size() - m_inProgress.size()) / m_requestsSinceFlush);
+        showProgress((double)m_completedSinceFlush / m_requestsSinceFlush);
     }
+    checkError();
     showProgress(1);
     m_requestsSinceFlush = 0;
+    m_completedSinceFlush = 0;
+    m_completedDuration = std::chrono::steady_clock::duration(0);
 }
 
 template <class T>
-typename EvaluatorLuaDispatcher<T>::Wrapper* EvaluatorLuaDispatcher<T>::popPendingRequest()
+void EvaluatorLuaDispatcher<T>::flushSome()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
     
-    m_newCondition.wait(lock, [&] {
-        return m_pending.size() > 0 || m_workersToStop > 0;
+    /*
+     * A request completed just before this call would not be noticed,
+     * hence the timeout: the caller checks its candidates again anyway.
+     */
+    const unsigned int completed = m_completedSinceFlush;
+    m_lastCondition.wait_for(lock, std::chrono::milliseconds(100), [&] {
+        return m_completedSinceFlush > completed || isIdle() || m_error;
     });
+    checkError();
+}
+
+template <class T>
+bool EvaluatorLuaDispatcher<T>::isIdle() const
+{
+    return m_pending.empty() && std::all_of(m_inProgress.begin(), m_inProgress.end(), [] (const Wrapper* w) {
+        return w->m_abandoned.load();
+    });
+}
+
+template <class T>
+void EvaluatorLuaDispatcher<T>::cancel()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    for (auto w: m_pending) {
+        delete w;
+    }
+    m_pending.clear();
+    // The workers will drop the results of the requests in progress
+    for (auto w: m_inProgress) {
+        w->m_abandoned = true;
+    }
+    m_lastCondition.notify_one();
+}
+
+template <class T>
+bool EvaluatorLuaDispatcher<T>::popPendingRequests(std::vector<EvaluatorLuaDispatcher<T>::Wrapper*>& requests, unsigned int maxRequests)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    auto ready = [&] {
+        return m_pending.size() > 0 || m_workersToStop > 0;
+    };
+    if (EvaluatorDispatcher<T>::getEvaluator().getSpeculativeRedispatch()) {
+        // Wake up from time to time to look for stragglers
+        while (!m_newCondition.wait_for(lock, std::chrono::milliseconds(100), ready)) {
+            if (EvaluatorLuaDispatcher<T>::Wrapper* twin = duplicateStraggler()) {
+                m_inProgress.insert(twin);
+                requests.push_back(twin);
+                return true;
+            }
+        }
+    } else {
+        m_newCondition.wait(lock, ready);
+    }
     
     if (m_workersToStop > 0) {
         --m_workersToStop;
         m_newCondition.notify_one();
+        return false;
+    }
+    
+    const auto now = std::chrono::steady_clock::now();
+    while (m_pending.size() > 0 && requests.size() < maxRequests) {
+        EvaluatorLuaDispatcher<T>::Wrapper* w = *m_pending.begin();
+        m_pending.erase(m_pending.begin());
+        w->m_started = now;
+        m_inProgress.insert(w);
+        requests.push_back(w);
+    }
+    
+    // Leave the remaining requests to the other workers
+    if (m_pending.size() > 0) {
+        m_newCondition.notify_one();
+    }
+    
+    return true;
+}
+
+template <class T>
+typename EvaluatorLuaDispatcher<T>::Wrapper* EvaluatorLuaDispatcher<T>::duplicateStraggler()
+{
+    if (m_completedSinceFlush == 0) {
         return nullptr;
     }
     
-    EvaluatorLuaDispatcher<T>::Wrapper* w = *m_pending.begin();
-    m_pending.erase(m_pending.begin());
-    m_inProgress.insert(w);
+    const auto now = std::chrono::steady_clock::now();
+    const auto threshold = 2 * m_completedDuration / m_completedSinceFlush;
+    EvaluatorLuaDispatcher<T>::Wrapper* slowest = nullptr;
+    for (auto w: m_inProgress) {
+        if (w->m_twin || w->m_abandoned) {
+            continue;
+        }
+        if (now - w->m_started > threshold && (!slowest || w->m_started < slowest->m_started)) {
+            slowest = w;
+        }
+    }
+    if (!slowest) {
+        return nullptr;
+    }
     
-    return w;
+    EvaluatorLuaDispatcher<T>::Wrapper* twin = new EvaluatorLuaDispatcher<T>::Wrapper(*slowest);
+    twin->m_started = now;
+    twin->m_twin = slowest;
+    slowest->m_twin = twin;
+    return twin;
 }
 
 template <>
@@ -179,6 +340,8 @@ EvaluatorLuaDispatcher<Group>::Wrapper::Wrapper(Group& group)
 #ifdef TEST_OPERATOR_SELECTION
 , m_lineage(group, LINEAGE_RECURSION_DEPTH)
 #endif
+, m_timeouts(0), m_penalized(false), m_twin(nullptr), m_abandoned(false)
+, m_incremental(false), m_hasParentState(false)
 {
     m_fitnessSize = group.getPopulation().getParameters().getIndividualFitnessParametersCount();
     for (auto ind: group.getIndividuals()) {
@@ -192,15 +355,101 @@ EvaluatorLuaDispatcher<Group>::Wrapper::Wrapper(Group& group)
 template <>
 EvaluatorLuaDispatcher<Individual>::Wrapper::Wrapper(Individual& ind)
 : m_object(ind)
-, m_code(ind.getNormalizedPhenotype())
+, m_code(ind.getCacheKey().empty() ? ind.getNormalizedPhenotype() : ind.getCacheKey())
 #ifdef TEST_OPERATOR_SELECTION
 , m_lineage(ind, LINEAGE_RECURSION_DEPTH)
 #endif
+, m_timeouts(0), m_penalized(false), m_twin(nullptr), m_abandoned(false)
+, m_incremental(false), m_hasParentState(false)
 {
     m_fitnessSize = ind.getPopulation().getParameters().getFitnessParametersCount();
     m_individualCodes.push_back(ind.getExternalRepresentation());
 }
         
+template <class T>
+EvaluatorLuaDispatcher<T>::Wrapper::Wrapper(const Wrapper& original)
+: m_object(original.m_object)
+, m_code(original.m_code)
+, m_fitnessSize(original.m_fitnessSize)
+, m_individualCodes(original.m_individualCodes)
+#ifdef TEST_OPERATOR_SELECTION
+, m_lineage(original.m_lineage)
+, m_individualLineages(original.m_individualLineages)
+#endif
+, m_timeouts(0), m_penalized(false), m_twin(nullptr), m_abandoned(false)
+, m_incremental(original.m_incremental), m_hasParentState(original.m_hasParentState)
+, m_parentState(original.m_parentState), m_addedCodes(original.m_addedCodes)
+, m_removedCodes(original.m_removedCodes)
+{
+}
+
+template <>
+void EvaluatorLuaDispatcher<Group>::Wrapper::findParentState(EvaluatorCommon<Group>& evaluator)
+{
+    m_incremental = true;
+    
+    /*
+     * Groups created by mutation differ from their parent by a few members:
+     * pick the parent with the smallest difference, if it is worth it.
+     */
+    const std::vector<GEIndividual*>& members = m_object.getIndividuals();
+    std::size_t bestDistance = members.size();
+    const Group* bestParent = nullptr;
+    const std::string* bestState = nullptr;
+    for (const Group* parent: m_object.getLineage().getParents()) {
+        const std::string* state = evaluator.findCachedState(evaluator.getCacheKey(*parent));
+        if (!state) {
+            continue;
+        }
+        const std::vector<GEIndividual*>& parentMembers = parent->getIndividuals();
+        std::size_t distance = 0;
+        for (auto ind: members) {
+            distance += std::count(parentMembers.begin(), parentMembers.end(), ind) == 0;
+        }
+        for (auto ind: parentMembers) {
+            distance += std::count(members.begin(), members.end(), ind) == 0;
+        }
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            bestParent = parent;
+            bestState = state;
+        }
+    }
+    if (!bestParent) {
+        // Evaluated from scratch: all the members are new
+        m_addedCodes = m_individualCodes;
+        return;
+    }
+    
+    m_hasParentState = true;
+    m_parentState = *bestState;
+    const std::vector<GEIndividual*>& parentMembers = bestParent->getIndividuals();
+    for (auto ind: members) {
+        if (std::count(parentMembers.begin(), parentMembers.end(), ind) == 0) {
+            m_addedCodes.push_back(ind->getExternalRepresentation());
+        }
+    }
+    for (auto ind: parentMembers) {
+        if (std::count(members.begin(), members.end(), ind) == 0) {
+            m_removedCodes.push_back(ind->getExternalRepresentation());
+        }
+    }
+}
+
+template <>
+void EvaluatorLuaDispatcher<Individual>::Wrapper::findParentState(EvaluatorCommon<Individual>& evaluator)
+{
+    // Individuals are always evaluated from scratch
+}
+
+template <class T>
+void EvaluatorLuaDispatcher<T>::Wrapper::assignTimeoutPenalty(double penalty)
+{
+    m_fitness.assign(m_fitnessSize, penalty);
+    m_fitnessDescription = "timeout";
+    m_penalized = true;
+}
+
 template <class T>
 void EvaluatorLuaDispatcher<T>::Wrapper::writeFitnessToWrappedObject()
 {
@@ -41,10 +41,13 @@
 #include "Hashable.h"
 
 #include <list>
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <condition_variable>
+#include <exception>
 
 namespace ugp3 {
 namespace core {
@@ -83,8 +86,50 @@ public:
         std::vector<LineageWrapper<Individual>> m_individualLineages;
 #endif
         
+        /**
+         * Timeout handling: number of attempts that exceeded the time limit,
+         * and whether the penalty fitness has been assigned.
+         */
+        unsigned int m_timeouts;
+        bool m_penalized;
+        
+        /**
+         * Speculative re-dispatch: a straggler and its duplicate point to
+         * each other. When the first of the two is done, the other one is
+         * abandoned: its worker aborts it and its result is discarded.
+         */
+        std::chrono::steady_clock::time_point m_started;
+        Wrapper* m_twin;
+        std::atomic<bool> m_abandoned;
+        
+        /**
+         * Incremental evaluation: when set, the script function
+         * `evaluate_incremental' is called with the state handle of a
+         * parent (if one is cached) and the codes of the members added and
+         * removed with respect to that parent. The returned state handle
+         * is stored in the cache along with the fitness.
+         */
+        bool m_incremental;
+        bool m_hasParentState;
+        std::string m_parentState;
+        std::vector<std::string> m_addedCodes;
+        std::vector<std::string> m_removedCodes;
+        std::string m_state;
+        
         Wrapper(T& object);
+        /**
+         * Build a duplicate of a request in progress. Only the code to evaluate
+         * is copied, the results are left empty.
+         */
+        explicit Wrapper(const Wrapper& original);
         void writeFitnessToWrappedObject();
+        void assignTimeoutPenalty(double penalty);
+        /**
+         * Look in the cache for the state of the parent that differs the
+         * least from the wrapped object. Only groups can be evaluated
+         * incrementally. The caller must own the cache mutex.
+         */
+        void findParentState(EvaluatorCommon<T>& evaluator);
     };
     
 private:
@@ -100,6 +145,11 @@ private:
      */
     unsigned int m_workersToStop;
     
+    /**
+     * True iff the script defines an `evaluate_incremental' function.
+     */
+    bool m_incremental;
+    
     /**
      * Adjust the number of workers.
      */
@@ -133,7 +183,8 @@ private: // synchronized data
     std::condition_variable m_newCondition;
     
     /**
-     * A condition used to signal that there are no more requests.
+     * A condition used to signal that a request has been completed
+     * (or that there are no more requests).
      */
     std::condition_variable m_lastCondition;
     
@@ -141,27 +192,70 @@ private: // synchronized data
      * Progress
      */
     unsigned int m_requestsSinceFlush;
+    unsigned int m_completedSinceFlush;
+    
+    /**
+     * Duration of the evaluations completed since the last flush, used
+     * to spot stragglers for speculative re-dispatch.
+     */
+    std::chrono::steady_clock::duration m_completedDuration;
+    
+    /**
+     * Error raised by a worker, rethrown by the main thread in flush()
+     * and flushSome().
+     */
+    std::exception_ptr m_error;
+    
+    /**
+     * Logs and rethrows the error of a worker, if any. Before calling
+     * this function, the class must own the mutex.
+     */
+    void checkError() const;
+    
+    /**
+     * True when no request is pending and all the requests in progress
+     * have been abandoned: nobody waits for their results, even if their
+     * workers are still running them. Before calling this function, the
+     * class must own the mutex.
+     */
+    bool isIdle() const;
+    
+    /**
+     * When no request is pending, find the slowest request in progress
+     * that runs for more than twice the average evaluation time and
+     * duplicate it. Before calling this function, the class must own the mutex.
+     * @return The duplicate or nullptr.
+     */
+    Wrapper* duplicateStraggler();
 public:
     EvaluatorLuaDispatcher(EvaluatorCommon<T>& evaluator);
     virtual ~EvaluatorLuaDispatcher();
     
     virtual void evaluate(T& object);
     virtual void flush(std::function<void(double)>& showProgress);
+    virtual void flushSome();
+    virtual void cancel();
     
 public: // Interface for use by workers
     /**
-     * Pops between one and getConcurrentEvaluations() requests from pending,
-     * moves them to in progress, returns them in a vector.
+     * Pops between one and maxRequests requests from pending,
+     * moves them to in progress, returns them in the given vector.
      * Will wait for at least one new request to come before returning.
-     * @return Wrapper* One object to evaluate or nullptr if the worker should stop.
+     * @return False if the worker should stop (the vector is then empty).
      */
-    Wrapper* popPendingRequest();
+    bool popPendingRequests(std::vector<Wrapper*>& requests, unsigned int maxRequests);
     
     /**
      * Removes the objects from the in progress set and, if caching is used,
-     * inserts the computed fitnesses in the cache.
+     * inserts the computed fitnesses in the cache. The vector is cleared.
+     */
+    void done(std::vector<Wrapper*>& requests);
+    
+    /**
+     * Drops the requests of a worker that stopped because of an error,
+     * and keeps the error for the main thread. The vector is cleared.
      */
-    void done(Wrapper* w);
+    void fail(std::vector<Wrapper*>& requests, std::exception_ptr error);
 };
 }
 }
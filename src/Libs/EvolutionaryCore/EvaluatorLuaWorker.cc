@@ -38,15 +38,20 @@
 #include "Info.h"
 
 #include <exception>
+#include <algorithm>
 
 #include <lua.hpp>
 
 namespace ugp3 {
 namespace core {
     
+template <class T>
+thread_local EvaluatorLuaWorker<T>* EvaluatorLuaWorker<T>::s_running = nullptr;
+
 template <class T>
 EvaluatorLuaWorker<T>::EvaluatorLuaWorker(EvaluatorLuaDispatcher< T >& dispatcher)
 : m_dispatcher(dispatcher), m_working(false), m_uniqueId(Evaluator::getNewWorkerId())
+, m_interrupted(false)
 {
     std::stringstream concat;
     concat << "Worker" << m_uniqueId;
@@ -87,6 +92,22 @@ EvaluatorLuaWorker<T>::EvaluatorLuaWorker(EvaluatorLuaDispatcher< T >& dispatche
         fprintf(stderr, "Failed to run script: %s\n", lua_tostring(m_L, -1));
         exit(1);
     }
+    
+    /* The batch entry point is optional */
+    lua_getglobal(m_L, "evaluate_batch");
+    m_hasBatchFunction = lua_isfunction(m_L, -1);
+    lua_pop(m_L, 1);
+    
+    /* And so is the incremental one */
+    lua_getglobal(m_L, "evaluate_incremental");
+    m_hasIncrementalFunction = lua_isfunction(m_L, -1);
+    lua_pop(m_L, 1);
+    
+    /* Check the time limit every thousand instructions */
+    const Evaluator& evaluator = m_dispatcher.getEvaluator();
+    if (evaluator.getEvaluationTimeout().count() != 0 || evaluator.getSpeculativeRedispatch()) {
+        lua_sethook(m_L, &EvaluatorLuaWorker<T>::interruptHook, LUA_MASKCOUNT, 1000);
+    }
 }
 
 template <class T>
@@ -108,10 +129,27 @@ void EvaluatorLuaWorker<T>::start()
             m_thread.join();
         }
         m_thread = std::thread([&] {
-            while (Wrapper* w = m_dispatcher.popPendingRequest()) {
-                updateGeneration();
-                evaluate(w);
-                m_dispatcher.done(w);
+            s_running = this;
+            std::vector<Wrapper*> batch;
+            const unsigned int batchSize = m_dispatcher.getEvaluator().getBatchEvaluations();
+            const bool useBatchFunction = m_hasBatchFunction && batchSize > 1;
+            try {
+                while (m_dispatcher.popPendingRequests(batch, batchSize)) {
+                    updateGeneration();
+                    // Incremental requests carry a state that batches cannot return
+                    if (useBatchFunction && !batch.front()->m_incremental) {
+                        evaluateBatch(batch);
+                    } else {
+                        for (Wrapper* w: batch) {
+                            evaluateWithTimeout(w);
+                        }
+                    }
+                    m_dispatcher.done(batch);
+                }
+            } catch (...) {
+                // The Lua state may be inconsistent: the worker stops and
+                // the main thread reports the error
+                m_dispatcher.fail(batch, std::current_exception());
             }
             {
                 std::lock_guard<std::mutex> lock(m_mutex);
@@ -129,19 +167,159 @@ bool EvaluatorLuaWorker<T>::isWorking()
 }
 
 template <class T>
-void EvaluatorLuaWorker<T>::evaluate(Wrapper* w)
+void EvaluatorLuaWorker<T>::interruptHook(lua_State* L, lua_Debug* ar)
+{
+    EvaluatorLuaWorker<T>* worker = s_running;
+    if (!worker) {
+        return;
+    }
+    if (worker->isAbandoned() || std::chrono::steady_clock::now() > worker->m_deadline) {
+        worker->m_interrupted = true;
+        luaL_error(L, "evaluation interrupted");
+    }
+}
+
+template <class T>
+bool EvaluatorLuaWorker<T>::isAbandoned() const
+{
+    // The dispatcher sets the flags while the call runs: a batch goes on
+    // as long as one of its results is still wanted
+    return !m_current.empty() && std::all_of(m_current.begin(), m_current.end(), [] (const Wrapper* w) {
+        return w->m_abandoned.load();
+    });
+}
+
+template <class T>
+void EvaluatorLuaWorker<T>::startClock(const std::vector<const Wrapper*>& current)
 {
+    const std::chrono::milliseconds timeout = m_dispatcher.getEvaluator().getEvaluationTimeout();
+    m_interrupted = false;
+    m_current = current;
+    if (timeout.count() != 0) {
+        m_deadline = std::chrono::steady_clock::now() + timeout * current.size();
+    } else {
+        m_deadline = std::chrono::steady_clock::time_point::max();
+    }
+}
+
+template <class T>
+bool EvaluatorLuaWorker<T>::evaluate(Wrapper* w)
+{
+    if (w->m_incremental) {
+        return evaluateIncremental(w);
+    }
+    
+    startClock(std::vector<const Wrapper*>(1, w));
     pushEvaluateFunction();
     pushIndividualsTable(w);
 #ifdef TEST_OPERATOR_SELECTION
     pushLineages(w);
     // Two parameters, the second is the lineage table
-    callFunction(2, w->m_fitnessSize + 1);
+    if (!callFunction(2, w->m_fitnessSize + 1)) {
+        return false;
+    }
 #else
-    callFunction(1, w->m_fitnessSize + 1);
+    if (!callFunction(1, w->m_fitnessSize + 1)) {
+        return false;
+    }
 #endif
     retrieveGroupFitnessValues(w);
     checkStopRequest();
+    return true;
+}
+
+template <class T>
+bool EvaluatorLuaWorker<T>::evaluateIncremental(Wrapper* w)
+{
+    /*
+     * evaluate_incremental(individuals, state, added, removed) returns the
+     * fitness values, an optional description and the new state handle.
+     * The state is nil when no parent state is available, and then all the
+     * members are in `added'.
+     */
+    startClock(std::vector<const Wrapper*>(1, w));
+    lua_getglobal(m_L, "evaluate_incremental");
+    pushIndividualsTable(w);
+    if (w->m_hasParentState) {
+        lua_pushlstring(m_L, w->m_parentState.data(), w->m_parentState.size());
+    } else {
+        lua_pushnil(m_L);
+    }
+    pushStringTable(w->m_addedCodes);
+    pushStringTable(w->m_removedCodes);
+#ifdef TEST_OPERATOR_SELECTION
+    pushLineages(w);
+    if (!callFunction(5, w->m_fitnessSize + 2)) {
+        return false;
+    }
+#else
+    if (!callFunction(4, w->m_fitnessSize + 2)) {
+        return false;
+    }
+#endif
+    w->m_state.clear();
+    if (lua_isstring(m_L, -1)) {
+        std::size_t length = 0;
+        const char* state = lua_tolstring(m_L, -1, &length);
+        w->m_state.assign(state, length);
+    }
+    lua_pop(m_L, 1);
+    retrieveGroupFitnessValues(w);
+    checkStopRequest();
+    return true;
+}
+
+template <class T>
+void EvaluatorLuaWorker<T>::evaluateWithTimeout(Wrapper* w)
+{
+    const Evaluator& evaluator = m_dispatcher.getEvaluator();
+    for (unsigned int attempt = 0; attempt <= evaluator.getTimeoutRetries(); ++attempt) {
+        if (evaluate(w) || w->m_abandoned) {
+            return;
+        }
+        ++w->m_timeouts;
+    }
+    w->assignTimeoutPenalty(evaluator.getTimeoutPenalty());
+}
+
+template <class T>
+void EvaluatorLuaWorker<T>::evaluateBatch(const std::vector<Wrapper*>& batch)
+{
+    startClock(std::vector<const Wrapper*>(batch.begin(), batch.end()));
+    lua_getglobal(m_L, "evaluate_batch");
+    
+    /* One entry per candidate, each one being the table given to `evaluate' */
+    lua_newtable(m_L);
+    for (unsigned int i = 0; i < batch.size(); ++i) {
+        lua_pushnumber(m_L, i + 1);
+        pushIndividualsTable(batch[i]);
+        lua_rawset(m_L, -3);
+    }
+#ifdef TEST_OPERATOR_SELECTION
+    lua_newtable(m_L);
+    for (unsigned int i = 0; i < batch.size(); ++i) {
+        lua_pushnumber(m_L, i + 1);
+        pushLineages(batch[i]);
+        lua_rawset(m_L, -3);
+    }
+    bool completed = callFunction(2, 1);
+#else
+    bool completed = callFunction(1, 1);
+#endif
+    if (!completed) {
+        if (isAbandoned()) {
+            return;
+        }
+        // The killed run is accounted to the first candidate of the batch,
+        // then each candidate is evaluated alone to isolate the failure.
+        ++batch.front()->m_timeouts;
+        for (Wrapper* w: batch) {
+            evaluateWithTimeout(w);
+        }
+        return;
+    }
+    retrieveBatchFitnessValues(batch);
+    checkStopRequest();
 }
 
 template <class T>
@@ -183,6 +361,17 @@ void EvaluatorLuaWorker<T>::pushIndividualsTable(Wrapper* w)
     }
 }
 
+template <class T>
+void EvaluatorLuaWorker<T>::pushStringTable(const std::vector<std::string>& values)
+{
+    lua_newtable(m_L);
+    for (unsigned int i = 0; i < values.size(); i++) {
+        lua_pushnumber(m_L, i + 1);
+        lua_pushstring(m_L, values[i].c_str());
+        lua_rawset(m_L, -3);
+    }
+}
+
 template <class T>
 int EvaluatorLuaWorker<T>::pushFitnessTable()
 {
@@ -193,14 +382,20 @@ int EvaluatorLuaWorker<T>::pushFitnessTable()
 }
     
 template <class T>
-void EvaluatorLuaWorker<T>::callFunction(int nArgs, int nResults)
+bool EvaluatorLuaWorker<T>::callFunction(int nArgs, int nResults)
 {
     int result = lua_pcall(m_L, nArgs, nResults, 0);
     if (result) {
+        if (m_interrupted) {
+            // Pop the error message
+            lua_pop(m_L, 1);
+            return false;
+        }
         // TODO handle errors better, but not with ugp Log, because it is not synchronized
         std::cout << "Failed to run script: " << lua_tostring(m_L, -1) << std::endl;
         exit(1);
     }
+    return true;
 }
 
 template <class T>
@@ -230,6 +425,43 @@ void EvaluatorLuaWorker<T>::retrieveGroupFitnessValues(Wrapper* w)
     lua_pop(m_L, w->m_fitnessSize + 1);
 }
 
+template <class T>
+void EvaluatorLuaWorker<T>::retrieveBatchFitnessValues(const std::vector<Wrapper*>& batch)
+{
+    /**
+     * `evaluate_batch' returns one table with an entry per candidate, in
+     * the same order as the candidates were given. Each entry is a table
+     * { fitness1, ..., fitnessN, [description] }.
+     */
+    if (!lua_istable(m_L, -1)) {
+        throw Exception("The Lua function `evaluate_batch' must return a table.", LOCATION);
+    }
+    
+    for (unsigned int i = 0; i < batch.size(); ++i) {
+        Wrapper* w = batch[i];
+        lua_rawgeti(m_L, -1, i + 1);
+        if (!lua_istable(m_L, -1)) {
+            throw Exception("The Lua function `evaluate_batch' returned no fitness for candidate "
+                + Convert::toString(i + 1) + ".", LOCATION);
+        }
+        for (unsigned int f = 1; f <= w->m_fitnessSize; ++f) {
+            lua_rawgeti(m_L, -1, f);
+            if (!lua_isnumber(m_L, -1)) {
+                throw Exception("The Lua function `evaluate_batch' returned a wrong fitness component for candidate "
+                    + Convert::toString(i + 1) + ".", LOCATION);
+            }
+            w->m_fitness.push_back(lua_tonumber(m_L, -1));
+            lua_pop(m_L, 1);
+        }
+        lua_rawgeti(m_L, -1, w->m_fitnessSize + 1);
+        if (lua_isstring(m_L, -1)) {
+            w->m_fitnessDescription = lua_tostring(m_L, -1);
+        }
+        lua_pop(m_L, 2);
+    }
+    lua_pop(m_L, 1);
+}
+
 template <class T>
 void EvaluatorLuaWorker<T>::checkStopRequest()
 {
@@ -36,9 +36,11 @@
 
 #include "EvaluatorLuaDispatcher.h"
 
+#include <chrono>
 #include <thread>
 
 struct lua_State;
+struct lua_Debug;
 
 namespace ugp3 {
 namespace core {
@@ -65,16 +67,48 @@ class EvaluatorLuaWorker
     lua_State* m_L;
     
     int m_environmentRef;
+    
+    /**
+     * True iff the script defines an `evaluate_batch' function.
+     */
+    bool m_hasBatchFunction;
+    
+    /**
+     * True iff the script defines an `evaluate_incremental' function.
+     */
+    bool m_hasIncrementalFunction;
+    
+    typedef typename EvaluatorLuaDispatcher<T>::Wrapper Wrapper;
+    
+    /**
+     * State checked by the Lua count hook to abort evaluations that exceed
+     * the time limit, or whose requests have all been abandoned (their
+     * twins have already been evaluated, or the evaluations were cancelled).
+     * NOTE LuaJIT does not call hooks from compiled code, so a tight loop
+     * that has been compiled cannot be interrupted.
+     */
+    std::chrono::steady_clock::time_point m_deadline;
+    std::vector<const Wrapper*> m_current;
+    bool m_interrupted;
+    static thread_local EvaluatorLuaWorker<T>* s_running;
+    static void interruptHook(lua_State* L, lua_Debug* ar);
+    void startClock(const std::vector<const Wrapper*>& current);
+    bool isAbandoned() const;
+    
     void createEnvironment();
     void updateGeneration();
     
-    typedef typename EvaluatorLuaDispatcher<T>::Wrapper Wrapper;
-    void evaluate(Wrapper* w);
+    bool evaluate(Wrapper* w);
+    bool evaluateIncremental(Wrapper* w);
+    void evaluateWithTimeout(Wrapper* w);
+    void evaluateBatch(const std::vector<Wrapper*>& batch);
     void pushEvaluateFunction();
     void pushIndividualsTable(Wrapper* w);
+    void pushStringTable(const std::vector<std::string>& values);
     int pushFitnessTable();
-    void callFunction(int nArgs, int nResults);
+    bool callFunction(int nArgs, int nResults);
     void retrieveGroupFitnessValues(Wrapper* w);
+    void retrieveBatchFitnessValues(const std::vector<Wrapper*>& batch);
     void checkStopRequest();
     
 #ifdef TEST_OPERATOR_SELECTION
@@ -88,7 +122,7 @@ public:
     virtual ~EvaluatorLuaWorker();
     
     /**
-     * Start performing evaluations, until popEvaluationRequest() returns nullptr.
+     * Start performing evaluations, until popPendingRequests() returns false.
      */
     void start();
     
@@ -96,6 +130,11 @@ public:
      * @return true iff the worker is working.
      */
     bool isWorking();
+    
+    /**
+     * @return true iff the script supports incremental evaluation.
+     */
+    bool hasIncrementalFunction() const { return m_hasIncrementalFunction; }
 };
 
 }
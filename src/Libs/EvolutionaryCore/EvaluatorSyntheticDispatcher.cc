@@ -0,0 +1,157 @@
+/***********************************************************************\
+|                                                                       |
+| EvaluatorSyntheticDispatcher.cc                                       |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file EvaluatorSyntheticDispatcher.cc
+ *
+ */
+
+#include "EvaluatorSyntheticDispatcher.h"
+#include "Individual.h"
+#include "EvaluatorCommon.h"
+#include "Population.h"
+#include "Group.h"
+#include "GroupPopulation.h"
+
+#include "Log.h"
+#include "Debug.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+namespace ugp3 {
+namespace core {
+
+template <class T>
+EvaluatorSyntheticDispatcher<T>::EvaluatorSyntheticDispatcher(EvaluatorCommon< T >& evaluator)
+: EvaluatorDispatcher<T>(evaluator), m_requestsSinceFlush(0)
+{
+}
+
+template <class T>
+EvaluatorSyntheticDispatcher<T>::~EvaluatorSyntheticDispatcher()
+{
+}
+
+template <class T>
+void EvaluatorSyntheticDispatcher<T>::evaluate(T& object)
+{
+    m_requestsSinceFlush++;
+    m_pendingEvaluations.push(&object);
+}
+
+template <class T>
+void EvaluatorSyntheticDispatcher<T>::flush(std::function<void(double)>& showProgress)
+{
+    while (!m_pendingEvaluations.empty()) 
+    {
+        showProgress((double)(m_requestsSinceFlush - m_pendingEvaluations.size()) / m_requestsSinceFlush);
+        computeFitness(*m_pendingEvaluations.front());
+        m_pendingEvaluations.pop();
+    }
+    showProgress(1);
+    m_requestsSinceFlush = 0;
+}
+
+template <class T>
+void EvaluatorSyntheticDispatcher<T>::flushSome()
+{
+    if (!m_pendingEvaluations.empty()) 
+    {
+        computeFitness(*m_pendingEvaluations.front());
+        m_pendingEvaluations.pop();
+    }
+    if (m_pendingEvaluations.empty()) 
+    {
+        m_requestsSinceFlush = 0;
+    }
+}
+
+template <class T>
+void EvaluatorSyntheticDispatcher<T>::cancel()
+{
+    std::queue<T*>().swap(m_pendingEvaluations);
+    m_requestsSinceFlush = 0;
+}
+
+template <class T>
+void EvaluatorSyntheticDispatcher<T>::computeFitness(T& candidate)
+{
+    _STACK;
+    
+    using namespace std::chrono;
+    
+    EvaluatorCommon<T>& evaluator = EvaluatorDispatcher<T>::getEvaluator();
+    const steady_clock::time_point start = steady_clock::now();
+    
+    // FNV-1a, so that the fitness does not depend on the standard library
+    const string& phenotype = candidate.getNormalizedPhenotype();
+    uint64_t hash = 14695981039346656037ULL ^ evaluator.getSyntheticSeed();
+    for (unsigned char c: phenotype) 
+    {
+        hash = (hash ^ c) * 1099511628211ULL;
+    }
+    
+    // one splitmix64 output for each component, scaled to [0, 1)
+    vector<double> values(candidate.getPopulation().getParameters().getFitnessParametersCount());
+    for (unsigned int f = 0; f < values.size(); f++) 
+    {
+        uint64_t z = hash + (f + 1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z = z ^ (z >> 31);
+        values[f] = (z >> 11) * (1.0 / 9007199254740992.0);
+    }
+    
+    // busy wait: a sleep would be too coarse for costs of a few microseconds
+    const microseconds cost = evaluator.getSyntheticCost();
+    if (cost.count() > 0) 
+    {
+        while (steady_clock::now() - start < cost) 
+        {
+        }
+    }
+    
+    candidate.getRawFitness().setValues(values);
+    candidate.setEvaluationTime(duration<double>(steady_clock::now() - start).count());
+    
+    LOG_VERBOSE << "New fitness for " << TypeName<T>::name << " "
+    << candidate << " is " << candidate.getRawFitness() << ends;
+    
+#ifdef UGP3_USE_LUA
+    std::lock_guard<std::mutex> lock(evaluator.getCacheMutex());
+#endif
+    evaluator.cacheFitness(evaluator.getCacheKey(candidate), candidate.getRawFitness());
+}
+
+template class EvaluatorSyntheticDispatcher<Group>;
+template class EvaluatorSyntheticDispatcher<Individual>;
+
+}
+}
@@ -0,0 +1,80 @@
+/***********************************************************************\
+|                                                                       |
+| EvaluatorSyntheticDispatcher.h                                        |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file EvaluatorSyntheticDispatcher.h
+ * In-process evaluator used to measure the overhead of the engine.
+ */
+
+#ifndef HEADER_UGP3_CORE_EVALUATORSYNTHETICDISPATCHER
+#define HEADER_UGP3_CORE_EVALUATORSYNTHETICDISPATCHER
+
+#include <EvaluatorDispatcher.h>
+
+#include <queue>
+
+namespace ugp3 {
+namespace core {
+
+/**
+ * Assigns to each candidate a fitness derived from the hash of its
+ * normalized phenotype, without running any external program.
+ * Each component is a deterministic pseudo-random value in [0, 1):
+ * clones get the same fitness, and the same run can be repeated
+ * with the same seed. The evaluation of each candidate can be made
+ * to last getSyntheticCost(), to simulate a real evaluator.
+ */
+template <class T>
+class EvaluatorSyntheticDispatcher : public EvaluatorDispatcher<T>
+{
+protected:
+    std::queue<T*> m_pendingEvaluations;
+    
+    /**
+     * Progress
+     */
+    unsigned int m_requestsSinceFlush;
+    
+    void computeFitness(T& object);
+    
+public:
+    EvaluatorSyntheticDispatcher(EvaluatorCommon< T >& evaluator);
+    virtual ~EvaluatorSyntheticDispatcher();
+    
+    virtual void evaluate(T& object);
+    virtual void flush(std::function<void(double)>& showProgress);
+    
+    /**
+     * Evaluates a single request.
+     */
+    virtual void flushSome();
+    virtual void cancel();
+};
+
+}
+}
+
+#endif // HEADER_UGP3_CORE_EVALUATORSYNTHETICDISPATCHER
@@ -27,6 +27,7 @@
 #include "ugp3_config.h"
 #include "SignalHandling.h"
 #include "EvolutionaryCore.h"
+#include "Process.h"
 using namespace std;
 using namespace std::chrono;
 using namespace ugp3::core;
@@ -44,6 +45,7 @@ EvolutionaryAlgorithm::EvolutionaryAlgorithm()
 {
     // save real start time (the one below is just to count the time spent running exclusively ugp3, not regarding the evaluator)
     m_startTime = steady_clock::now();
+    m_profiler.setName("EvolutionaryAlgorithm");
 }
 
 EvolutionaryAlgorithm::~EvolutionaryAlgorithm()  
@@ -181,6 +183,10 @@ void EvolutionaryAlgorithm::run()
     deferSignals = true;
     ugp3::SigIntMessage = "SIGINT Caught... Stopping at the end of current generation.";
     signal(SIGINT, signalHandler);
+#ifdef SIGUSR1
+    ugp3::MemoryDumpRequested = 0;
+    signal(SIGUSR1, memoryDumpHandler);
+#endif
 
 #ifdef NDEBUG
     try
@@ -226,13 +232,16 @@ void EvolutionaryAlgorithm::run()
             
 #ifdef NDEBUG
             // Check that we spent more than half our time evaluating candidates
-            // In debug mode this is not true because the debug asserts are slow
+            // In debug mode this is not true because the debug asserts are slow,
+            // and the synthetic evaluator is meant to take almost no time
             seconds evaluationTimeAllPops(0);
+            bool synthetic = false;
             for (Population* pop: populations) 
 	    {
                 evaluationTimeAllPops += pop->getParameters().getEvaluator().getTotalTime();
+                synthetic = synthetic || pop->getParameters().getEvaluator().isSynthetic();
             }
-            if (evaluationTimeAllPops < getElapsedTime() / 2) 
+            if (synthetic == false && evaluationTimeAllPops < getElapsedTime() / 2) 
 	    {
                 LOG_WARNING << "We are spending more time in the evolutionary "
                 "algorithm than in the evaluator." << std::ends;
@@ -311,6 +320,15 @@ void EvolutionaryAlgorithm::run()
                 checkStopCondition = true;
             }
 
+            // the memory report is requested with SIGUSR1 or with another special file, removed once served
+            string memoryFileName = "UGP3_MEMORY_REQUESTED";
+            if (ugp3::MemoryDumpRequested || stat(memoryFileName.c_str(), &stFileInfo) == 0)
+            {
+                this->logMemoryUsage();
+                remove(memoryFileName.c_str());
+                ugp3::MemoryDumpRequested = 0;
+            }
+
 
         } // end while checkStopCondition == false
 
@@ -345,6 +363,8 @@ void EvolutionaryAlgorithm::run()
 
 void EvolutionaryAlgorithm::saveDumpState() const
 {
+    Profiler::Scope scope(m_profiler, Profiler::DUMP_STATE);
+    
     if (this->outputPathName != "")
     {
         LOG_VERBOSE << "Saving algorithm dump state..." << ends;
@@ -408,6 +428,15 @@ void EvolutionaryAlgorithm::openStatisticsStream()
 		{
 		    this->populations[i]->dumpStatisticsHeader(statisticsStream);
 		}
+		if (Profiler::getEnabled())
+		{
+		    this->statisticsStream << ",Time" << Profiler::getPhaseName(Profiler::DUMP_STATE)
+		                           << ",Time" << Profiler::getPhaseName(Profiler::STATISTICS);
+		}
+		if (MemoryUsage::getEnabled())
+		{
+		    this->statisticsStream << ",HeapAllocated,HeapReserved,PeakMemory";
+		}
 		this->statisticsStream << endl;
 	    }
         }
@@ -416,6 +445,12 @@ void EvolutionaryAlgorithm::openStatisticsStream()
 
 void EvolutionaryAlgorithm::writeStatisticsStream()
 {
+            // The state is saved after the statistics: report the times of the previous generation
+            double dumpStateTime = m_profiler.getMilliseconds(Profiler::DUMP_STATE);
+            double statisticsTime = m_profiler.getMilliseconds(Profiler::STATISTICS);
+            m_profiler.reset();
+            Profiler::Scope scope(m_profiler, Profiler::STATISTICS);
+            
             if (this->statisticsPathName != "")
             {
                 statisticsStream << this->algorithmStep << "," << m_elapsedTimeThisRun.count();
@@ -428,6 +463,33 @@ void EvolutionaryAlgorithm::writeStatisticsStream()
                         population.dumpStatistics(statisticsStream);
                     }
                 }
+                if (Profiler::getEnabled())
+                {
+                    statisticsStream << "," << dumpStateTime << "," << statisticsTime;
+                }
+                if (MemoryUsage::getEnabled())
+                {
+                    // bytes, peak resident size in kilobytes
+                    size_t allocated, reserved;
+                    MemoryUsage::getAllocatorStatistics(allocated, reserved);
+                    statisticsStream << "," << allocated << "," << reserved << "," << Process::getPeakMemory();
+                }
                 statisticsStream << std::endl;
             }
 }
+
+void EvolutionaryAlgorithm::logMemoryUsage() const
+{
+    for (unsigned int i = 0; i < this->populations.size(); i++)
+    {
+        this->populations[i]->updateMemoryUsage().log(this->populations[i]->getName());
+    }
+    
+    size_t allocated, reserved;
+    if (MemoryUsage::getAllocatorStatistics(allocated, reserved))
+    {
+        LOG_INFO << "Allocator: " << allocated / 1024 << " KiB allocated, "
+            << reserved / 1024 << " KiB reserved" << ends;
+    }
+    LOG_INFO << "Peak resident memory: " << Process::getPeakMemory() << " KiB" << ends;
+}
@@ -44,6 +44,7 @@
 #include "Constraints.h"
 #include "IMigrator.h"
 #include "Operator.h"
+#include "Profiler.h"
 
 namespace ugp3
 {
@@ -64,6 +65,8 @@ namespace ugp3
             chrono::seconds m_elapsedTimeThisRun;
             chrono::seconds m_elapsedTimePreviousRuns;
             chrono::time_point<chrono::steady_clock> m_startTime;
+            // Time spent saving the state and the statistics (the populations have their own)
+            mutable Profiler m_profiler;
 
         protected:
             std::vector<Population*> populations;
@@ -101,6 +104,8 @@ namespace ugp3
             void fromFile(const std::string& xmlFileName, bool discardFitness);
             void save(const std::string& xmlFile) const;
             void saveDumpState() const;
+            /** Logs a detailed report of the memory retained by each population and by the allocator. */
+            void logMemoryUsage() const;
 
             /** It starts the evolutionary algorithm.
                 It's a loop containing a call to the method "EvolutionaryAlgorithm::step".*/
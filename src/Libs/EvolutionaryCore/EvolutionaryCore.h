@@ -87,12 +87,19 @@
 #include "GroupPopulationParameters.h"
 #include "GroupPopulation.h"
 #include "IMigrator.h"
+#include "MemberFileStore.h"
 #include "CandidateSelection.h"
+#include "Canonicalizer.h"
 #include "MOFitness.h"
 #include "MOIndividual.h"
 #include "MOPopulation.h"
 #include "OperatorToolbox.h"
 #include "Population.h"
+#include "Profiler.h"
+#include "Genealogy.h"
+#include "MemoryUsage.h"
+#include "SelectionKeys.h"
+#include "Surrogate.h"
 #include "RankingSelection.h"
 #include "TournamentSelection.h"
 
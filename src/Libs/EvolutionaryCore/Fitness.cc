@@ -127,6 +127,7 @@ const std::string Fitness::toString() const
 {
     std::ostringstream stream;
     
+    describe();
     stream << "{";
     
     for(unsigned int i = 0; i < this->m_values.size(); i++)
@@ -46,9 +46,16 @@ namespace ugp3
         {
         protected: // Fields
             std::vector<double> m_values;
-            std::string description;
+            // Built on demand by describe() in subclasses
+            mutable std::string description;
             bool isValid;
             void clear();
+            
+            /**
+             * Subclasses that build their description lazily must bring
+             * `description' up to date here. Called before it is read.
+             */
+            virtual void describe() const {}
 
         public:
             static const std::string XML_NAME;
@@ -67,7 +74,7 @@ namespace ugp3
         public: // Methods
             bool getIsValid() const;
             void invalidate();
-            const std::string getDescription() const;
+            const std::string& getDescription() const;
             virtual void setDescription(const std::string& description);
             virtual void setValues(const std::vector<double>& values);
             const std::vector<double>& getValues() const;
@@ -95,8 +102,9 @@ namespace ugp3
             bool operator<=(const Fitness& fitness) const;
         };
 
-        inline const std::string Fitness::getDescription() const
+        inline const std::string& Fitness::getDescription() const
         {
+            describe();
             return this->description;
         }
 
@@ -97,6 +97,7 @@ void Fitness::writeXml(ostream& output) const
 
     if(this->isValid == true)
     {
+        describe();
         output << "<" << XML_NAME  << ">" << std::endl;
 
         output
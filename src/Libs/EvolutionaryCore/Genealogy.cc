@@ -0,0 +1,334 @@
+/***********************************************************************\
+|                                                                       |
+| Genealogy.cc                                                          |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#include "EvolutionaryCore.h"
+#include "Genealogy.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace ugp3::core;
+
+namespace {
+
+const char MAGIC[] = "UGP3GEN1";
+const std::size_t MAGIC_SIZE = sizeof(MAGIC) - 1;
+
+const char TAG_SESSION = 'S';
+const char TAG_OPERATOR = 'O';
+const char TAG_CANDIDATE = 'C';
+
+// Set in the kind byte of the candidates dropped by a racing evaluation
+const uint8_t RACED_OUT = 0x80;
+
+template <class T>
+void writeValue(ostream& output, T value)
+{
+    output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <class T>
+T readValue(istream& input)
+{
+    T value;
+    if (!input.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+        throw ugp3::Exception("Truncated genealogy record.", LOCATION);
+    }
+    return value;
+}
+
+}
+
+std::ofstream Genealogy::s_output;
+std::vector<bool> Genealogy::s_writtenOperators;
+
+void Genealogy::open(const string& fileName)
+{
+    close();
+    
+    s_output.open(fileName.c_str(), ios::binary | ios::app);
+    if (!s_output.is_open()) {
+        throw Exception("Cannot open the genealogy file \"" + fileName + "\".", LOCATION);
+    }
+    if (s_output.tellp() == 0) {
+        s_output.write(MAGIC, MAGIC_SIZE);
+    }
+    
+    // Operator ids are only valid within a session
+    s_output.put(TAG_SESSION);
+    s_writtenOperators.clear();
+}
+
+void Genealogy::close()
+{
+    if (s_output.is_open()) {
+        s_output.close();
+    }
+}
+
+void Genealogy::writeOperator(unsigned int operatorId)
+{
+    const string& name = Lineage::getOperatorName(operatorId);
+    s_output.put(TAG_OPERATOR);
+    writeValue<uint32_t>(s_output, operatorId);
+    writeValue<uint32_t>(s_output, name.size());
+    s_output.write(name.data(), name.size());
+    
+    if (s_writtenOperators.size() <= operatorId) {
+        s_writtenOperators.resize(operatorId + 1, false);
+    }
+    s_writtenOperators[operatorId] = true;
+}
+
+void Genealogy::record(const CandidateSolution& candidate, unsigned int generation)
+{
+    Assert(isOpen());
+    
+    const Lineage& lineage = candidate.getLineage();
+    unsigned int operatorId = lineage.getOperatorId();
+    if (operatorId >= s_writtenOperators.size() || !s_writtenOperators[operatorId]) {
+        writeOperator(operatorId);
+    }
+    
+    // The placeholder fitness of a raced-out candidate is not recorded
+    const Fitness& fitness = candidate.getRawFitness();
+    const std::size_t fitnessCount = fitness.getIsValid() && !candidate.isRacedOut() ? fitness.getValues().size() : 0;
+    
+    uint8_t kind = dynamic_cast<const Group*>(&candidate) ? GROUP : INDIVIDUAL;
+    if (candidate.isRacedOut()) {
+        kind |= RACED_OUT;
+    }
+    
+    s_output.put(TAG_CANDIDATE);
+    writeValue<uint8_t>(s_output, kind);
+    writeValue<uint64_t>(s_output, candidate.getNumericId());
+    writeValue<uint32_t>(s_output, generation);
+    writeValue<uint32_t>(s_output, operatorId);
+    writeValue<uint32_t>(s_output, lineage.getParentIds().size());
+    writeValue<uint32_t>(s_output, fitnessCount);
+    for (auto parentId: lineage.getParentIds()) {
+        writeValue<uint64_t>(s_output, parentId);
+    }
+    for (std::size_t i = 0; i < fitnessCount; ++i) {
+        writeValue<double>(s_output, fitness.getValues()[i]);
+    }
+}
+
+Genealogy::Genealogy(const string& fileName)
+{
+    read(fileName);
+}
+
+void Genealogy::read(const string& fileName)
+{
+    ifstream input(fileName.c_str(), ios::binary);
+    if (!input.is_open()) {
+        throw Exception("Cannot open the genealogy file \"" + fileName + "\".", LOCATION);
+    }
+    
+    char magic[MAGIC_SIZE];
+    if (!input.read(magic, MAGIC_SIZE) || !equal(magic, magic + MAGIC_SIZE, MAGIC)) {
+        throw Exception("The file \"" + fileName + "\" is not a genealogy file.", LOCATION);
+    }
+    
+    // Operator ids of the current session, translated to indexes in m_operatorNames
+    vector<unsigned int> sessionOperators;
+    unordered_map<string, unsigned int> operatorIndexes;
+    
+    char tag;
+    while (input.get(tag)) {
+        if (tag == TAG_SESSION) {
+            sessionOperators.clear();
+        } else if (tag == TAG_OPERATOR) {
+            uint32_t id = readValue<uint32_t>(input);
+            uint32_t length = readValue<uint32_t>(input);
+            string name(length, '\0');
+            if (!input.read(&name[0], length)) {
+                throw Exception("Truncated genealogy record.", LOCATION);
+            }
+            
+            auto it = operatorIndexes.find(name);
+            if (it == operatorIndexes.end()) {
+                it = operatorIndexes.emplace(name, m_operatorNames.size()).first;
+                m_operatorNames.push_back(name);
+            }
+            if (sessionOperators.size() <= id) {
+                sessionOperators.resize(id + 1, numeric_limits<unsigned int>::max());
+            }
+            sessionOperators[id] = it->second;
+        } else if (tag == TAG_CANDIDATE) {
+            Record record;
+            uint8_t kind = readValue<uint8_t>(input);
+            record.racedOut = (kind & RACED_OUT) != 0;
+            kind &= ~RACED_OUT;
+            if (kind != INDIVIDUAL && kind != GROUP) {
+                throw Exception("Unknown kind of candidate in the genealogy file \"" + fileName + "\".", LOCATION);
+            }
+            record.kind = (Kind)kind;
+            record.id = readValue<uint64_t>(input);
+            record.generation = readValue<uint32_t>(input);
+            uint32_t operatorId = readValue<uint32_t>(input);
+            if (operatorId >= sessionOperators.size() 
+                || sessionOperators[operatorId] == numeric_limits<unsigned int>::max()) {
+                throw Exception("Undefined operator in the genealogy file \"" + fileName + "\".", LOCATION);
+            }
+            record.operatorId = sessionOperators[operatorId];
+            record.parents.resize(readValue<uint32_t>(input));
+            record.fitness.resize(readValue<uint32_t>(input));
+            for (auto& parent: record.parents) {
+                parent = readValue<uint64_t>(input);
+            }
+            for (auto& value: record.fitness) {
+                value = readValue<double>(input);
+            }
+            
+            m_index[record.kind][record.id] = m_records.size();
+            m_records.push_back(std::move(record));
+        } else {
+            throw Exception("Corrupted genealogy file \"" + fileName + "\".", LOCATION);
+        }
+    }
+}
+
+const Genealogy::Record* Genealogy::find(Kind kind, uint64_t id) const
+{
+    auto it = m_index[kind].find(id);
+    if (it == m_index[kind].end()) {
+        return nullptr;
+    }
+    return &m_records[it->second];
+}
+
+vector<const Genealogy::Record*> Genealogy::getAncestry(const Record& record, unsigned int levels) const
+{
+    vector<const Record*> ancestry;
+    unordered_map<uint64_t, bool> visited;
+    
+    // Breadth-first, one generation of ancestors at a time
+    vector<const Record*> current(1, &record);
+    for (unsigned int level = 0; !current.empty() && (levels == 0 || level < levels); ++level) {
+        vector<const Record*> next;
+        for (const Record* child: current) {
+            for (auto parentId: child->parents) {
+                const Record* parent = find(child->kind, parentId);
+                if (parent && visited.emplace(parentId, true).second) {
+                    next.push_back(parent);
+                }
+            }
+        }
+        ancestry.insert(ancestry.end(), next.begin(), next.end());
+        current.swap(next);
+    }
+    
+    return ancestry;
+}
+
+unsigned int Genealogy::getLineageDepth(const Record& record) const
+{
+    /*
+     * Parents are recorded before their children, so the depths of all the
+     * records are computed in a single pass over the file. Parents recorded
+     * later (only possible when ids were reused after a restart) are ignored.
+     */
+    if (m_depths.size() != m_records.size()) {
+        m_depths.assign(m_records.size(), 0);
+        for (std::size_t i = 0; i < m_records.size(); ++i) {
+            for (auto parentId: m_records[i].parents) {
+                const Record* parent = find(m_records[i].kind, parentId);
+                if (parent && parent < &m_records[i]) {
+                    m_depths[i] = max(m_depths[i], m_depths[parent - &m_records[0]] + 1);
+                }
+            }
+        }
+    }
+    
+    return m_depths[&record - &m_records[0]];
+}
+
+vector<Genealogy::ChainLink> Genealogy::getSuccessChain(const Record& record) const
+{
+    vector<ChainLink> chain;
+    unordered_map<const Record*, bool> visited;
+    
+    const Record* current = &record;
+    while (current && visited.emplace(current, true).second) {
+        const Record* fittest = nullptr;
+        bool improvement = !current->fitness.empty();
+        bool knownParent = false;
+        for (auto parentId: current->parents) {
+            const Record* parent = find(current->kind, parentId);
+            if (!parent || parent->fitness.empty()) {
+                continue;
+            }
+            knownParent = true;
+            if (!isBetter(current->fitness, parent->fitness)) {
+                improvement = false;
+            }
+            if (!fittest || isBetter(parent->fitness, fittest->fitness)) {
+                fittest = parent;
+            }
+        }
+        
+        chain.push_back(ChainLink{current, improvement && knownParent});
+        current = fittest;
+    }
+    
+    return chain;
+}
+
+vector<Genealogy::OperatorSuccess> Genealogy::getOperatorSuccess() const
+{
+    vector<OperatorSuccess> success(m_operatorNames.size());
+    for (const Record& record: m_records) {
+        OperatorSuccess& operatorSuccess = success[record.operatorId];
+        ++operatorSuccess.births;
+        
+        if (record.fitness.empty()) {
+            continue;
+        }
+        bool improvement = false;
+        for (auto parentId: record.parents) {
+            const Record* parent = find(record.kind, parentId);
+            if (!parent || parent->fitness.empty()) {
+                continue;
+            }
+            improvement = isBetter(record.fitness, parent->fitness);
+            if (!improvement) {
+                break;
+            }
+        }
+        if (improvement) {
+            ++operatorSuccess.improvements;
+        }
+    }
+    
+    return success;
+}
+
+bool Genealogy::isBetter(const vector<double>& a, const vector<double>& b)
+{
+    return lexicographical_compare(b.begin(), b.end(), a.begin(), a.end());
+}
@@ -0,0 +1,191 @@
+/***********************************************************************\
+|                                                                       |
+| Genealogy.h                                                           |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#ifndef HEADER_UGP3_CORE_GENEALOGY
+#define HEADER_UGP3_CORE_GENEALOGY
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ugp3 {
+namespace core {
+
+class CandidateSolution;
+
+/**
+ * Complete history of the candidates created during a run, kept on disk.
+ * 
+ * While the population only remembers the direct parents of its live
+ * candidates, the genealogy file receives one record for every candidate
+ * at the end of the generation that created it, once its fitness is known.
+ * The file is an append-only binary log: nothing is kept in memory for
+ * the candidates already written. A record holds the numeric id of the
+ * candidate, its kind, the generation, the id of the operator, the numeric
+ * ids of the parents and the raw fitness values.
+ * 
+ * Layout (host byte order): the magic string "UGP3GEN1", then a sequence of
+ * records, each starting with a tag byte.
+ *  - 'S' session: the file was (re)opened, operator ids are reset.
+ *  - 'O' operator: uint32 id, uint32 length, name.
+ *  - 'C' candidate: uint8 kind, uint64 id, uint32 generation, uint32 operator,
+ *        uint32 number of parents, uint32 number of fitness values,
+ *        uint64 parents[], double fitness[].
+ * The high bit of the kind is set for the candidates dropped by a racing
+ * evaluation, whose fitness values are not written.
+ * 
+ * The writer is static, like the trace of the Profiler. An instance of the
+ * class loads a file and answers queries about it.
+ */
+class Genealogy
+{
+public:
+    typedef enum {
+        INDIVIDUAL = 0,
+        GROUP = 1
+    } Kind;
+    
+    struct Record
+    {
+        Kind kind;
+        std::uint64_t id;
+        unsigned int generation;
+        // Index in getOperatorNames()
+        unsigned int operatorId;
+        std::vector<std::uint64_t> parents;
+        // Empty when the candidate was killed before being evaluated,
+        // or dropped by a racing evaluation
+        std::vector<double> fitness;
+        bool racedOut;
+    };
+    
+    /**
+     * Step of an operator success chain.
+     */
+    struct ChainLink
+    {
+        const Record* record;
+        // True when the candidate is better than all its known parents
+        bool improvement;
+    };
+    
+    /**
+     * Number of candidates created by an operator, and how many of them
+     * were better than all their known parents.
+     */
+    struct OperatorSuccess
+    {
+        unsigned long births = 0;
+        unsigned long improvements = 0;
+    };
+    
+private:
+    static std::ofstream s_output;
+    static std::vector<bool> s_writtenOperators;
+    
+    static void writeOperator(unsigned int operatorId);
+    
+    std::vector<std::string> m_operatorNames;
+    std::vector<Record> m_records;
+    // Most recent record of each id, by kind
+    std::unordered_map<std::uint64_t, std::size_t> m_index[2];
+    // Lineage depth of each record, computed on the first request
+    mutable std::vector<unsigned int> m_depths;
+    
+    void read(const std::string& fileName);
+    
+public:
+    /**
+     * Load all the records of the given file.
+     */
+    explicit Genealogy(const std::string& fileName);
+    
+    const std::vector<std::string>& getOperatorNames() const { return m_operatorNames; }
+    const std::vector<Record>& getRecords() const { return m_records; }
+    
+    /**
+     * @return The record of the candidate, or nullptr if it is not in the file
+     * (for example, the random candidates of the first generation).
+     * If an id was recorded more than once, as it happens when a run is
+     * restarted from an old state, the most recent record is returned.
+     */
+    const Record* find(Kind kind, std::uint64_t id) const;
+    
+    /**
+     * @return The known ancestors of the candidate, closest first, each one
+     * only once.
+     * @param levels Generations of ancestors to visit (0 = all of them).
+     */
+    std::vector<const Record*> getAncestry(const Record& record, unsigned int levels = 0) const;
+    
+    /**
+     * @return Length of the longest chain of known ancestors
+     * (0 = none of the parents of the candidate is in the file).
+     * @param record Must be one of the records of this genealogy.
+     */
+    unsigned int getLineageDepth(const Record& record) const;
+    
+    /**
+     * @return The path from the candidate to its oldest known ancestor that
+     * always follows the fittest parent, with the operator applied at each
+     * step and whether the step was an improvement.
+     */
+    std::vector<ChainLink> getSuccessChain(const Record& record) const;
+    
+    /**
+     * @return For each operator (same order as getOperatorNames()), the
+     * number of candidates it created and how many improved on their parents.
+     */
+    std::vector<OperatorSuccess> getOperatorSuccess() const;
+    
+    /**
+     * Fitness values are compared lexicographically: the first component
+     * is the most important, higher is better.
+     * @return True if a is strictly better than b.
+     */
+    static bool isBetter(const std::vector<double>& a, const std::vector<double>& b);
+    
+public:
+    /**
+     * Append the records of the new candidates to the given file until
+     * close() is called. The file is created if it does not exist.
+     */
+    static void open(const std::string& fileName);
+    static void close();
+    static bool isOpen() { return s_output.is_open(); }
+    
+    /**
+     * Append the record of a candidate created in the given generation.
+     */
+    static void record(const CandidateSolution& candidate, unsigned int generation);
+};
+
+}
+}
+
+#endif // HEADER_UGP3_CORE_GENEALOGY
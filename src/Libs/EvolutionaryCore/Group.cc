@@ -238,6 +238,29 @@ void Group::toCode(const string& fileName, vector< string >* outfiles) const
     file.close();
 }
 
+void Group::toCode(const string& fileName, MemberFileStore& memberFiles, const string& format) const
+{
+    CandidateSolution::toCode(fileName);
+    
+    ofstream file;
+    file.open(fileName.c_str());
+    
+    if(file.is_open() == false)
+    {
+        throw Exception("Could not open file \"" + fileName + "\".", LOCATION);
+    }
+    
+    for (auto ind: m_individuals) {
+        file << memberFiles.acquire(*ind, format) << endl;
+    }
+    
+    LOG_DEBUG 
+    << "Saving group " << this
+    << " to file \"" << fileName << "\" with shared member files..." << ends;
+    
+    file.close();
+}
+
 void Group::outputLineage(ostream& lineageFile, unsigned int recursion, const string& indent) const
 {
     CandidateSolution::outputLineage(lineageFile, recursion, indent);
@@ -292,7 +315,7 @@ void Group::computeNormalizedPhenotype(string& code) const
 {
     std::vector<GEIndividual*> individuals = m_individuals;
     std::sort(individuals.begin(), individuals.end(), [] (GEIndividual* ind1, GEIndividual* ind2) {
-        return ind1->getId() < ind2->getId();
+        return ind1->getNumericId() < ind2->getNumericId();
     });
     for (auto individual: individuals) {
         code += individual->getId();
@@ -332,6 +355,17 @@ void Group::computeMessage(ugp3::Message& message) const
     }
 }
 
+void Group::computeMemoryUsage(MemoryUsage& usage) const
+{
+    usage.countGroup();
+    usage.add(MemoryUsage::CANDIDATES, sizeof(*this) + MemoryUsage::ofVector(m_individuals));
+    usage.add(MemoryUsage::LINEAGE, MemoryUsage::ofVector(m_lineage.getParents()));
+    usage.countLineageParents(m_lineage.getParents().size());
+    usage.addMessage(*this);
+    
+    CandidateSolution::computeMemoryUsage(usage);
+}
+
 const string Group::getDisplayTypeName() const
 {
     return TypeName< Group >::name;
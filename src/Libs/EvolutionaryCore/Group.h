@@ -51,6 +51,7 @@ namespace core {
 
 class GroupPopulation;
 class GEIndividual;
+class MemberFileStore;
 
 /** 
  * @class Group
@@ -155,6 +156,14 @@ public:
      * @throws Any exception. ugp3::Exception if the file can't be opened
      */
     virtual void toCode(const string& fileName, std::vector<std::string>* outfiles = nullptr) const;
+    
+    /** 
+     * Writes a file named filename with the names of the files of the individuals,
+     * taken from the given store: the code of each individual is written only once.
+     * @param filename Name of the file to write the code
+     * @throws Any exception. ugp3::Exception if the file can't be opened
+     */
+    void toCode(const string& fileName, MemberFileStore& memberFiles, const std::string& format) const;
     virtual void outputLineage(std::ostream& lineageFile,
                        unsigned int recursion, const std::string& indent = "") const;
 
@@ -197,6 +206,7 @@ public:
     const GroupPopulation& getPopulation() const;
     
     virtual const Message& getMessage() const { return MessageHolder::getMessage(); };
+    virtual const MessageSketch& getSketch() const { return MessageHolder::getSketch(); };
     virtual void computeMessage(Message& message) const;
     
     virtual unique_ptr<Group> clone() const;
@@ -209,6 +219,12 @@ public:
     
     virtual const string getDisplayTypeName() const;
     
+    /**
+     * Counts the group and its own data: its individuals are owned by
+     * the population and counted once, by the population.
+     */
+    virtual void computeMemoryUsage(MemoryUsage& usage) const;
+    
     virtual const SpecificLineage<Group>& getLineage() const { return m_lineage; }
     virtual SpecificLineage<Group>& getLineage() { return m_lineage; }
     
@@ -31,6 +31,11 @@
 using namespace std;
 using namespace ugp3::core;
 
+GroupFitnessEvaluator::~GroupFitnessEvaluator()
+{
+    m_memberFiles.clear(getRemoveTemporaryFiles());
+}
+
 void GroupFitnessEvaluator::evaluate(CandidateSolution& object)
 {
 #if defined GROUP_EVALUATION_METHOD0
@@ -28,6 +28,7 @@
 #define HEADER_UGP3_CORE_GROUPFITNESSEVALUATOR
 
 #include "EvaluatorCommon.h"
+#include "MemberFileStore.h"
 
 /**
  * Method for the evaluation of groups
@@ -83,9 +84,15 @@ private:
     
 #endif
     
+    /**
+     * Files of the individuals referenced by the group files given
+     * to an external evaluator.
+     */
+    MemberFileStore m_memberFiles;
+    
 public:
     GroupFitnessEvaluator() {};
-    virtual ~GroupFitnessEvaluator() {};
+    virtual ~GroupFitnessEvaluator();
     
     /**
      * Intercept group evaluations to perform individual evaluations based on the new fitness model.
@@ -101,6 +108,8 @@ public:
      * Number of fitness components in a group for each fitness component in an individual.
      */
     unsigned int getGroupFitnessComponentMultiplier() const { return m_groupFitnessComponentsMultiplier; }
+    
+    MemberFileStore& getMemberFiles() { return m_memberFiles; }
 };
 
 }
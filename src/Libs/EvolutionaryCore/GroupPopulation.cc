@@ -145,6 +145,14 @@ void GroupPopulation::setupPopulation()
 
 void GroupPopulation::removeDeadCandidates()
 {
+    // Dead individuals do not need their shared files anymore
+    GroupFitnessEvaluator& evaluator = getParameters().getEvaluator();
+    for (auto ind: m_individuals) {
+        if (ind->isDead()) {
+            evaluator.getMemberFiles().release(ind->getId(), evaluator.getRemoveTemporaryFiles());
+        }
+    }
+    
     removeCorpses(m_groups);
     removeCorpses(m_individuals);
 }
@@ -307,6 +315,13 @@ void GroupPopulation::slaughtering()
     simpleSelection(mu, withoutGroupBegin, m_individuals.end());
 }
 
+void GroupPopulation::buildSelectionKeys(SelectionKeys& keys) const
+{
+    // Individuals and groups are both selected by the operators
+    SpecificIndividualPopulation<GEIndividual>::buildSelectionKeys(keys);
+    keys.build(m_groups.begin(), m_groups.end());
+}
+
 void GroupPopulation::prepareForCommit()
 {
     // Rescale the fitness of group clones (maybe in the future?)
@@ -382,6 +397,10 @@ void GroupPopulation::showStatistics(void) const
     << "; average size: " << averageSize
     << "; average delta entropy: " << averageDeltaEntropy
     << std::ends;
+    if (MessageSketch::getCheckEnabled())
+    {
+        showApproximateEntropicError("Groups", m_groups.begin(), m_groups.end());
+    }
     LOG_INFO << "[Groups] Average fitness:";
     for (unsigned int i = 0; i <  averageFitness.size(); i++)
     {
@@ -399,6 +418,17 @@ void GroupPopulation::showStatistics(void) const
     SpecificIndividualPopulation::showStatistics();
 }
 
+void GroupPopulation::computeMemoryUsage(MemoryUsage& usage) const
+{
+    usage.add(MemoryUsage::CANDIDATES, MemoryUsage::ofVector(m_groups));
+    for (Group* group: m_groups)
+    {
+        group->computeMemoryUsage(usage);
+    }
+    
+    SpecificIndividualPopulation::computeMemoryUsage(usage);
+}
+
 void GroupPopulation::dumpStatistics(ostream& output) const
 {
     SpecificIndividualPopulation::dumpStatistics(output);
@@ -122,6 +122,8 @@ protected:
     virtual void removeDeadCandidates();
     
     virtual void prepareForCommit();
+    
+    virtual void buildSelectionKeys(SelectionKeys& keys) const;
 
     /**
      * Sets the best and wort group in the population
@@ -195,6 +197,16 @@ public:
      * Groups: we use delta entropy.
      */
     virtual bool compareForFitnessHole(const CandidateSolution* a, const CandidateSolution* b) const;
+    
+    /**
+     * Individuals and groups survive through their groups: no racing.
+     */
+    virtual const CandidateSolution* getRacingRival(const CandidateSolution&) const { return nullptr; }
+    
+    /**
+     * Discarding individuals would leave holes in the new groups: no screening.
+     */
+    virtual void screenOffspring(const std::vector<CandidateSolution*>&) {}
 
     /**
      * Creates a new random instance of a Group.
@@ -261,6 +273,11 @@ public: // Population methods
    */
   virtual void evaluateAndHandleClones();
 
+  /**
+   * Groups and their individuals are evaluated together, one generation at a time.
+   */
+  virtual bool supportsAsynchronousEvaluation() const override { return false; }
+
   /**
    * Increments the ages of individuals and groups
    * @throws std::exception
@@ -270,6 +287,7 @@ public: // Population methods
   virtual void showStatistics(void) const;
   virtual void dumpStatistics(std::ostream& output) const;
   virtual void dumpStatisticsHeader(std::ostream& output) const;
+  virtual void computeMemoryUsage(MemoryUsage& usage) const;
 
   virtual GroupPopulationParameters& getParameters() noexcept { return m_parameters; }
   virtual const GroupPopulationParameters& getParameters() const noexcept { return m_parameters; }
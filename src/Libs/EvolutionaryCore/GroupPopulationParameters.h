@@ -135,6 +135,11 @@ public:
      */
     unsigned int getGroupMu() const { return groupMu; }
     
+    /**
+     * Fitness sharing among groups always uses the entropic distance. It is
+     * estimated from the sketches when the fitness sharing distance of the
+     * population is "approximateEntropic".
+     */
     bool getGroupFitnessSharingEnabled() const { return m_groupFitnessSharingEnabled; }
     double getGroupFitnessSharingRadius() const { return m_groupFitnessSharingRadius; }
     
@@ -34,6 +34,7 @@
 
 #include "Individual.h"
 #include "IndividualPopulation.h"
+#include "MemoryUsage.h"
 
 using namespace std;
 using namespace ugp3::core;
@@ -137,19 +138,15 @@ void Individual::toCode(const string& fileName, vector< string >* outfiles) cons
 
 void Individual::computeNormalizedPhenotype(string& code) const
 {
-    ostringstream stream;
     ugp3::ctgraph::NormalizingRelabeller relabeller;
-    this->m_graphContainer->writeExternalRepresentation(stream, relabeller);
-    code = stream.str();
+    this->m_graphContainer->appendExternalRepresentation(code, relabeller);
 }
 
 const string& Individual::getExternalRepresentation() const
 {
     if (m_externalRepresentation.empty()) {
-        ostringstream stream;
         ugp3::ctgraph::IdentityRelabeller relabeller;
-        this->m_graphContainer->writeExternalRepresentation(stream, relabeller);
-        m_externalRepresentation = stream.str();
+        this->m_graphContainer->appendExternalRepresentation(m_externalRepresentation, relabeller);
     }
     return m_externalRepresentation;
 }
@@ -237,6 +234,21 @@ const string Individual::getDisplayTypeName() const
     return TypeName< Individual >::name;
 }
 
+void Individual::computeMemoryUsage(MemoryUsage& usage) const
+{
+    usage.countIndividual();
+    usage.add(MemoryUsage::CANDIDATES, sizeof(*this));
+    usage.add(MemoryUsage::PHENOTYPES, MemoryUsage::ofString(m_externalRepresentation));
+    usage.add(MemoryUsage::LINEAGE, MemoryUsage::ofVector(m_lineage.getParents()));
+    usage.countLineageParents(m_lineage.getParents().size());
+    
+    if (m_graphContainer) {
+        usage.addGraphContainer(*m_graphContainer);
+    }
+    
+    CandidateSolution::computeMemoryUsage(usage);
+}
+
 void Individual::outputLineage(ostream& lineageFile, unsigned int recursion, const string& indent) const
 {
     if (recursion) 
@@ -129,8 +129,11 @@ public:
 
 public:
     virtual const Message& getMessage() const { return m_graphContainer->getMessage(); }
+    virtual const MessageSketch& getSketch() const { return m_graphContainer->getSketch(); }
     
     virtual const std::string getDisplayTypeName() const;
+    
+    virtual void computeMemoryUsage(MemoryUsage& usage) const;
 
 public: // IValidable interface
     virtual bool validate() const;
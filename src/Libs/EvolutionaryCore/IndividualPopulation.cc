@@ -159,7 +159,8 @@ void SpecificIndividualPopulation<IndividualType>::evaluateAndHandleClones()
     size_t evaluated = runEvaluator(m_individuals.begin(), m_individuals.end());
     
     // Because just after a recovery, we might not need to compute anything if the recovery file had all the information
-    if (evaluated > 0) 
+    // In asynchronous mode, the new offspring have been evaluated before being merged
+    if (evaluated > 0 || getParameters().getAsynchronousQueueDepth() > 0) 
     {
         // Compute scaled fitness and/or kill the clones
         detectAndHandleClones(m_individuals.begin(), m_individuals.end());
@@ -372,6 +373,11 @@ void SpecificIndividualPopulation<IndividualType>::showStatistics(void) const
     << "; average delta entropy: " << averageDeltaEntropy
     << std::ends;
 
+    if (MessageSketch::getCheckEnabled())
+    {
+        showApproximateEntropicError("Individuals", m_individuals.begin(), m_individuals.end());
+    }
+
     LOG_INFO << "[Individuals] Average fitness:";
     for (unsigned int i = 0; i <  averageFitness.size(); i++)
     {
@@ -391,6 +397,18 @@ void SpecificIndividualPopulation<IndividualType>::showStatistics(void) const
     IndividualPopulation::showStatistics();
 }
 
+template <class IndividualType>
+void SpecificIndividualPopulation<IndividualType>::computeMemoryUsage(MemoryUsage& usage) const
+{
+    usage.add(MemoryUsage::CANDIDATES, MemoryUsage::ofVector(m_individuals));
+    for (IndividualType* individual: m_individuals)
+    {
+        individual->computeMemoryUsage(usage);
+    }
+    
+    IndividualPopulation::computeMemoryUsage(usage);
+}
+
 template <class IndividualType>
 void SpecificIndividualPopulation<IndividualType>::dumpAllCandidates()
 {
@@ -416,6 +434,15 @@ void SpecificIndividualPopulation<IndividualType>::dumpAllCandidates()
 template <class IndividualType>
 const string SpecificIndividualPopulation<IndividualType>::XML_CHILD_ELEMENT_INDIVIDUALS = "individuals";
 
+template <class IndividualType>
+const string SpecificIndividualPopulation<IndividualType>::XML_CHILD_ELEMENT_INFLIGHT = "inFlight";
+
+template <class IndividualType>
+const string SpecificIndividualPopulation<IndividualType>::XML_CHILD_ELEMENT_OFFSPRING = "offspring";
+
+template <class IndividualType>
+const string SpecificIndividualPopulation<IndividualType>::XML_ATTRIBUTE_OPERATOR = "operator";
+
 template <class IndividualType>
 void SpecificIndividualPopulation<IndividualType>::readXml(const xml::Element& element)
 {
@@ -440,6 +467,10 @@ void SpecificIndividualPopulation<IndividualType>::readXml(const xml::Element& e
 
             this->parseIndividuals(*childElement);
         }
+        else if (elementName == XML_CHILD_ELEMENT_INFLIGHT)
+        {
+            this->parseInFlight(*childElement);
+        }
 
         childElement = childElement->NextSiblingElement();
     }
@@ -527,6 +558,46 @@ void SpecificIndividualPopulation<IndividualType>::parseIndividuals(const xml::E
     }
 }
 
+template <class IndividualType>
+void SpecificIndividualPopulation<IndividualType>::parseInFlight(const xml::Element& element)
+{
+    _STACK;
+
+    LOG_DEBUG << "Parsing /evolutionaryAlgorithm/populations/population/inFlight ..." << ends;
+
+    OperatorSelector& selector = getParameters().getActivations().getOperatorSelector();
+    const xml::Element* childElement = element.FirstChildElement();
+    while (childElement != nullptr)
+    {
+        if (childElement->ValueStr() != XML_CHILD_ELEMENT_OFFSPRING)
+        {
+            throw xml::SchemaException("unexpected element \"" + childElement->ValueStr() + "\"", LOCATION);
+        }
+        const string operatorName = xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_OPERATOR);
+        Data* data = selector.getData(operatorName);
+        if (data == nullptr)
+        {
+            throw Exception("The operator \"" + operatorName + "\" of an offspring in flight is unknown.", LOCATION);
+        }
+        const xml::Element* individualElement = childElement->FirstChildElement(Individual::XML_NAME);
+        if (individualElement == nullptr)
+        {
+            throw xml::MissingElementSchemaException("/evolutionaryAlgorithm/populations/population/inFlight/offspring/individual", LOCATION);
+        }
+
+        // The evaluation was interrupted: it is requested again
+        unique_ptr<Individual> individual = Individual::instantiate(*individualElement, *this);
+        individual->getRawFitness().invalidate();
+        individual->getFitness().invalidate();
+        this->m_inFlight.emplace_back(individual.release(), data);
+        this->m_inFlightRestored = true;
+
+        childElement = childElement->NextSiblingElement();
+    }
+
+    LOG_VERBOSE << "Restored " << this->m_inFlight.size() << " offspring in flight" << ends;
+}
+
 template <class IndividualType>
 void SpecificIndividualPopulation<IndividualType>::writeInnerXml(ostream& output) const
 {
@@ -557,6 +628,25 @@ void SpecificIndividualPopulation<IndividualType>::writeInnerXml(ostream& output
     }
 
     output << "</" << XML_CHILD_ELEMENT_INDIVIDUALS << ">" << endl;
+
+    if (!this->m_inFlight.empty())
+    {
+        output << "<" << XML_CHILD_ELEMENT_INFLIGHT << ">" << endl;
+        output << "<!-- total " << this->m_inFlight.size() << " offspring under evaluation -->" << endl;
+
+        // The evaluator may be writing their fitness
+        getParameters().getEvaluator().whileResultsFrozen([&] {
+            for (auto& inFlight: this->m_inFlight)
+            {
+                output << "<" << XML_CHILD_ELEMENT_OFFSPRING << " " << XML_ATTRIBUTE_OPERATOR << "=\""
+                    << xml::Utility::transformXmlEscChar(inFlight.second->getOperatorName()) << "\">" << endl;
+                inFlight.first->writeXml(output);
+                output << "</" << XML_CHILD_ELEMENT_OFFSPRING << ">" << endl;
+            }
+        });
+
+        output << "</" << XML_CHILD_ELEMENT_INFLIGHT << ">" << endl;
+    }
 }
 
 template <class IndividualType> 
@@ -92,6 +92,14 @@ public:
     virtual const IndividualType* getBestScaledIndividual() const { return m_bestScaledIndividual; }
     virtual const IndividualType* getWorstScaledIndividual() const { return m_worstScaledIndividual; }
     
+    virtual const CandidateSolution* getRacingRival(const CandidateSolution&) const {
+        return findRacingRival(m_individuals.begin(), m_individuals.end(), this->getParameters().getMu());
+    }
+    
+    virtual void screenOffspring(const std::vector<CandidateSolution*>& newGeneration) {
+        screenWithSurrogate(m_individuals.begin(), m_individuals.end(), newGeneration);
+    }
+    
     virtual IndividualType& getIndividual(unsigned int i) const {
         return *m_individuals[i];
     }
@@ -205,6 +213,11 @@ public:
         removeCorpses(m_individuals);
     }
     
+    virtual void buildSelectionKeys(SelectionKeys& keys) const
+    {
+        keys.build(m_individuals.begin(), m_individuals.end());
+    }
+    
     virtual void slaughtering();
     
     virtual void prepareForCommit();
@@ -214,6 +227,7 @@ public:
     virtual void showStatistics(void) const;
     virtual void dumpStatisticsHeader(std::ostream& output) const;
     virtual void dumpStatistics(std::ostream& output) const;
+    virtual void computeMemoryUsage(MemoryUsage& usage) const;
     
     virtual double getAverageAge() const 
     {
@@ -238,9 +252,14 @@ public:
     
     /** Xml tag to specify the individuals of the population */
     static const std::string XML_CHILD_ELEMENT_INDIVIDUALS;
+    /** Xml tags to specify the offspring still under evaluation in asynchronous mode */
+    static const std::string XML_CHILD_ELEMENT_INFLIGHT;
+    static const std::string XML_CHILD_ELEMENT_OFFSPRING;
+    static const std::string XML_ATTRIBUTE_OPERATOR;
     virtual void readXml(const xml::Element& element);
     virtual void writeInnerXml(std::ostream& output) const;
     void parseIndividuals(const xml::Element& element);
+    void parseInFlight(const xml::Element& element);
 };
 
 }
@@ -26,22 +26,67 @@
 
 #include "Lineage.h"
 #include "Operator.h"
+#include "CandidateSolution.h"
 
 using namespace std;
 using namespace ugp3::core;
 
+Lineage::OperatorTable& Lineage::getOperatorTable()
+{
+    static OperatorTable table;
+    return table;
+}
+
+unsigned int Lineage::internOperatorName(const string& operatorName)
+{
+    OperatorTable& table = getOperatorTable();
+    auto it = table.ids.find(operatorName);
+    if (it != table.ids.end()) {
+        return it->second;
+    }
+    
+    unsigned int id = table.names.size();
+    table.names.push_back(operatorName);
+    table.ids.emplace(operatorName, id);
+    return id;
+}
+
+const string& Lineage::getOperatorName(unsigned int operatorId)
+{
+    Assert(operatorId < getOperatorTable().names.size());
+    return getOperatorTable().names[operatorId];
+}
+
 Lineage::Lineage()
-: m_operatorName(Operator::NO_OPERATOR)
+: m_operatorId(internOperatorName(Operator::NO_OPERATOR))
 {
 }
 
 void Lineage::clear()
 {
-    m_operatorName.clear();
-    m_parentNames.clear();
+    m_operatorId = internOperatorName("");
+    m_parentIds.clear();
     m_callData = nullptr;
 }
 
+vector<string> Lineage::getParentNames() const
+{
+    vector<string> parentNames;
+    parentNames.reserve(m_parentIds.size());
+    for (auto id: m_parentIds) {
+        parentNames.push_back(CandidateSolution::numberToId(id));
+    }
+    return parentNames;
+}
+
+void Lineage::setParentNames(const vector<string>& parentNames)
+{
+    m_parentIds.clear();
+    for (const string& name: parentNames) {
+        m_parentIds.push_back(CandidateSolution::idToNumber(name));
+    }
+}
+
 void Lineage::step()
 {
     m_callData = nullptr;
@@ -27,7 +27,10 @@
 #ifndef HEADER_UGP3_CORE_LINEAGE
 #define HEADER_UGP3_CORE_LINEAGE
 
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // headers from other modules
@@ -49,12 +52,14 @@ class CandidateSolution;
  *      of the generated candidates, and a pointer to the
  *      statistical data about the operator call.
  * 
- *  -   From one generation to another, to store the names
- *      of the parents of the individual, and the name of
+ *  -   From one generation to another, to store the numeric
+ *      ids of the parents of the individual, and the id of
  *      the operator that generated it.
  * 
- * Only the names are written and read from the XML dumps,
+ * Operator names are interned in a table shared by all the lineages.
+ * Only the ids are written and read from the XML dumps (as names),
  * all other pointers are reset at the end of the generation.
+ * The full history of the run can be kept on disk by the Genealogy.
  */
 class Lineage: public xml::XMLIFace
 {
@@ -67,16 +72,22 @@ private: // static fields
     static const std::string XML_CHILD_PARENT;
     static const std::string XML_ATTRIBUTE_REF;
     
+    struct OperatorTable {
+        std::deque<std::string> names;
+        std::unordered_map<std::string, unsigned int> ids;
+    };
+    static OperatorTable& getOperatorTable();
+    
 protected:
     // Fields that will be written to XML
-    std::string m_operatorName;
+    unsigned int m_operatorId;
     /*
      * NOTE Since group ids and individual ids can collide,
      * this list of ids means nothing on its own. Whether
      * those refer to groups or individuals depends on the type
      * of this Lineage.
      */
-    std::vector<std::string> m_parentNames;
+    std::vector<std::uint64_t> m_parentIds;
     
     // Temporary fields for the generation
     CallData* m_callData = nullptr;
@@ -84,6 +95,7 @@ protected:
 protected:
     Lineage();
     virtual void clear();
+    void setParentNames(const std::vector<std::string>& parentNames);
     
 public: // static fields
     static const std::string XML_NAME;
@@ -93,8 +105,15 @@ public: // constructors and destructors
 	virtual ~Lineage() {};
 
 public: // methods
-	const std::string& getOperatorName() const { return m_operatorName; }
-	const std::vector<std::string>& getParentNames() const { return m_parentNames; }
+	unsigned int getOperatorId() const { return m_operatorId; }
+	const std::string& getOperatorName() const { return getOperatorName(m_operatorId); }
+	void setOperatorName(const std::string& operatorName) { m_operatorId = internOperatorName(operatorName); }
+	
+	/**
+	 * Numeric ids of the parents, see CandidateSolution::getNumericId().
+	 */
+	const std::vector<std::uint64_t>& getParentIds() const { return m_parentIds; }
+	std::vector<std::string> getParentNames() const;
     
     void setCallData(CallData * callData) { m_callData = callData; }
     CallData * getCallData() const { return m_callData; }
@@ -106,6 +125,15 @@ public: // methods
      */
     virtual void step();
 
+public: // operator names
+    /**
+     * @return The id of the given operator name, adding it to the table
+     * the first time it is seen. Ids are consecutive, starting from zero.
+     */
+    static unsigned int internOperatorName(const std::string& operatorName);
+    static const std::string& getOperatorName(unsigned int operatorId);
+    static unsigned int getOperatorNameCount() { return getOperatorTable().names.size(); }
+
 public: // Xml interface
 	virtual void writeXml(std::ostream& output) const;
 	virtual void readXml(const xml::Element& element);
@@ -131,15 +159,15 @@ public:
     }
     
     void set(const std::string& operatorName, const std::vector<std::string>& parentNames) {
-        m_operatorName = operatorName;
-        m_parentNames = parentNames;
+        setOperatorName(operatorName);
+        setParentNames(parentNames);
         m_parents.clear();
     }
     
     void set(const std::string& operatorName, const std::vector< T* >& parents) {
-        m_operatorName = operatorName;
+        setOperatorName(operatorName);
         for (auto parent : parents) {
-            m_parentNames.push_back(parent->getId());
+            m_parentIds.push_back(parent->getNumericId());
         }
         m_parents = parents;
     }
@@ -26,6 +26,7 @@
 
 #include "Lineage.h"
 #include "Operator.h"
+#include "CandidateSolution.h"
 
 using namespace std;
 using namespace ugp3::core;
@@ -60,12 +61,13 @@ void Lineage::readXml(const xml::Element& element)
 
 			operatorFound = true;
 			
-			string m_operatorName = xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_REF);
-            LOG_DEBUG << "Found generating operator '" << m_operatorName << "'" << ends;
+			const string& operatorName = xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_REF);
+            LOG_DEBUG << "Found generating operator '" << operatorName << "'" << ends;
+            setOperatorName(operatorName);
 
-            if (m_operatorName != Operator::NO_OPERATOR && !Operator::getOperator(m_operatorName)) {
+            if (operatorName != Operator::NO_OPERATOR && !Operator::getOperator(operatorName)) {
 				LOG_WARNING 
-				    << "Lineage: the operator \"" << m_operatorName 
+				    << "Lineage: the operator \"" << operatorName 
 				    << "\" that generated the candidate was not found. " 
 				    << "Did you remember to define it before loading the individual?" << ends;
 			}
@@ -101,15 +103,15 @@ void Lineage::writeXml(ostream& output) const
 	output
 		<< "<" << XML_NAME << ">" << endl
 		<< "<" << XML_CHILD_OPERATOR << " " << XML_ATTRIBUTE_REF << "=\"" 
-        << xml::Utility::transformXmlEscChar(m_operatorName) << "\" />" << endl;
+        << xml::Utility::transformXmlEscChar(getOperatorName()) << "\" />" << endl;
 	
-	if (!m_parentNames.empty()) {
+	if (!m_parentIds.empty()) {
 		output << "<" << XML_CHILD_PARENTS << ">" << endl;
 
-        for (auto parentName: m_parentNames) {
+        for (auto parentId: m_parentIds) {
 			output 
                 << "<" << XML_CHILD_PARENT << " " << XML_ATTRIBUTE_REF 
-                << "=\"" << xml::Utility::transformXmlEscChar(parentName) << "\"/>" << endl;
+                << "=\"" << CandidateSolution::numberToId(parentId) << "\"/>" << endl;
 		}
 
 		output << "</" << XML_CHILD_PARENTS << ">" << endl;
@@ -130,7 +132,7 @@ void Lineage::parseParents(const xml::Element& element)
         
 		if (elementName == XML_CHILD_PARENT) {
 			const string& parent = xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_REF);
-			m_parentNames.push_back(parent);
+			m_parentIds.push_back(CandidateSolution::idToNumber(parent));
             LOG_DEBUG << "Found parent" << parent << ends;
 		} else {
 			throw xml::SchemaException("unexpected element \"" + elementName + "\"", LOCATION);
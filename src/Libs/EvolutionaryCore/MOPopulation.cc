@@ -465,16 +465,14 @@ void MOPopulation::updateSteadyStateGenerations()
 void MOPopulation::computeLevels()
 {
     _STACK;
+    Profiler::Scope scope(m_profiler, Profiler::LEVELS);
     
     /*
-     *  computes the level for each individual
-     * For each individual i:
-     * if !exists an individual j such as j covers i
-     * 	 then i is in level 0
-     * endif
-     * remove all individuals in level 0
-     * repeat cycle to find individuals in level 1, 2, etc.
-     * Procedure ends when all individuals are classified.
+     * Fast non-dominated sort: an individual is in level 0 if no other
+     * individual covers it; removing level 0, the individuals that are
+     * no longer covered form level 1, and so on. Each pair is compared
+     * once, and each individual keeps the list of those it covers and
+     * the number of those that cover it.
      */
     
     for (auto individual: m_individuals) 
@@ -482,160 +480,172 @@ void MOPopulation::computeLevels()
         // invalidates current level
         individual->setLevel(-1);
     }
+    m_levelSizes.clear();
     
     // Dead individuals are not updated because their fitness is invalid
     // Zombies are updated so they can die when they leave the first level
     auto begin = regroupAndSkipDeadCandidates(m_individuals.begin(), m_individuals.end());
+    const std::vector<MOIndividual*> candidates(begin, m_individuals.end());
+    const std::size_t size = candidates.size();
     
-    // recomputes levels
-    int n;
-    bool end = false;
-    unsigned int validated;
+    // Contiguous copy of the (scaled) fitness values
+    const std::size_t objectives = size > 0 ? candidates.front()->getFitness().getValues().size() : 0;
+    std::vector<double> values(size * objectives);
+    for (std::size_t i = 0; i < size; ++i) 
+    {
+        const vector<double>& fitness = candidates[i]->getFitness().getValues();
+        Assert(fitness.size() == objectives);
+        std::copy(fitness.begin(), fitness.end(), values.begin() + i * objectives);
+    }
     
-    for (n = 0 , validated = 0; !end/* there are still individuals */; n++) 
+    std::vector<unsigned int> coveredBy(size, 0);
+    std::vector<std::vector<unsigned int>> covers(size);
+    for (std::size_t i = 0; i < size; ++i) 
+    {
+        const double* fitness1 = &values[i * objectives];
+        for (std::size_t j = i + 1; j < size; ++j) 
+	{
+            const double* fitness2 = &values[j * objectives];
+            bool greater = false;
+            bool lower = false;
+            for (std::size_t k = 0; k < objectives && !(greater && lower); ++k) 
+	    {
+                if (fitness1[k] > fitness2[k])
+                    greater = true;
+                else if (fitness1[k] < fitness2[k])
+                    lower = true;
+            }
+            if (greater && !lower) 
+	    {
+                covers[i].push_back(j);
+                ++coveredBy[j];
+            } 
+	    else if (lower && !greater) 
+	    {
+                covers[j].push_back(i);
+                ++coveredBy[i];
+            }
+        }
+    }
+    
+    std::vector<unsigned int> level;
+    for (unsigned int i = 0; i < size; ++i) 
+    {
+        if (coveredBy[i] == 0)
+            level.push_back(i);
+    }
+    
+    int n = 0;
+    unsigned int validated = 0;
+    std::vector<unsigned int> nextLevel;
+    for (; !level.empty(); ++n) 
     {
-        end = true;
         LOG_INFO << "Computing level " << n << Progress(validated / ((double) m_individuals.size() + 1.0)) << ends;
         
-        for (auto it = begin; it != m_individuals.end(); ++it) 
+        unsigned int alive = 0;
+        nextLevel.clear();
+        for (unsigned int i: level) 
 	{
-            MOIndividual* individual = *it;
-            bool found_cover = false;
+            MOIndividual* individual = candidates[i];
+            individual->setLevel(n);
+            alive += individual->isAlive();
+            LOG_DEBUG 	<< "Individual " << *individual << " with fitness " << individual->getFitness() 
+			<< " belongs to level " << individual->getLevel() << ends;
             
-            // computes only individuals with level invalidated
-            if (individual->getLevel() == -1) 
+            for (unsigned int j: covers[i]) 
 	    {
-                end = false;
-                // considers the scaled fitness
-                for (auto it2 = begin; it2 != m_individuals.end(); ++it2) 
-		{
-                    MOIndividual* individual2 = *it2;
-                    if (found_cover)
-                        break;
-                    
-                    if (individual != individual2 && ((int)individual2->getLevel() == n || individual2->getLevel() == -1)) 
-		    {
-                        /* we don't consider levels above this */
-                        if (individual->getFitness().compareTo(individual2->getFitness()) < 0)
-                        {
-                            // individual is covered by at least one other individual
-                            found_cover = true;
-                        }
-                    }
-                }
-                
-                if (!found_cover)
-                {
-                    // individual belongs to level n
-                    individual->setLevel(n);
-                    validated++;
-                    LOG_DEBUG 	<< "Individual " << *individual << " with fitness " << individual->getFitness() 
-				<< " belongs to level " << individual->getLevel() << ends;
-                }
+                if (--coveredBy[j] == 0)
+                    nextLevel.push_back(j);
             }
         }
+        validated += level.size();
+        m_levelSizes.push_back(alive);
+        level.swap(nextLevel);
     }
     
     LOG_INFO << "Computing levels" << Progress::END << ends;
     
     // sets maxLevel
-    this->setMaxLevel(n-2); // the for cycle makes one more loop before exiting
+    this->setMaxLevel(n - 1);
 }
 
 void MOPopulation::computePerceivedStrength()
 {
     _STACK;
+    Profiler::Scope scope(m_profiler, Profiler::LEVELS);
     
     // here the "strength" is the "crowding distance"; basically, it's based on the fitness-space distance between
     // an individual and the two closest neighbours of the same level. Once the two closest individuals are found, the crowding
     // distance is the area of the rectangle whose two opposite vertices are the two closest individuals.
+    // Each level is sorted once per objective: the closest neighbours are the adjacent individuals in that order,
+    // and the individuals at the limits of each objective are assigned an infinite value.
     
     LOG_INFO << "Computing crowding distance for all individuals..." << ends;
     
     // Zombies and dead individuals are out of it
     auto begin = regroupAndSkipNotAliveCandidates(m_individuals.begin(), m_individuals.end());
     
+    std::vector<std::vector<MOIndividual*>> levels;
     for (auto it = begin; it != m_individuals.end(); ++it) 
     {
+        // Individuals without a level (-1) are grouped together, like any level
         MOIndividual* individual = *it;
-        // initialize the vectors
-        vector<double> distancesLeft, distancesRight; 
-        vector<MOIndividual*> closestNeighboursLeft, closestNeighboursRight;
+        std::size_t index = individual->getLevel() + 1;
+        if (index >= levels.size())
+            levels.resize(index + 1);
+        levels[index].push_back(individual);
+    }
+    
+    std::vector<double> values;
+    std::vector<double> hyperVolumes;
+    std::vector<unsigned int> order;
+    for (const std::vector<MOIndividual*>& level: levels) 
+    {
+        const std::size_t size = level.size();
+        if (size == 0)
+            continue;
         
-        size_t fitnessSize = individual->getRawFitness().getValues().size();
-        distancesLeft.resize(fitnessSize, -1);
-        distancesRight.resize(fitnessSize, -1);
-        closestNeighboursLeft.resize(fitnessSize, nullptr);
-        closestNeighboursRight.resize(fitnessSize, nullptr);
+        // Contiguous copy of the raw fitness values
+        const std::size_t objectives = level.front()->getRawFitness().getValues().size();
+        values.resize(size * objectives);
+        for (std::size_t i = 0; i < size; ++i) 
+	{
+            const vector<double>& fitness = level[i]->getRawFitness().getValues();
+            Assert(fitness.size() == objectives);
+            std::copy(fitness.begin(), fitness.end(), values.begin() + i * objectives);
+        }
         
-        // so, FOR EACH OBJECTIVE, find the two closest points (one on each side of the objective), on the same front!
-        // for each front, solutions at the limit of each objective are assigned an infinite value
-        LOG_DEBUG << "Computing crowding distance for individual " << *individual << "..." << ends;
-        for (auto it2 = begin; it2 != m_individuals.end(); ++it2) 
+        hyperVolumes.assign(size, 1.0);
+        order.resize(size);
+        for (std::size_t objective = 0; objective < objectives; ++objective) 
 	{
-            MOIndividual* individual2 = *it2;
-            if( individual != individual2 && individual->getLevel() == individual2->getLevel() )
-            {
-                for (unsigned int objective = 0; objective < fitnessSize; objective++)
-                {
-                    double difference = 
-                    individual->getRawFitness().getValues()[objective] - individual2->getRawFitness().getValues()[objective];
-                    
-                    if( difference < 0 )
-                    {
-                        if( abs(difference) < distancesLeft[objective] || distancesLeft[objective] == -1 )
-                        {
-                            distancesLeft[objective] = abs(difference);
-                            closestNeighboursLeft[objective] = individual2;
-                        }
-                    }
-                    else if( difference > 0 )
-                    {
-                        if( abs(difference) < distancesRight[objective] || distancesRight[objective] == -1 )
-                        {
-                            distancesRight[objective] = abs(difference);
-                            closestNeighboursRight[objective] = individual2;
-                        }
-                    }
-                    else if( difference == 0 )
-                    {
-                        // I actually have no idea how to manage this...
-                        // maybe replace the largest? replace the closest?
-                        if( distancesRight[objective] > distancesLeft[objective] )
-                        {
-                            distancesRight[objective] = abs(difference);
-                            closestNeighboursRight[objective] = individual2;
-                        }
-                        else
-                        {
-                            distancesLeft[objective] = abs(difference);
-                            closestNeighboursLeft[objective] = individual2;
-                        }
-                    }
+            for (unsigned int i = 0; i < size; ++i)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [&] (unsigned int a, unsigned int b) {
+                return values[a * objectives + objective] < values[b * objectives + objective];
+            });
+            
+            hyperVolumes[order.front()] = DBL_MAX;
+            hyperVolumes[order.back()] = DBL_MAX;
+            for (std::size_t p = 1; p + 1 < size; ++p) 
+	    {
+                double& hyperVolume = hyperVolumes[order[p]];
+                if (hyperVolume < DBL_MAX) 
+		{
+                    hyperVolume *= values[order[p + 1] * objectives + objective] 
+                                 - values[order[p - 1] * objectives + objective];
                 }
             }
-        } // end for each other individual
+        }
         
-        double hyperVolume = 1;
-        for (unsigned int objective = 0; objective < fitnessSize && hyperVolume < DBL_MAX; objective++) 
+        for (std::size_t i = 0; i < size; ++i) 
 	{
-            if (distancesLeft[objective] == -1 || distancesRight[objective] == -1)
-                hyperVolume = DBL_MAX;
-            else
-                hyperVolume *= (distancesLeft[objective] + distancesRight[objective]);
+            LOG_DEBUG 	<< "Hypervolume of crowding distance for individual " << *level[i] 
+			<< " with fitness=" << level[i]->getRawFitness()
+			<< " is " << hyperVolumes[i] << ends; 
+            level[i]->setPerceivedStrength(hyperVolumes[i]);
         }
-
-        LOG_DEBUG 	<< "Hypervolume of crowding distance for individual " << *individual 
-			<< " with fitness=" << individual->getRawFitness()
-			<< " is " << hyperVolume << ends; 
-        
-        // now, a couple of special cases: if the hyperVolume is negative, it's one of the individuals at the limit
-        // so we superboost its crowding distance, it is at the edge of the front
-        if( hyperVolume < 0 ) hyperVolume = DBL_MAX;
-        
-        individual->setPerceivedStrength( hyperVolume );
-        
-    } // end for each individual
+    }
 }
 
 // computes average fitness in level n
@@ -755,6 +765,10 @@ unsigned int MOPopulation::getLevelSize(int n) const {
     if (n > this->getMaxLevel() || n < 0)
         throw Exception("Invalid level number.", LOCATION);
     
+    // Levels read from a status file have not been counted yet
+    if (m_levelSizes.size() == (std::size_t)this->getMaxLevel() + 1)
+        return m_levelSizes[n];
+    
     unsigned int size = 0;
     for (unsigned int i = 0; i < m_individuals.size(); i++)
     {
@@ -768,6 +782,8 @@ unsigned int MOPopulation::getLevelSize(int n) const {
 MOPopulation::~MOPopulation()
 {
     LOG_DEBUG << "Destructor: ugp3::core::MOPopulation" << ends;
+    
+    discardInFlightCandidates();
 }
 
 void MOPopulation::handleClone(CandidateSolution& master, CandidateSolution& clone, unsigned int number, unsigned int total)
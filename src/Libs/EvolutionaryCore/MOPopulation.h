@@ -54,6 +54,7 @@ private: // fields
     /** The entropy of the whole population.
         Used for statistics only. */
     int m_maxLevel = 0;	// # of levels = maxLevel + 1 (levels start with 0)	
+    std::vector<unsigned int> m_levelSizes; // live individuals in each level, set by computeLevels()
     bool m_firstRecovery = false;
     bool m_strengthValid = false;
 
@@ -94,6 +95,11 @@ protected: // virtual methods
      */
     virtual bool compareForSelection(const CandidateSolution* a, const CandidateSolution* b) const;
     
+    /**
+     * Levels and strengths are not part of the keys, leave them empty.
+     */
+    virtual void buildSelectionKeys(SelectionKeys&) const {}
+    
     /**
      * Compare levels and then strength (same as compareForSelection).
      */
@@ -101,6 +107,16 @@ protected: // virtual methods
         return compareForSelection(a, b);
     }
     
+    /**
+     * Levels depend on the whole population: no racing.
+     */
+    virtual const CandidateSolution* getRacingRival(const CandidateSolution&) const { return nullptr; }
+    
+    /**
+     * The surrogate ranks fitness values lexicographically, not by levels: no screening.
+     */
+    virtual void screenOffspring(const std::vector<CandidateSolution*>&) {}
+    
     // TODO define all these functions if the default implemented in Population.h is not satisfying
     // maybe using all the comparators from below
     // virtual bool compareClones(const CandidateSolution* a, const CandidateSolution* b) const;
@@ -29,6 +29,7 @@ void MOPopulation::readXml(const xml::Element& element)
     _STACK;
 
     SpecificIndividualPopulation::readXml(element);
+    m_levelSizes.clear();
    
     // sort the individuals
     std::stable_sort(m_individuals.begin(), m_individuals.end(), IndividualComparatorPlaceholderDec());
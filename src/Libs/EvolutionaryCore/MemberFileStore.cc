@@ -0,0 +1,106 @@
+/***********************************************************************\
+|                                                                       |
+| MemberFileStore.cc                                                    |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#include "EvolutionaryCore.h"
+#include "MemberFileStore.h"
+
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+using namespace std;
+using namespace ugp3::core;
+
+const string& MemberFileStore::acquire(const Individual& individual, const string& format)
+{
+    const string& code = individual.getExternalRepresentation();
+    
+    auto it = m_files.find(code);
+    if (it == m_files.end()) {
+        // Name the file after the hash of its content
+        ostringstream token;
+        token << "member" << hex << std::hash<string>()(code);
+        const string baseName = File::formatToName(format, "");
+        string fileName = File::appendStringToName(baseName, token.str());
+        for (unsigned int collision = 1; m_fileNames.count(fileName); ++collision) {
+            fileName = File::appendStringToName(baseName, token.str() + "_" + Convert::toString(collision));
+        }
+        
+        ofstream file(fileName.c_str());
+        if (file.is_open() == false) {
+            throw Exception("Could not open file \"" + fileName + "\".", LOCATION);
+        }
+        file << code;
+        file.close();
+        
+        LOG_DEBUG << "Saving the code of individual " << individual.getId()
+        << " to the shared file \"" << fileName << "\"" << ends;
+        
+        m_fileNames.insert(fileName);
+        it = m_files.emplace(code, Entry()).first;
+        it->second.m_fileName = fileName;
+    }
+    
+    if (it->second.m_owners.insert(individual.getId()).second) {
+        m_codeByOwner[individual.getId()] = code;
+    }
+    return it->second.m_fileName;
+}
+
+void MemberFileStore::release(const string& individualId, bool removeFile)
+{
+    auto owner = m_codeByOwner.find(individualId);
+    if (owner == m_codeByOwner.end()) {
+        return;
+    }
+    
+    auto it = m_files.find(owner->second);
+    m_codeByOwner.erase(owner);
+    if (it == m_files.end()) {
+        return;
+    }
+    
+    it->second.m_owners.erase(individualId);
+    if (it->second.m_owners.empty()) {
+        if (removeFile && !File::remove(it->second.m_fileName)) {
+            LOG_WARNING << "Could not delete file \"" << it->second.m_fileName << "\"" << ends;
+        }
+        m_fileNames.erase(it->second.m_fileName);
+        m_files.erase(it);
+    }
+}
+
+void MemberFileStore::clear(bool removeFiles)
+{
+    if (removeFiles) {
+        for (auto& entry: m_files) {
+            File::remove(entry.second.m_fileName);
+        }
+    }
+    m_files.clear();
+    m_codeByOwner.clear();
+    m_fileNames.clear();
+}
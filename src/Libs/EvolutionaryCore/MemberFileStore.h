@@ -0,0 +1,100 @@
+/***********************************************************************\
+|                                                                       |
+| MemberFileStore.h                                                     |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#ifndef HEADER_UGP3_CORE_MEMBERFILESTORE
+#define HEADER_UGP3_CORE_MEMBERFILESTORE
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ugp3 {
+namespace core {
+
+class Individual;
+
+/**
+ * Content-addressed store of the individual files referenced by group files.
+ * 
+ * In group evolution the same individual belongs to many groups: instead of
+ * writing its code once per group, the file is written the first time it is
+ * needed and shared by all the groups that contain an individual with the
+ * same code. Each file is kept as long as one of these individuals is alive.
+ */
+class MemberFileStore
+{
+private:
+    struct Entry {
+        std::string m_fileName;
+        std::unordered_set<std::string> m_owners;
+    };
+    
+    /**
+     * Files indexed by the code they contain.
+     */
+    std::unordered_map<std::string, Entry> m_files;
+    
+    /**
+     * Code of each individual that owns a file, by id.
+     */
+    std::unordered_map<std::string, std::string> m_codeByOwner;
+    
+    /**
+     * File names in use, to resolve collisions of the content hash.
+     */
+    std::unordered_set<std::string> m_fileNames;
+    
+public:
+    MemberFileStore() {}
+    MemberFileStore(const MemberFileStore&) = delete;
+    
+    /**
+     * Return the name of the file containing the code of the given individual,
+     * writing it if no other individual has the same code.
+     * @param format Pattern of the file name, as in evaluatorInputPathName.
+     */
+    const std::string& acquire(const Individual& individual, const std::string& format);
+    
+    /**
+     * The given individual is dead: its file is removed when no other
+     * live individual shares it.
+     * @param removeFile False to keep the file on disk anyway.
+     */
+    void release(const std::string& individualId, bool removeFile);
+    
+    /**
+     * Forget all files.
+     * @param removeFiles False to keep the files on disk.
+     */
+    void clear(bool removeFiles);
+    
+    std::size_t getFileCount() const { return m_files.size(); }
+};
+
+}
+}
+
+#endif // HEADER_UGP3_CORE_MEMBERFILESTORE
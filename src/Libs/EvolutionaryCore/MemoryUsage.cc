@@ -0,0 +1,230 @@
+/***********************************************************************\
+|                                                                       |
+| MemoryUsage.cc                                                        |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#include "EvolutionaryCore.h"
+#include "MemoryUsage.h"
+
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#ifdef USE_MALLINFO2
+#include <malloc.h>
+#endif
+
+using namespace std;
+using namespace ugp3::core;
+using namespace ugp3::ctgraph;
+
+// Approximate overhead of the node of a std::map (colour, parent, left, right)
+static const size_t MAP_NODE_OVERHEAD = 4 * sizeof(void*);
+
+bool MemoryUsage::s_enabled = false;
+
+MemoryUsage::MemoryUsage()
+{
+    reset();
+}
+
+void MemoryUsage::reset()
+{
+    for (auto& bytes: m_bytes) {
+        bytes = 0;
+    }
+    m_individualCount = 0;
+    m_groupCount = 0;
+    m_zombieCount = 0;
+    m_nodeCount = 0;
+    m_edgeCount = 0;
+    m_tagCount = 0;
+    m_lineageParentCount = 0;
+}
+
+size_t MemoryUsage::getTotalBytes() const
+{
+    size_t total = 0;
+    for (auto bytes: m_bytes) {
+        total += bytes;
+    }
+    return total;
+}
+
+size_t MemoryUsage::ofString(const string& value)
+{
+    // An empty string has the capacity of the small-string buffer
+    static const size_t inPlaceCapacity = string().capacity();
+    
+    return value.capacity() > inPlaceCapacity ? value.capacity() + 1 : 0;
+}
+
+void MemoryUsage::addTags(const Taggable& element)
+{
+    const unsigned int count = element.getTagCount();
+    for (unsigned int i = 0; i < count; i++) {
+        const Tag* tag = element.getTag(i);
+        // The name is stored both in the tag and in the key of the map
+        add(TAGS, sizeof(Tag) + sizeof(pair<const string, Tag*>) + MAP_NODE_OVERHEAD
+            + 2 * ofString(tag->getName()) + ofString(tag->getValue()));
+    }
+    m_tagCount += count;
+}
+
+void MemoryUsage::addMessage(const MessageHolder& holder)
+{
+    add(MESSAGES, holder.getMessageMemoryUsage());
+}
+
+void MemoryUsage::addFitness(Category category, const Fitness& fitness)
+{
+    add(category, fitness.getValues().capacity() * sizeof(double) + ofString(fitness.getDescription()));
+}
+
+void MemoryUsage::addFitness(Category category, const ScaledFitness& fitness)
+{
+    // The scaled values plus the copy of the raw values,
+    // without building the description if it is not there yet
+    add(category, 2 * fitness.getValues().capacity() * sizeof(double) + fitness.getDescriptionMemoryUsage());
+    
+    for (unsigned int cause = 0; cause < ScaledFitness::SCALING_CAUSE_COUNT; cause++) {
+        add(category, ofVector(fitness.getScaling((ScaledFitness::ScalingCause) cause)));
+    }
+}
+
+void MemoryUsage::addNode(const CNode& node)
+{
+    // Forward and backward edge pointers
+    const unsigned int edgeCount = node.getEdgeCount();
+    add(GRAPHS, sizeof(CNode) + ofString(node.getId())
+        + (edgeCount + node.getBackEdgeCount()) * sizeof(tgraph::Edge*));
+    addTags(node);
+    
+    // Edges are owned by their origin
+    for (unsigned int i = 0; i < edgeCount; i++) {
+        const tgraph::Edge& edge = static_cast<const tgraph::Node&>(node).getEdge(i);
+        add(GRAPHS, sizeof(tgraph::Edge));
+        addTags(edge);
+    }
+    m_edgeCount += edgeCount;
+    ++m_nodeCount;
+}
+
+void MemoryUsage::addGraphContainer(const CGraphContainer& container)
+{
+    add(GRAPHS, sizeof(CGraphContainer) + container.getCGraphCount() * sizeof(CGraph*));
+    addNode(container.getPrologue());
+    addNode(container.getEpilogue());
+    addMessage(container);
+    
+    for (unsigned int iGraph = 0; iGraph < container.getCGraphCount(); iGraph++) {
+        const CGraph& graph = container.getCGraph(iGraph);
+        
+        add(GRAPHS, sizeof(CGraph) + graph.getSubGraphCount() * sizeof(CSubGraph*));
+        addNode(graph.getPrologue());
+        addNode(graph.getEpilogue());
+        addTags(graph);
+        addMessage(graph);
+        
+        for (unsigned int iSubGraph = 0; iSubGraph < graph.getSubGraphCount(); iSubGraph++) {
+            const CSubGraph& subGraph = graph.getSubGraph(iSubGraph);
+            
+            // The subgraph indexes its nodes by id and keeps their sequence in a slice
+            const size_t size = subGraph.getSize();
+            add(GRAPHS, sizeof(CSubGraph) + size * sizeof(CNode*)
+                + size * (sizeof(pair<const string, CNode*>) + MAP_NODE_OVERHEAD));
+            
+            for (const CNode* cursor = &subGraph.getPrologue(); cursor != nullptr; cursor = cursor->getNext()) {
+                addNode(*cursor);
+                // Copy of the id used as key of the map
+                add(GRAPHS, ofString(cursor->getId()));
+            }
+        }
+    }
+}
+
+const string& MemoryUsage::getCategoryName(Category category)
+{
+    static const string names[CATEGORY_COUNT + 1] = {
+        "Candidates",
+        "Graphs",
+        "Tags",
+        "Phenotypes",
+        "Messages",
+        "Lineage",
+        "Cache",
+        "Unknown"
+    };
+    
+    return names[category < CATEGORY_COUNT ? category : CATEGORY_COUNT];
+}
+
+static string toMebibytes(size_t bytes)
+{
+    ostringstream stream;
+    stream << fixed << setprecision(2) << bytes / (1024.0 * 1024.0) << " MiB";
+    return stream.str();
+}
+
+const string MemoryUsage::toString() const
+{
+    ostringstream stream;
+    stream << toMebibytes(getTotalBytes()) << " (";
+    for (unsigned int category = CANDIDATES; category < CATEGORY_COUNT; category++) {
+        stream << (category == CANDIDATES ? "" : ", ") << getCategoryName((Category) category)
+            << " " << toMebibytes(m_bytes[category]);
+    }
+    stream << "); " << m_nodeCount << " nodes";
+    return stream.str();
+}
+
+void MemoryUsage::log(const string& name) const
+{
+    LOG_INFO << "Memory of population \"" << name << "\": about " << toMebibytes(getTotalBytes())
+        << " for " << m_individualCount << " individuals and " << m_groupCount << " groups ("
+        << m_zombieCount << " zombies)" << ends;
+    
+    for (unsigned int category = CANDIDATES; category < CATEGORY_COUNT; category++) {
+        LOG_INFO << "  " << getCategoryName((Category) category) << ": "
+            << toMebibytes(m_bytes[category]) << ends;
+    }
+    LOG_INFO << "  " << m_nodeCount << " nodes, " << m_edgeCount << " edges, "
+        << m_tagCount << " tags, " << m_lineageParentCount << " lineage parents" << ends;
+}
+
+bool MemoryUsage::getAllocatorStatistics(size_t& allocated, size_t& reserved)
+{
+#ifdef USE_MALLINFO2
+    struct mallinfo2 info = mallinfo2();
+    // Memory obtained with sbrk plus memory obtained with mmap
+    allocated = info.uordblks + info.hblkhd;
+    reserved = info.arena + info.hblkhd;
+    return true;
+#else
+    allocated = 0;
+    reserved = 0;
+    return false;
+#endif
+}
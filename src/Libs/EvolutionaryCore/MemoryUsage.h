@@ -0,0 +1,172 @@
+/***********************************************************************\
+|                                                                       |
+| MemoryUsage.h                                                         |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#ifndef HEADER_UGP3_CORE_MEMORYUSAGE
+#define HEADER_UGP3_CORE_MEMORYUSAGE
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ugp3 {
+
+class Taggable;
+class MessageHolder;
+
+namespace ctgraph {
+    class CGraphContainer;
+    class CNode;
+}
+
+namespace core {
+
+class Fitness;
+class ScaledFitness;
+
+/**
+ * Approximate number of bytes retained by the objects of a population.
+ * 
+ * The estimate walks the candidates and adds the size of the objects and of
+ * the memory they own (graphs, tags, cached strings, entropic messages,
+ * lineage, evaluation cache). Allocator overheads and the internals of the
+ * standard containers are approximated, so the result is meant to compare
+ * populations and generations, not to match the resident size of the process.
+ * 
+ * Memory accounting is disabled by default: the walk visits every node of
+ * every candidate, so it is only done when requested.
+ */
+class MemoryUsage
+{
+public:
+    typedef enum {
+        CANDIDATES = 0,
+        GRAPHS,
+        TAGS,
+        PHENOTYPES,
+        MESSAGES,
+        LINEAGE,
+        CACHE,
+        CATEGORY_COUNT
+    } Category;
+    
+private:
+    static bool s_enabled;
+    
+    std::size_t m_bytes[CATEGORY_COUNT];
+    std::size_t m_individualCount;
+    std::size_t m_groupCount;
+    std::size_t m_zombieCount;
+    std::size_t m_nodeCount;
+    std::size_t m_edgeCount;
+    std::size_t m_tagCount;
+    std::size_t m_lineageParentCount;
+    
+    void addNode(const ctgraph::CNode& node);
+    
+public:
+    MemoryUsage();
+    
+    void reset();
+    
+    void add(Category category, std::size_t bytes) { m_bytes[category] += bytes; }
+    std::size_t getBytes(Category category) const { return m_bytes[category]; }
+    std::size_t getTotalBytes() const;
+    
+    void countIndividual() { ++m_individualCount; }
+    void countGroup() { ++m_groupCount; }
+    void countZombie() { ++m_zombieCount; }
+    void countLineageParents(std::size_t count) { m_lineageParentCount += count; }
+    
+    std::size_t getIndividualCount() const { return m_individualCount; }
+    std::size_t getGroupCount() const { return m_groupCount; }
+    std::size_t getZombieCount() const { return m_zombieCount; }
+    std::size_t getNodeCount() const { return m_nodeCount; }
+    std::size_t getEdgeCount() const { return m_edgeCount; }
+    std::size_t getTagCount() const { return m_tagCount; }
+    std::size_t getLineageParentCount() const { return m_lineageParentCount; }
+    
+    /**
+     * Add the graphs, subgraphs, nodes, edges and tags of a graph container.
+     */
+    void addGraphContainer(const ctgraph::CGraphContainer& container);
+    
+    /**
+     * Add the tags of an element to the TAGS category.
+     */
+    void addTags(const Taggable& element);
+    
+    /**
+     * Add the cached entropic message of an object to the MESSAGES category.
+     * The message is not computed if it is not valid.
+     */
+    void addMessage(const MessageHolder& holder);
+    
+    /**
+     * Add the values and the description of a fitness.
+     */
+    void addFitness(Category category, const Fitness& fitness);
+    void addFitness(Category category, const ScaledFitness& fitness);
+    
+    /**
+     * One-line summary, with the size of each category.
+     */
+    const std::string toString() const;
+    
+    /**
+     * Log a detailed report, one line per category.
+     * @param name Name of the population
+     */
+    void log(const std::string& name) const;
+    
+    static const std::string& getCategoryName(Category category);
+    
+public:
+    /**
+     * Bytes allocated on the heap for the content of the string, zero when
+     * the string fits in the string object itself.
+     */
+    static std::size_t ofString(const std::string& value);
+    
+    template <class T>
+    static std::size_t ofVector(const std::vector<T>& value) {
+        return value.capacity() * sizeof(T);
+    }
+    
+    /**
+     * Memory obtained from the allocator: the bytes allocated to the program
+     * and the bytes reserved by the allocator (including free chunks).
+     * @return False if the allocator does not provide these statistics.
+     */
+    static bool getAllocatorStatistics(std::size_t& allocated, std::size_t& reserved);
+    
+    static bool getEnabled() { return s_enabled; }
+    static void setEnabled(bool value) { s_enabled = value; }
+};
+
+}
+}
+
+#endif // HEADER_UGP3_CORE_MEMORYUSAGE
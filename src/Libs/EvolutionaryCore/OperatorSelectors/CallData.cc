@@ -35,7 +35,8 @@ namespace ugp3 {
 namespace core {
 
 CallData::CallData()
-: m_validChildrenCount(0), m_evaluatedChildrenCount(0), m_childRewards(0.)
+: m_validChildrenCount(0), m_evaluatedChildrenCount(0), m_childRewards(0.),
+m_applyTime(0), m_evaluationTime(0)
 {
     for (unsigned int i = 0; i < Performance::PerformanceLevelCount; ++i) {
         m_childrenPerformance.push_back(0);
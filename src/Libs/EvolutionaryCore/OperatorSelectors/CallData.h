@@ -53,6 +53,12 @@ private:
     std::vector<double> m_childRewards;
 
     std::vector<unsigned int> m_childrenPerformance;
+    
+    // Wall-clock time spent in the operator's apply(), in seconds
+    double m_applyTime;
+    
+    // Time spent by the evaluator on the children of this call, in seconds
+    double m_evaluationTime;
 
 public:
     
@@ -90,6 +96,40 @@ public:
         m_childRewards.push_back(reward);
     }
     
+    /**
+     * Set the time spent in the operator's apply() during this call.
+     * @param seconds Wall-clock time in seconds.
+     * @throws nothing. If an exception is thrown, the execution is aborted.
+     */
+    void setApplyTime(double seconds) {
+        m_applyTime = seconds;
+    }
+    
+    /**
+     * Account for the evaluation of one of the children of this call.
+     * @param seconds Time spent by the evaluator on the child.
+     * @throws nothing. If an exception is thrown, the execution is aborted.
+     */
+    void addEvaluationTime(double seconds) {
+        m_evaluationTime += seconds;
+    }
+    
+    double getApplyTime() const {
+        return m_applyTime;
+    }
+    
+    double getEvaluationTime() const {
+        return m_evaluationTime;
+    }
+    
+    /**
+     * @return double Total cost of this call in seconds: the time spent in the
+     * operator plus the time spent evaluating its children.
+     */
+    double getCost() const {
+        return m_applyTime + m_evaluationTime;
+    }
+    
     /**
      * Returns the number of unique children that achieved a given performance level.
      * 
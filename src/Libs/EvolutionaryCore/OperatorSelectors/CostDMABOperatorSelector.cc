@@ -0,0 +1,110 @@
+/***********************************************************************\
+|                                                                       |
+| CostDMABOperatorSelector.cc                                           |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file CostDMABOperatorSelector.cc
+ *
+ */
+
+#include "CostDMABOperatorSelector.h"
+#include "Statistics.h"
+
+#include <cmath>
+
+namespace ugp3 {
+namespace core {
+    
+const std::string CostDMABOperatorSelector::XML_NAME = "CostDMAB";
+
+CostDMABOperatorSelector::CostDMABOperatorSelector(Statistics& stats)
+: DMABOperatorSelector(stats)
+{
+}
+
+void CostDMABOperatorSelector::step(PopulationParameters& params)
+{
+    _STACK;
+    
+    // Failed calls count too: their time is wasted
+    for (unsigned int i = 0; i < getDataCount(); ++i) {
+        auto& data = getData(i);
+        for (auto& cd: data.getCallData()) {
+            if (data.meanCost == 0) {
+                data.meanCost = cd->getCost();
+            } else {
+                data.meanCost += costSmoothing * (cd->getCost() - data.meanCost);
+            }
+        }
+    }
+    
+    DMABOperatorSelector::step(params);
+}
+
+double CostDMABOperatorSelector::getMABScore(const DMABData& data) const
+{
+    _STACK;
+    
+    Assert(data.getSelectable());
+    Assert(data.nExecutions != 0);
+    
+    unsigned int totalPending = 0;
+    double totalCost = 0;
+    unsigned int costCount = 0;
+    for (unsigned int i = 0; i < getDataCount(); ++i) {
+        if (getData(i).getSelectable()) {
+            totalPending += getData(i).pending;
+            if (getData(i).meanCost > 0) {
+                totalCost += getData(i).meanCost;
+                ++costCount;
+            }
+        }
+    }
+    
+    // Relative cost of this operator with respect to the average
+    double costRatio = 1;
+    if (costCount > 0) {
+        const double averageCost = totalCost / costCount;
+        costRatio = std::max(data.meanCost, minimumCostRatio * averageCost) / averageCost;
+    }
+    
+    /*
+     * Modified UCB1 formula (see PDMAB), with the reward per unit of cost.
+     */
+    double score = data.meanReward / costRatio
+        + C * sqrt(std::log(m_totalRounds + totalPending)
+            / (data.nExecutions + data.pending));
+    
+    LOG_VERBOSE << "Operator MAB score: " << score
+        << " with stats: (ne: " << data.nExecutions
+        << ") (mr: " << data.meanReward << ") (mc: " << data.meanCost
+        << ") (cr: " << costRatio << ") - " << data.getOperatorName()
+        << std::ends;
+    
+    return score;
+}
+
+}
+}
@@ -0,0 +1,79 @@
+/***********************************************************************\
+|                                                                       |
+| CostDMABOperatorSelector.h                                            |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file CostDMABOperatorSelector.h
+ * Dynamic Multi Armed Bandit operator selection that takes into account
+ * the cost of the operators.
+ */
+
+#ifndef HEADER_UGP3_CORE_COSTDMABOPERATORSELECTOR
+#define HEADER_UGP3_CORE_COSTDMABOPERATORSELECTOR
+
+#include <DMABOperatorSelector.h>
+
+namespace ugp3 {
+namespace core {
+
+/**
+ * Like PDMAB, but the exploitation term is the expected reward per second
+ * instead of the expected reward. The cost of a call is the time spent in
+ * the operator plus the time spent evaluating its children, so operators
+ * that are slow or produce many children must bring proportionally better
+ * offspring to be selected.
+ * 
+ * To keep the balance with the exploration term, the reward per second is
+ * multiplied by the average cost of the selectable operators: an operator
+ * with average cost keeps its mean reward.
+ */
+class CostDMABOperatorSelector : public DMABOperatorSelector
+{
+protected:
+    // Weight of the last call in the moving average of the cost
+    const double costSmoothing = 0.1;
+    
+    // Costs below this fraction of the average are rounded up (timer resolution)
+    const double minimumCostRatio = 0.01;
+    
+    virtual double getMABScore(const DMABData& data) const override;
+    
+public:
+    CostDMABOperatorSelector(Statistics& stats);
+    virtual ~CostDMABOperatorSelector() {}
+    
+    /**
+     * Update the costs of the operators, then the DMAB statistics.
+     */
+    virtual void step(PopulationParameters& params) override;
+    
+    static const std::string XML_NAME;
+    
+    virtual const std::string& getXmlName() const override { return XML_NAME; }
+};
+}
+}
+
+#endif // HEADER_UGP3_CORE_COSTDMABOPERATORSELECTOR
@@ -62,6 +62,7 @@ void DMABData::clear()
     maxDeviation = 0;
     meanDeviation = 0;
     pastRewards.clear();
+    meanCost = 0;
 }
 
 void DMABData::reset()
@@ -84,6 +85,7 @@ const std::string DMABData::XML_ATTRIBUTE_MEAN_REWARD = "mean_reward";
 const std::string DMABData::XML_ATTRIBUTE_MEAN_DEVIATION = "mean_deviation";
 const std::string DMABData::XML_ATTRIBUTE_MAX_DEVIATION = "max_deviation";
 const std::string DMABData::XML_ATTRIBUTE_PAST_REWARDS = "past_rewards";
+const std::string DMABData::XML_ATTRIBUTE_MEAN_COST = "mean_cost";
 
 void DMABData::writeInnerXml(std::ostream& output) const
 {
@@ -101,6 +103,7 @@ void DMABData::writeInnerXml(std::ostream& output) const
     XML_ATTRIBUTE_MEAN_DEVIATION << "=\"" << meanDeviation << "\" " <<
     XML_ATTRIBUTE_MAX_DEVIATION << "=\"" << maxDeviation << "\" " <<
     XML_ATTRIBUTE_PAST_REWARDS << "=\"" << pastRewardsString.str() << "\" " <<
+    XML_ATTRIBUTE_MEAN_COST << "=\"" << meanCost << "\" " <<
     "/>" << std::endl;
     
 }
@@ -133,6 +136,9 @@ void DMABData::readXml(const xml::Element& element)
             while (pastRewardsString >> r) {
                 pastRewards.push_back(r);
             }
+            if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_MEAN_COST)) {
+                meanCost = xml::Utility::attributeValueToDouble(*childElement, XML_ATTRIBUTE_MEAN_COST);
+            }
         }
         childElement = childElement->NextSiblingElement();
     }
@@ -57,8 +57,13 @@ private: // Data used by the DMAB operator selector
     // Reward window
     std::deque<double> pastRewards;
     
+    // moving average of the cost of a call (operator and evaluation of the children), in seconds.
+    // Not affected by the PH test.
+    double meanCost = 0.0;
+    
     friend class DMABOperatorSelector;
     friend class PDMABOperatorSelector;
+    friend class CostDMABOperatorSelector;
     friend class KappaRouletteOperatorSelector;
     
 protected:
@@ -70,6 +75,7 @@ protected:
     static const std::string XML_ATTRIBUTE_MEAN_DEVIATION;
     static const std::string XML_ATTRIBUTE_MAX_DEVIATION;
     static const std::string XML_ATTRIBUTE_PAST_REWARDS;
+    static const std::string XML_ATTRIBUTE_MEAN_COST;
     
 public:
     DMABData(const std::string& operatorName);
@@ -163,10 +163,14 @@ const std::vector<std::unique_ptr<CallData>>& Data::getCallData() const
 void Data::deleteCallData()
 {
     nCallsLastGen = 0;
+    applyTimeLastGen = 0;
+    evaluationTimeLastGen = 0;
     for (auto& cd: callData) {
         if (cd->getValidChildrenCount() > 0) {
             ++nCallsLastGen;
         }
+        applyTimeLastGen += cd->getApplyTime();
+        evaluationTimeLastGen += cd->getEvaluationTime();
     }
     callData.clear();
 }
@@ -331,12 +335,16 @@ void Data::writeInnerXml(ostream& output) const
 
 void Data::dumpStatistics(ostream& output) const
 {
-    output << "," << getNumberCallsLastGeneration();
+    output << "," << getNumberCallsLastGeneration()
+    << "," << getApplyTimeLastGeneration() * 1000
+    << "," << getEvaluationTimeLastGeneration() * 1000;
 }
 
 void Data::dumpStatisticsHeader(const string& name, ostream& output) const
 {
-    output << "," << name << "_OpUse_" << getOperatorName();
+    output << "," << name << "_OpUse_" << getOperatorName()
+    << "," << name << "_OpApplyTime_" << getOperatorName()
+    << "," << name << "_OpEvalTime_" << getOperatorName();
 }
 
 
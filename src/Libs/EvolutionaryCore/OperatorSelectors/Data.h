@@ -86,6 +86,10 @@ protected: // fields
     // Number of calls to this operator during the last generation
     unsigned int nCallsLastGen = 0;
     
+    // Time spent in the operator and evaluating its children during the last generation (seconds)
+    double applyTimeLastGen = 0;
+    double evaluationTimeLastGen = 0;
+    
     // True iff can be used during evolution
     bool enabled = true;
     
@@ -282,6 +286,13 @@ public: // getters and setters
     
     unsigned int getNumberCallsLastGeneration() const { return nCallsLastGen; }
     
+    /**
+     * Time spent in apply() by all the calls of the last generation, failed ones included,
+     * and time spent evaluating their children, in seconds.
+     */
+    double getApplyTimeLastGeneration() const { return applyTimeLastGen; }
+    double getEvaluationTimeLastGeneration() const { return evaluationTimeLastGen; }
+    
     /**
      * Print statistics about this operator to a CSV stream.
      */
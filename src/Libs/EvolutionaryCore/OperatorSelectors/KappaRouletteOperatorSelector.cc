@@ -32,6 +32,8 @@
 #include "KappaRouletteOperatorSelector.h"
 #include "Random.h"
 
+#include <cmath>
+
 namespace ugp3 {
 namespace core {
 
@@ -29,6 +29,7 @@
 #include "SelfAdaptiveOperatorSelector.h"
 #include "DMABOperatorSelector.h"
 #include "PDMABOperatorSelector.h"
+#include "CostDMABOperatorSelector.h"
 #include "KappaRouletteOperatorSelector.h"
 #include "Statistics.h"
 
@@ -48,6 +49,8 @@ unique_ptr< OperatorSelector > OperatorSelector::instanciate(
         return unique_ptr<OperatorSelector>(new DMABOperatorSelector(stats));
     } else if (name == PDMABOperatorSelector::XML_NAME) {
         return unique_ptr<OperatorSelector>(new PDMABOperatorSelector(stats));
+    } else if (name == CostDMABOperatorSelector::XML_NAME) {
+        return unique_ptr<OperatorSelector>(new CostDMABOperatorSelector(stats));
     } else if (name == KappaRouletteOperatorSelector::XML_NAME) {
         return unique_ptr<OperatorSelector>(new KappaRouletteOperatorSelector(stats));
     }
@@ -207,6 +207,11 @@ void Statistics::updateOperatorsStatistics(
         const std::string operatorName = child->getLineage().getOperatorName();
         CallData* callData = child->getLineage().getCallData();
         
+        // The evaluation of the child is part of the cost of the call, even if it was killed
+        if (callData) {
+            callData->addEvaluationTime(child->getEvaluationTime());
+        }
+        
         // Dead case: the child may have been killed during evaluation
         if (child->isDead()) {
             LOG_DEBUG << "The " << child->getDisplayTypeName() << " child " << child 
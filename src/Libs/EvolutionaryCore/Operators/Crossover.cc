@@ -77,13 +77,12 @@ void CrossoverOperator::collectLinkedSubGraphs(
             Assert(edge != nullptr);
          
             // retrieve the target information from the edge
-            const Tag& offsetTag = edge->getTag(Edge::offsetTagName);
-            const Tag& sectionTag = edge->getTag("section");
+            Assert(edge->hasFloatingOffset() && edge->hasFloatingSection());
 
             // retrieve the target prologue
-            CGraph* targetGraph = nodeContainer->getCGraph(sectionTag.getValue());
+            CGraph* targetGraph = nodeContainer->getCGraph(edge->getFloatingSection());
             CSubGraph& targetSubGraph = targetGraph->getSubGraph(
-                Convert::toUInt(offsetTag.getValue()));
+                (unsigned int)edge->getFloatingOffset());
             CNode& subGraphPrologue = targetSubGraph.getPrologue();
             Assert(subGraphPrologue.representsPrologue());
             
@@ -164,7 +163,7 @@ bool CrossoverOperator::transferSubGraph(
     // a map with <original_subgraph_prologue_id, cloned_subgraph_instance>
     // for every cloned subgraph, store the id of the prologue of the original subgraph and
     // associate it to the cloned subgraph
-    map<string, CSubGraph*> clonedSubGraphs;
+    map<tgraph::NodeHandle, CSubGraph*> clonedSubGraphs;
 
     // clone the sub-graphs
     set<CSubGraph*>::iterator iterator = subGraphs.begin();
@@ -180,7 +179,7 @@ bool CrossoverOperator::transferSubGraph(
         
         // create a copy of the sub-graph to be inserted in the target individual
         CSubGraph* clonedSubGraph = subGraph->clone().release();
-        clonedSubGraphs[subGraph->getPrologue().getId()] = clonedSubGraph;
+        clonedSubGraphs[subGraph->getPrologue().getHandle()] = clonedSubGraph;
 
         // get the graph that contains the sub-graph
         Assert(dynamic_cast<CGraph*> (subGraph->getParentContainer()) != nullptr);
@@ -259,7 +258,7 @@ bool CrossoverOperator::transferSubGraph(
 
     // rename all the old references (outer labels) on the cloned sub-graphs(so that the edges can be restored correctly)
     // from original prologue id to cloned prologue id
-    map<string, CSubGraph*>::iterator mapIterator = clonedSubGraphs.begin();
+    map<tgraph::NodeHandle, CSubGraph*>::iterator mapIterator = clonedSubGraphs.begin();
     while(mapIterator != clonedSubGraphs.end())
     {
         // for every cloned sub-graph ...
@@ -273,15 +272,13 @@ bool CrossoverOperator::transferSubGraph(
             {
                 tgraph::Node* node = (tgraph::Node*)cursor;
                 tgraph::Edge& edge = node->getEdge(i);
-                if(edge.getTo() == nullptr && edge.containsTag(Edge::targetTagName))
+                if(edge.getTo() == nullptr && edge.hasFloatingTarget())
                 // the edge is floating and has a record of the id of the previous attached node
                 {
-                    Tag& tag = edge.getTag(Edge::targetTagName);
-                    
                     // remap the target record to the id of the cloned subgraph
-                    if(tag.getValue() == mapIterator->first)
+                    if(edge.getFloatingTarget() == mapIterator->first)
                     {
-                        tag.setValue(newSubGraph->getPrologue().getId());
+                        edge.setFloatingTarget(newSubGraph->getPrologue().getHandle());
                     }
                 }
             }
@@ -33,6 +33,7 @@
  */
 
 #include <regex>
+#include <sstream>
 
 #include "ugp3_config.h"
 #include "Population.h"
@@ -48,6 +49,8 @@
 #include "RegexMatch.h"
 #include "Environment.h"
 #include "Distances.h"
+#include "RandomStream.h"
+#include "Genealogy.h"
 
 using namespace std;
 using namespace ugp3;
@@ -181,8 +184,13 @@ void Population::step()
     
     // start the next generation
     this->generation++;
+    m_operatorCallCount = 0;
     SETENV("UGP3_GENERATION", Convert::toString(this->generation));
     LOG_VERBOSE << "Performing generation step " << this->generation << ends;
+    
+    // Whatever is not measured by a more specific phase falls in OTHER
+    m_profiler.reset();
+    Profiler::Scope stepScope(m_profiler, Profiler::OTHER);
 
     if (getCandidateCount() == 0) {
         LOG_WARNING << "The population is empty" << ends;
@@ -197,37 +205,60 @@ void Population::step()
 
     LOG_VERBOSE << "Applying operators... " << ends;
 
-    LOG_INFO << "Generating offspring" << Progress(Progress::START) << ends;
-
-    PopulationParameters &params = this->getParameters();
-    OperatorSelector& selector = params.getActivations().getOperatorSelector();
-    selector.prepareForSelections();
-    
-    // The lambda parameter specifies the number of operators that should be
-    // applied to the population at each generation
-    unsigned int l = 0;
-    while (l < getParameters().getLambda()) {
-        // Select the best operator according to MAB algorithm
-        OperatorSelector::Result result = selector.select();
-        CallData* callData = result.data->newCallData();
-        vector<CandidateSolution*> generated = applyOperator(callData, result);
-        if (!generated.empty()) {
-            selector.success(result);
-            newGeneration.insert(newGeneration.end(), generated.begin(), generated.end());
-            ++l;
-        } else {
-            selector.failure(result);
+    // NOTE The scaled fitness does not change while breeding
+    // and the population changes only when the new generation is merged
+    m_selectionKeys.clear();
+    buildSelectionKeys(m_selectionKeys);
+    m_selectionKeys.sortRanges([this] (const CandidateSolution* a, const CandidateSolution* b) {
+        return compareForSelection(a, b);
+    });
+    
+    Profiler::Scope breedingScope(m_profiler, Profiler::BREEDING);
+    if (getParameters().getAsynchronousQueueDepth() > 0) {
+        newGeneration = breedAsynchronously();
+    } else {
+        // Offspring restored from an asynchronous run are no longer awaited
+        discardInFlightCandidates();
+        
+        LOG_INFO << "Generating offspring" << Progress(Progress::START) << ends;
+
+        PopulationParameters &params = this->getParameters();
+        OperatorSelector& selector = params.getActivations().getOperatorSelector();
+        selector.prepareForSelections();
+    
+        // The lambda parameter specifies the number of operators that should be
+        // applied to the population at each generation
+        unsigned int l = 0;
+        while (l < getParameters().getLambda()) {
+            // Select the best operator according to MAB algorithm
+            OperatorSelector::Result result = selector.select();
+            CallData* callData = result.data->newCallData();
+            vector<CandidateSolution*> generated = timedApplyOperator(callData, result);
+            if (!generated.empty()) {
+                selector.success(result);
+                newGeneration.insert(newGeneration.end(), generated.begin(), generated.end());
+                ++l;
+            } else {
+                selector.failure(result);
+            }
+            LOG_INFO << "Generating offspring" << Progress(l / (double) getParameters().getLambda()) << ends;
         }
-        LOG_INFO << "Generating offspring" << Progress(l / (double) getParameters().getLambda()) << ends;
+        LOG_INFO << "Generating offspring" << Progress::END << ends;
     }
-    LOG_INFO << "Generating offspring" << Progress::END << ends;
+    breedingScope.close();
+    m_selectionKeys.clear();
+    
     LOG_DEBUG << "Merging the new generation with its ancestors..." << ends;
     
-    // NOTE/DET Sort the new generation by id.
-    std::sort(newGeneration.begin(), newGeneration.end(), CandidateSolution::OrderById());
+    {
+        Profiler::Scope scope(m_profiler, Profiler::MERGE);
+        
+        // NOTE/DET Sort the new generation by id.
+        std::sort(newGeneration.begin(), newGeneration.end(), CandidateSolution::OrderById());
 
-    // Merge the new generation with its ancestors
-    mergeNewGeneration(newGeneration);
+        // Merge the new generation with its ancestors
+        mergeNewGeneration(newGeneration);
+    }
 
     // Dump all the population before starting evaluation, including zombies (if required)
     if (getParameters().getDumpBeforeEvaluation()) {
@@ -252,6 +283,9 @@ void Population::step()
      * NOTE It is (almost) useless to kill clones before the evaluations since
      * the evaluator already has caching.
      */
+    if (getParameters().getSurrogateScreening() && getParameters().getAsynchronousQueueDepth() == 0) {
+        screenOffspring(newGeneration);
+    }
     evaluateAndHandleClones();
     
     /*
@@ -265,8 +299,19 @@ void Population::step()
     checkFitnessValidity();
 #endif
     
+    if (getParameters().getSurrogateScreening()) {
+        trainSurrogate(newGeneration);
+    }
+    
     // Now collect the statistics and update the endogen parameters
     updateOperatorStatistics(newGeneration);
+    
+    // The fitness of the new candidates is known: they can enter the genealogy
+    if (Genealogy::isOpen()) {
+        for (auto candidate: newGeneration) {
+            Genealogy::record(*candidate, this->generation);
+        }
+    }
     this->getParameters().getActivations().step(getParameters());
     
     // Build a list of the best raw candidates and save them from future death
@@ -286,7 +331,10 @@ void Population::step()
 
     // Perform allopatric selection and resize the population
     // discarding the individuals with low fitness or advanced age
-    slaughtering();
+    {
+        Profiler::Scope scope(m_profiler, Profiler::SLAUGHTERING);
+        slaughtering();
+    }
     
     // Deal with zombies from previous generations
     handleZombies();
@@ -296,14 +344,18 @@ void Population::step()
     if (extincted())
         return;
     
-    /*
-     * Update scaled fitness and entropy for the next generation,
-     * based on the real state of the population.
-     */
-    prepareForCommit();
-    
-    // Save a reference to the best and worst individuals
-    commit();
+    {
+        Profiler::Scope scope(m_profiler, Profiler::COMMIT);
+        
+        /*
+         * Update scaled fitness and entropy for the next generation,
+         * based on the real state of the population.
+         */
+        prepareForCommit();
+        
+        // Save a reference to the best and worst individuals
+        commit();
+    }
     
     // only once every EPOCH generations
     if (this->getGeneration() % EPOCH == 0) {
@@ -324,6 +376,192 @@ void Population::step()
     Assert(getLiveCandidateCount() <= getParameters().getMu());
 }
 
+std::vector<CandidateSolution*> Population::breedAsynchronously()
+{
+    _STACK;
+    
+    if (!supportsAsynchronousEvaluation()) {
+        throw Exception("Asynchronous evaluation is not supported by the population \"" + getName() + "\".", LOCATION);
+    }
+    
+    PopulationParameters& params = getParameters();
+    Evaluator& evaluator = params.getEvaluator();
+    OperatorSelector& selector = params.getActivations().getOperatorSelector();
+    const unsigned int lambda = params.getLambda();
+    const unsigned int queueDepth = std::max(params.getAsynchronousQueueDepth(), lambda);
+    
+    /*
+     * NOTE/DET Breeding only depends on the seed and on the population as it
+     * was at the beginning of the generation. Which offspring are merged,
+     * however, depends on the order in which their evaluations complete, and
+     * the population of the next generation depends on them: two runs with the
+     * same seed are the same run only when the event log is replayed.
+     */
+    // The evaluations of the offspring read from a status file were interrupted
+    if (m_inFlightRestored) {
+        for (auto& inFlight: m_inFlight) {
+            evaluator.evaluate(*inFlight.first);
+        }
+        m_inFlightRestored = false;
+    }
+    
+    // The first carriedOver candidates come from the previous generations
+    const std::size_t carriedOver = m_inFlight.size();
+    LOG_INFO << "Generating offspring" << Progress(Progress::START) << ends;
+    selector.prepareForSelections();
+    std::size_t bred = 0;
+    while (m_inFlight.size() < queueDepth) {
+        OperatorSelector::Result result = selector.select();
+        CallData* callData = result.data->newCallData();
+        vector<CandidateSolution*> generated = timedApplyOperator(callData, result);
+        if (!generated.empty()) {
+            selector.success(result);
+            for (auto candidate: generated) {
+                m_inFlight.emplace_back(candidate, result.data);
+                evaluator.evaluate(*candidate);
+            }
+            bred += generated.size();
+        } else {
+            selector.failure(result);
+        }
+    }
+    LOG_INFO << "Generating offspring" << Progress::END << ends;
+    LOG_VERBOSE << "Bred " << bred << " offspring, " << m_inFlight.size() << " are being evaluated" << ends;
+    
+    std::unordered_set<std::string> replayIds;
+    bool replay = params.getAsynchronousReplay() && readReplayEvent(replayIds);
+    
+    // Wait for lambda offspring (or the replayed ones) to be evaluated
+    std::vector<CandidateSolution*> newGeneration;
+    std::vector<std::pair<CandidateSolution*, Data*>> stillInFlight;
+    LOG_INFO << "Evaluating offspring" << Progress(0) << ends;
+    Profiler::Scope evaluationScope(m_profiler, Profiler::EVALUATION);
+    while (true) {
+        newGeneration.clear();
+        for (auto& inFlight: m_inFlight) {
+            if (replay ? replayIds.count(inFlight.first->getId()) && evaluator.isEvaluated(*inFlight.first)
+                       : newGeneration.size() < lambda && evaluator.isEvaluated(*inFlight.first)) {
+                newGeneration.push_back(inFlight.first);
+            }
+        }
+        if (newGeneration.size() == (replay ? replayIds.size() : lambda)) {
+            break;
+        }
+        LOG_INFO << "Evaluating offspring" << Progress(newGeneration.size() / (double) (replay ? replayIds.size() : lambda)) << ends;
+        evaluator.flushSome();
+    }
+    evaluationScope.close();
+    LOG_INFO << "Evaluating offspring" << Progress::END << ends;
+    
+    /*
+     * The offspring carried over from a previous generation lost their
+     * operator statistics (deleted at the end of each generation) and may
+     * have lost their parents: bind them to a new call of their operator,
+     * so that they are accounted for in the generation they are merged.
+     * Their evaluation is over, so the evaluator no longer touches them.
+     * The others will be merged in a following generation.
+     */
+    for (std::size_t i = 0; i < m_inFlight.size(); i++) {
+        auto& inFlight = m_inFlight[i];
+        if (std::find(newGeneration.begin(), newGeneration.end(), inFlight.first) == newGeneration.end()) {
+            stillInFlight.push_back(inFlight);
+        } else if (i < carriedOver) {
+            inFlight.first->step(false);
+            CallData* callData = inFlight.second->newCallData();
+            callData->setValidChildrenCount(1);
+            inFlight.first->getLineage().setCallData(callData);
+        }
+    }
+    m_inFlight.swap(stillInFlight);
+    
+    if (!params.getAsynchronousEventLog().empty() && !replay) {
+        if (!m_eventLog.is_open()) {
+            // A resumed run goes on with the log it may have just replayed
+            m_eventLog.open(params.getAsynchronousEventLog(), std::ios::app);
+            if (!m_eventLog.is_open()) {
+                throw Exception("Cannot access file \"" + params.getAsynchronousEventLog() + "\"", LOCATION);
+            }
+        }
+        m_eventLog << getName() << " " << generation;
+        for (auto candidate: newGeneration) {
+            m_eventLog << " " << candidate->getId();
+        }
+        m_eventLog << endl;
+    }
+    
+    return newGeneration;
+}
+
+bool Population::readReplayEvent(std::unordered_set<std::string>& ids)
+{
+    const std::string& fileName = getParameters().getAsynchronousEventLog();
+    if (!m_eventReplay.is_open()) {
+        m_eventReplay.open(fileName);
+        if (!m_eventReplay.is_open()) {
+            throw Exception("Cannot access file \"" + fileName + "\"", LOCATION);
+        }
+    }
+    
+    // Skip the events of the other populations, and those of the generations
+    // before the one a resumed run starts from
+    std::string line;
+    while (std::getline(m_eventReplay, line)) {
+        std::istringstream event(line);
+        std::string populationName;
+        unsigned int eventGeneration;
+        event >> populationName >> eventGeneration;
+        if (populationName != getName() || eventGeneration < generation) {
+            continue;
+        }
+        if (eventGeneration != generation) {
+            throw Exception("The event log \"" + fileName + "\" does not match this run: expected generation "
+                            + Convert::toString(generation) + ", found " + Convert::toString(eventGeneration) + ".", LOCATION);
+        }
+        std::string id;
+        while (event >> id) {
+            if (std::find_if(m_inFlight.begin(), m_inFlight.end(), [&] (const std::pair<CandidateSolution*, Data*>& inFlight) {
+                    return inFlight.first->getId() == id;
+                }) == m_inFlight.end()) {
+                throw Exception("The event log \"" + fileName + "\" does not match this run: "
+                                "no candidate \"" + id + "\" is being evaluated.", LOCATION);
+            }
+            ids.insert(id);
+        }
+        return true;
+    }
+    
+    LOG_WARNING << "The event log \"" << fileName << "\" is over, the evolution goes on without replay." << ends;
+    getParameters().setAsynchronousReplay(false);
+    return false;
+}
+
+void Population::discardInFlightCandidates()
+{
+    if (m_inFlight.empty()) {
+        return;
+    }
+    
+    // The evaluator still refers to these candidates
+    getParameters().getEvaluator().cancel();
+    for (auto& inFlight: m_inFlight) {
+        delete inFlight.first;
+    }
+    m_inFlight.clear();
+}
+
+std::vector<CandidateSolution*> Population::timedApplyOperator(
+    CallData* callData, const OperatorSelector::Result& selected)
+{
+    Profiler::Scope scope(m_profiler, Profiler::OPERATORS, &selected.data->getOperatorName());
+    // NOTE/DET Each call draws from its own stream: the offspring of a call
+    // do not depend on the numbers drawn by the other calls
+    Random::StreamScope streamScope(RandomStream::hash(getName()), this->generation, m_operatorCallCount++);
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<CandidateSolution*> newCandidates = applyOperator(callData, selected);
+    callData->setApplyTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return newCandidates;
+}
+
 std::vector<CandidateSolution*> Population::applyOperator(
     CallData* callData,
     const OperatorSelector::Result& selected)
@@ -473,6 +711,18 @@ void Population::showStatistics(void) const
     // write information about number of evaluations and time elapsed
     getParameters().getEvaluator().showStatistics();
     
+    if (getParameters().getSurrogateScreening() && m_surrogate.getScreenedCount() > 0)
+    {
+        LOG_INFO << "Surrogate: " << m_surrogate.getDiscardedCount() << " of " << m_surrogate.getScreenedCount()
+        << " offspring discarded without evaluation; mean error " << m_surrogate.getMeanError()
+        << ", rank agreement " << 100 * m_surrogate.getRankAgreement() << "%" << ends;
+    }
+    
+    if (MemoryUsage::getEnabled())
+    {
+        LOG_INFO << "Memory: about " << updateMemoryUsage().toString() << ends;
+    }
+    
     chrono::hours hours = chrono::duration_cast<chrono::hours>(getAlgorithm().getElapsedTime());
     chrono::minutes minutes = chrono::duration_cast<chrono::minutes>(getAlgorithm().getElapsedTime() - hours);
     chrono::seconds seconds = chrono::duration_cast<chrono::seconds>(getAlgorithm().getElapsedTime() - minutes);
@@ -1101,7 +1351,7 @@ CandidateSolution* Population::assimilate(std::string fileName, ugp3::constraint
 						// two tags are added to an edge: the name of the parameter it refers to, and the destination;
 						// the destination can be expressed in several ways, but here we are using an offset 
 						edge->addTag( tgraph::Edge::parameterTagName, labelParameters[0]->getName() ); 
-						edge->addTag( tgraph::Edge::offsetTagName, offsetValue.str() );
+						edge->setFloatingOffset( textToAssimilate[l].referenceTo - l );
 						node->addEdge( *edge );
 						
 						LOG_DEBUG << "Offset value is \"" << offsetValue.str() << "\"" << ends;
@@ -1239,6 +1489,29 @@ void Population::dumpStatistics(ostream& output) const
     {
         params.getActivations().getData(i).dumpStatistics(output);
     }
+    
+    // TIME SPENT IN EACH PHASE (ms)
+    if (Profiler::getEnabled())
+    {
+        for (unsigned int phase = Profiler::OTHER; phase < Profiler::DUMP_STATE; phase++)
+        {
+            output << "," << m_profiler.getMilliseconds((Profiler::Phase) phase);
+        }
+        for (unsigned int i = 0; i < params.getActivations().getDataCount(); i++) 
+        {
+            output << "," << m_profiler.getOperatorMilliseconds(params.getActivations().getData(i).getOperatorName());
+        }
+    }
+    
+    // MEMORY RETAINED (bytes), as computed by showStatistics()
+    if (MemoryUsage::getEnabled())
+    {
+        for (unsigned int category = MemoryUsage::CANDIDATES; category < MemoryUsage::CATEGORY_COUNT; category++)
+        {
+            output << "," << m_memoryUsage.getBytes((MemoryUsage::Category) category);
+        }
+        output << "," << m_memoryUsage.getNodeCount();
+    }
 }
 
 
@@ -1262,6 +1535,64 @@ void Population::dumpStatisticsHeader(ostream& output) const
     {
         params.getActivations().getData(i).dumpStatisticsHeader(name, output);
     }
+    
+    // TIME SPENT IN EACH PHASE (ms)
+    if (Profiler::getEnabled())
+    {
+        for (unsigned int phase = Profiler::OTHER; phase < Profiler::DUMP_STATE; phase++)
+        {
+            output << "," << this->name << "_Time" << Profiler::getPhaseName((Profiler::Phase) phase);
+        }
+        for (unsigned int i = 0; i < params.getActivations().getDataCount(); i++) 
+        {
+            output << "," << this->name << "_OpTime_" << params.getActivations().getData(i).getOperatorName();
+        }
+    }
+    
+    // MEMORY RETAINED (bytes)
+    if (MemoryUsage::getEnabled())
+    {
+        for (unsigned int category = MemoryUsage::CANDIDATES; category < MemoryUsage::CATEGORY_COUNT; category++)
+        {
+            output << "," << this->name << "_Mem" << MemoryUsage::getCategoryName((MemoryUsage::Category) category);
+        }
+        output << "," << this->name << "_MemNodes";
+    }
+}
+
+void Population::computeMemoryUsage(MemoryUsage& usage) const
+{
+    usage.add(MemoryUsage::CACHE, getParameters().getEvaluator().getCacheMemoryUsage());
+    usage.add(MemoryUsage::MESSAGES, m_surrogate.getMemoryUsage());
+}
+
+void Population::trainSurrogate(const vector<CandidateSolution*>& newGeneration)
+{
+    // Only the populations that screen their offspring have samples
+    if (m_surrogate.getSampleCount() == 0) {
+        return;
+    }
+    
+    Profiler::Scope scope(m_profiler, Profiler::SURROGATE);
+    
+    if (m_surrogate.assess() > 0) {
+        LOG_VERBOSE << "Surrogate model: mean error " << m_surrogate.getLastMeanError()
+        << ", rank agreement " << 100 * m_surrogate.getLastRankAgreement()
+        << "% over " << m_surrogate.getLastAssessed() << " evaluated offspring" << ends;
+    }
+    // The placeholder fitness of the raced-out candidates is not a measure
+    for (auto candidate: newGeneration) {
+        if (candidate->getRawFitness().getIsValid() && !candidate->isRacedOut()) {
+            m_surrogate.train(*candidate);
+        }
+    }
+}
+
+const MemoryUsage& Population::updateMemoryUsage() const
+{
+    m_memoryUsage.reset();
+    computeMemoryUsage(m_memoryUsage);
+    return m_memoryUsage;
 }
 
 
@@ -1276,7 +1607,7 @@ bool Population::useResultOrTakeOldestOrTakeFirstId(int result, const CandidateS
     }
     // Same age. To make the ordering deterministic, we order by IDs.
     // Those are unique. We get a strict total ordering.
-    return a->getId() < b->getId();
+    return a->getNumericId() < b->getNumericId();
 }
 
 bool Population::compareClones(const CandidateSolution* a, const CandidateSolution* b) const
@@ -1297,9 +1628,24 @@ bool Population::compareHeroes(const CandidateSolution* a, const CandidateSoluti
 
 bool Population::compareForSelection(const CandidateSolution* a, const CandidateSolution* b) const
 {
+    if (m_selectionKeys.contains(a) && m_selectionKeys.contains(b)) {
+        return m_selectionKeys.compare(a, b);
+    }
     return useResultOrTakeOldestOrTakeFirstId(a->getFitness().compareTo(b->getFitness()), a, b);
 }
 
+bool Population::cannotSurvive(const CandidateSolution& rival, const std::vector<double>& bestReachable) const
+{
+    /*
+     * The candidate is new: no scaling applies to its fitness yet, and it
+     * has no selection key. The rival is older, so it wins the ties
+     * (see useResultOrTakeOldestOrTakeFirstId).
+     */
+    Fitness bound;
+    bound.setValues(bestReachable);
+    return rival.getFitness().compareTo(bound) >= 0;
+}
+
 bool Population::compareForFitnessHole(const CandidateSolution* a, const CandidateSolution* b) const
 {
     return useResultOrTakeOldestOrTakeFirstId(a->getDeltaEntropy().compareTo(b->getDeltaEntropy()), a, b);
@@ -1370,11 +1716,48 @@ unique_ptr<Population> Population::fromParametersFile(
     } 
 }
 
-std::tuple<double, double> Population::computeSharingApport(Group* a, Group* b)
+void Population::showApproximateEntropicError(const string& label, const vector<const CandidateSolution*>& candidates) const
 {
-    LOG_DEBUG << "Computing entropic distance between groups " << *a << " and " << *b << ends;
+    double absoluteError = 0;
+    double relativeError = 0;
+    double maxError = 0;
+    unsigned int pairs = 0;
+    unsigned int relativePairs = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        for (size_t j = i + 1; j < candidates.size(); ++j) {
+            double exact = Distances::entropic(candidates[i]->getMessage(), candidates[j]->getMessage());
+            double approximate = Distances::approximateEntropic(candidates[i]->getSketch(), candidates[j]->getSketch());
+            double error = std::abs(approximate - exact);
+            absoluteError += error;
+            maxError = std::max(maxError, error);
+            ++pairs;
+            if (exact > 0) {
+                relativeError += error / exact;
+                ++relativePairs;
+            }
+        }
+    }
     
-    double distance = ugp3::Distances::entropic(a->getMessage(), b->getMessage());
+    if (pairs > 0) {
+        LOG_INFO << "[" << label << "] Approximate entropic distance (sketch size " << MessageSketch::getSize()
+        << "): mean error " << absoluteError / pairs
+        << " (" << (relativePairs > 0 ? 100 * relativeError / relativePairs : 0) << "%)"
+        << ", max error " << maxError << " over " << pairs << " pairs" << ends;
+    }
+}
+
+std::tuple<double, double> Population::computeSharingApport(Group* a, Group* b)
+{
+    // Groups always use the entropic distance, approximated when the
+    // population estimates it for its individuals
+    double distance;
+    if (this->getParameters().getFitnessSharingDistance() == "approximateEntropic") {
+        LOG_DEBUG << "Computing approximate entropic distance between groups " << *a << " and " << *b << ends;
+        distance = ugp3::Distances::approximateEntropic(a->getSketch(), b->getSketch());
+    } else {
+        LOG_DEBUG << "Computing entropic distance between groups " << *a << " and " << *b << ends;
+        distance = ugp3::Distances::entropic(a->getMessage(), b->getMessage());
+    }
     
     double apport = -1;
     double radius = dynamic_cast<GroupPopulationParameters&>(getParameters()).getGroupFitnessSharingRadius();
@@ -1417,6 +1800,13 @@ std::tuple<double, double> Population::computeSharingApport(Individual* i1, Indi
         
         distance = ugp3::Distances::entropic(i1->getMessage(), i2->getMessage());
     }
+    // estimate of the entropic distance from the sketches of the messages
+    else if( this->getParameters().getFitnessSharingDistance() == "approximateEntropic")
+    {
+        LOG_DEBUG << "Computing approximate entropic distance between individual " << *i1 << " and individual " << *i2 << ends;
+        
+        distance = ugp3::Distances::approximateEntropic(i1->getSketch(), i2->getSketch());
+    }
     // add other types of phenotypic/genotypic distances here...
     else
     {
@@ -42,10 +42,12 @@
 #define EPOCH 1
 
 #include <vector>
+#include <algorithm>
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
 #include <forward_list>
+#include <fstream>
 
 // headers from shared module
 #include "XMLIFace.h"
@@ -57,6 +59,10 @@
 #include "PopulationParameters.h"
 #include "Entropy.h"
 #include "OperatorSelector.h"
+#include "SelectionKeys.h"
+#include "Profiler.h"
+#include "MemoryUsage.h"
+#include "Surrogate.h"
 #include "EnhancedIndividual.h"
 #include "MOIndividual.h"
 #include "GEIndividual.h"
@@ -115,6 +121,36 @@ protected:
     
     // A list of candidates that must be kept in the population, dead or alive.
     std::vector<const CandidateSolution*> m_bloodMagicWaitingList;
+    
+    /*
+     * Asynchronous evaluation: offspring that have been bred and sent to the
+     * evaluator but not merged yet, in breeding order, along with the
+     * statistics of the operator that created them.
+     */
+    std::vector<std::pair<CandidateSolution*, Data*>> m_inFlight;
+    
+    // True when the offspring in flight were read from a status file and
+    // have not been sent to the evaluator yet
+    bool m_inFlightRestored = false;
+    
+    // Keys used by compareForSelection() and selection index, while breeding
+    SelectionKeys m_selectionKeys;
+    
+    // Time spent in each phase of the current generation
+    Profiler m_profiler;
+    
+    // Operator calls in the current generation, to select their random streams
+    unsigned int m_operatorCallCount = 0;
+    
+    // Memory retained by the population, updated by showStatistics()
+    mutable MemoryUsage m_memoryUsage;
+    
+    // Model of the fitness used to screen the offspring, when enabled
+    Surrogate m_surrogate;
+    
+    // Event log of the asynchronous evaluation, either recorded or replayed.
+    std::ofstream m_eventLog;
+    std::ifstream m_eventReplay;
 
 protected: // constructors
     /** 
@@ -197,12 +233,52 @@ protected: // step() internals
     virtual std::vector<CandidateSolution*> applyOperator(
         CallData* callData, const OperatorSelector::Result& selected);
     
+    /**
+     * Call applyOperator() and add its duration to the time of the operator
+     * (in the profiler and in the call data). The operator draws its random
+     * numbers from a stream derived from the population, the generation and
+     * the index of the call.
+     */
+    std::vector<CandidateSolution*> timedApplyOperator(
+        CallData* callData, const OperatorSelector::Result& selected);
+    
     /**
      * Merge the candidates of the given vector into the population.
      * The vector can contain individuals and groups, for group evolution.
      */
     virtual void mergeNewGeneration(const std::vector<CandidateSolution*>& newGeneration) = 0;
     
+    /**
+     * Asynchronous counterpart of the breeding loop: keep the evaluator fed with
+     * up to queueDepth offspring, wait for lambda of them to be evaluated and
+     * return those. The others stay in flight for the next generations.
+     */
+    std::vector<CandidateSolution*> breedAsynchronously();
+    
+    /**
+     * Read the ids of the offspring to merge at this generation from the
+     * event log. Returns false when there is nothing left to replay.
+     */
+    bool readReplayEvent(std::unordered_set<std::string>& ids);
+    
+    /**
+     * Cancel the evaluations still in flight and delete their candidates.
+     * Must be called by subclasses before the parameters are destroyed.
+     */
+    void discardInFlightCandidates();
+    
+    /**
+     * @return False if this kind of population cannot be evolved asynchronously.
+     */
+    virtual bool supportsAsynchronousEvaluation() const { return true; }
+    
+    /**
+     * Fill the selection keys with the candidates that can be selected as
+     * parents. Called before breeding, the keys are cleared right after.
+     * The default implementation leaves them empty.
+     */
+    virtual void buildSelectionKeys(SelectionKeys&) const {}
+    
 public: // step() internals
     /**
      * Invalidate all fitness values.
@@ -216,6 +292,13 @@ public: // step() internals
      */
     virtual void evaluateAndHandleClones() = 0;
     
+    /**
+     * Surrogate pre-screening: kill the new offspring that the surrogate
+     * model does not rank among the best, before they are evaluated.
+     * The default implementation screens nothing.
+     */
+    virtual void screenOffspring(const std::vector<CandidateSolution*>&) {}
+    
     /**
      * Check that all fitness values of all non dead candidates of the
      * population are valid, using assertions.
@@ -332,6 +415,28 @@ protected: // Population toolbox. Use these templates instead of duplicating cod
     template <typename RandomAccessIterator>
     void promoteHeroesAndAge(RandomAccessIterator begin, RandomAccessIterator end);
     
+    /**
+     * Racing evaluation: find the mu-th candidate of the range according to
+     * compareForSelection(), among the live candidates with a valid fitness.
+     * @return nullptr if there are less than mu such candidates.
+     */
+    template <typename ForwardIterator>
+    const CandidateSolution* findRacingRival(ForwardIterator begin, ForwardIterator end, unsigned int mu) const;
+    
+    /**
+     * Surrogate pre-screening of the new offspring of a population whose
+     * candidates are in the given range. The first time, the surrogate model
+     * learns from the live evaluated candidates of the range.
+     */
+    template <typename ForwardIterator>
+    void screenWithSurrogate(ForwardIterator begin, ForwardIterator end, const std::vector<CandidateSolution*>& newGeneration);
+    
+    /**
+     * Assess the predictions of the surrogate model on the new offspring
+     * that were evaluated, then add them to its samples.
+     */
+    void trainSurrogate(const std::vector<CandidateSolution*>& newGeneration);
+    
     /** 
      * Makes the allopatric selection in the given range: in each group
      * of candidates that share the same allopatric tag, we keep the one with
@@ -354,6 +459,14 @@ protected: // Population toolbox. Use these templates instead of duplicating cod
     template <typename ForwardIterator>
     double computeAverageDeltaEntropy(ForwardIterator begin, ForwardIterator end) const;
     
+    /**
+     * Logs how far the approximate entropic distance is from the exact one,
+     * over all the pairs of (up to) the first 64 live candidates of the range.
+     */
+    template <typename ForwardIterator>
+    void showApproximateEntropicError(const std::string& label, ForwardIterator begin, ForwardIterator end) const;
+    void showApproximateEntropicError(const std::string& label, const std::vector<const CandidateSolution*>& candidates) const;
+    
     /** 
      * Returns the average age of the given range.
      * @returns double The average age of the range.
@@ -513,6 +626,17 @@ public:
     virtual void dumpStatistics(std::ostream& output) const;
     virtual void dumpStatisticsHeader(std::ostream& output) const;
     
+    /**
+     * Add the memory retained by the candidates of the population and by
+     * its evaluation cache to the given accounting.
+     */
+    virtual void computeMemoryUsage(MemoryUsage& usage) const;
+    
+    /**
+     * Recompute the memory accounting of the population.
+     */
+    const MemoryUsage& updateMemoryUsage() const;
+    
     /**
      * Return the average age of the candidates.
      */
@@ -624,13 +748,29 @@ public: // Comparison functions to tune some selection mechanisms
      */
     virtual bool compareOperatorPerformance(const CandidateSolution* a, const CandidateSolution* b) const;
     
+public: // racing evaluation
+    /**
+     * The candidate that the given (new) candidate must beat to survive the
+     * next slaughtering, or nullptr if the population cannot tell: the
+     * evaluation of the candidate must then be completed.
+     * The default implementation does not support racing.
+     */
+    virtual const CandidateSolution* getRacingRival(const CandidateSolution&) const { return nullptr; }
+    
+    /**
+     * @param bestReachable Best fitness that the candidate can still reach.
+     * @return True if, even with that fitness, a new candidate would not be
+     * selected before the rival by compareForSelection().
+     */
+    bool cannotSurvive(const CandidateSolution& rival, const std::vector<double>& bestReachable) const;
+    
 public: // setters, getters
     /** 
      * Sets the name of this population
      * @param value Name of the population
      * @throws nothing. if an exception is thrown, the execution is aborted.
      */
-    void setName(const std::string& value) noexcept { name = value; }
+    void setName(const std::string& value) { name = value; m_profiler.setName(value); }
     
     /** 
      * Returns the current generation of the population
@@ -638,6 +778,12 @@ public: // setters, getters
      */
     unsigned int getGeneration() const { return generation; }
     
+    /**
+     * Returns the selection keys and index of the candidates that can be
+     * selected as parents. Empty when the population is not breeding.
+     */
+    const SelectionKeys& getSelectionKeys() const { return m_selectionKeys; }
+    
     /** 
      * Returns the evolutionary algorithm used
      * @returns EvolutionaryAlgorithm The algorithm used
@@ -793,6 +939,70 @@ void Population::promoteHeroesAndAge(RandomAccessIterator begin, RandomAccessIte
     }
 }
 
+template <typename ForwardIterator>
+const CandidateSolution* Population::findRacingRival(ForwardIterator begin, ForwardIterator end, unsigned int mu) const
+{
+    // Candidates evaluated in this generation do not have a scaled fitness yet
+    std::vector<const CandidateSolution*> rivals;
+    for (auto it = begin; it != end; ++it) {
+        if ((*it)->isAlive() && (*it)->getRawFitness().getIsValid() && (*it)->getFitness().getIsValid()) {
+            rivals.push_back(*it);
+        }
+    }
+    if (mu == 0 || rivals.size() < mu) {
+        return nullptr;
+    }
+    
+    std::nth_element(rivals.begin(), rivals.begin() + (mu - 1), rivals.end(),
+        [this] (const CandidateSolution* a, const CandidateSolution* b) {
+            return compareForSelection(a, b);
+        });
+    return rivals[mu - 1];
+}
+
+template <typename ForwardIterator>
+void Population::screenWithSurrogate(ForwardIterator begin, ForwardIterator end, const std::vector<CandidateSolution*>& newGeneration)
+{
+    Profiler::Scope scope(m_profiler, Profiler::SURROGATE);
+    
+    m_surrogate.setNeighbours(getParameters().getSurrogateNeighbours());
+    m_surrogate.setCapacity(getParameters().getSurrogateTrainingSize());
+    
+    // First screening, or first one after a recovery
+    if (m_surrogate.getSampleCount() == 0) {
+        for (auto it = begin; it != end; ++it) {
+            if ((*it)->isAlive() && (*it)->getRawFitness().getIsValid()) {
+                m_surrogate.train(**it);
+            }
+        }
+    }
+    if (!m_surrogate.isReady()) {
+        LOG_VERBOSE << "The surrogate model has only " << m_surrogate.getSampleCount()
+        << " samples: all the offspring will be evaluated" << std::ends;
+        return;
+    }
+    
+    // The candidates found in the cache cost nothing to evaluate
+    Evaluator& evaluator = getParameters().getEvaluator();
+    std::vector<CandidateSolution*> screened;
+    for (auto candidate: newGeneration) {
+        if (!candidate->isDead() && !candidate->getRawFitness().getIsValid() && !evaluator.isCached(*candidate)) {
+            screened.push_back(candidate);
+        }
+    }
+    if (screened.empty()) {
+        return;
+    }
+    
+    const std::vector<CandidateSolution*>& discarded = m_surrogate.screen(screened, getParameters().getSurrogateFraction());
+    for (auto candidate: discarded) {
+        LOG_DEBUG << "The surrogate model discards the " << candidate->getDisplayTypeName() << " " << *candidate << std::ends;
+        candidate->setDeath(getGeneration());
+    }
+    LOG_VERBOSE << "Surrogate screening: " << screened.size() << " of " << screened.size() + discarded.size()
+    << " new offspring sent to the evaluator" << std::ends;
+}
+
 template <typename RandomAccessIterator>
 RandomAccessIterator Population::regroupAndSkipDeadCandidates(RandomAccessIterator begin, RandomAccessIterator end)
 {
@@ -952,9 +1162,23 @@ double Population::computeAverageDeltaEntropy(ForwardIterator begin, ForwardIter
     return deltaEntropy;
 }
 
+template <typename ForwardIterator>
+void Population::showApproximateEntropicError(const std::string& label, ForwardIterator begin, ForwardIterator end) const
+{
+    std::vector<const CandidateSolution*> candidates;
+    for (auto it = begin; it != end && candidates.size() < 64; ++it) {
+        if ((*it)->isAlive()) {
+            candidates.push_back(*it);
+        }
+    }
+    showApproximateEntropicError(label, candidates);
+}
+
 template <typename RandomAccessIterator>
 std::size_t Population::runEvaluator(RandomAccessIterator begin, RandomAccessIterator end)
 {
+    Profiler::Scope scope(m_profiler, Profiler::EVALUATION);
+    
     // NOTE/DET We sort by id to get deterministic results.
     std::sort(begin, end, CandidateSolution::OrderById());
     
@@ -972,9 +1196,12 @@ std::size_t Population::runEvaluator(RandomAccessIterator begin, RandomAccessIte
     }
 
     // force the evaluation of the candidates
-    evaluator.flush([&] (double progress) {
-        LOG_INFO << "Evaluating " << evaluatedCandidates << " " << TypeName<decltype(*begin)>::name << "s" << Progress(progress) << ends;
-    });
+    // NOTE in asynchronous mode, flushing with no request would wait for the offspring in flight
+    if (evaluatedCandidates > 0) {
+        evaluator.flush([&] (double progress) {
+            LOG_INFO << "Evaluating " << evaluatedCandidates << " " << TypeName<decltype(*begin)>::name << "s" << Progress(progress) << ends;
+        });
+    }
     
     evaluator.step(generation + 1);
     
@@ -1006,6 +1233,8 @@ void Population::handleClones(ForwardIterator begin, ForwardIterator end)
 template <typename RandomAccessIterator>
 void Population::detectAndHandleClones(RandomAccessIterator begin, RandomAccessIterator end)
 {
+    Profiler::Scope scope(m_profiler, Profiler::CLONES);
+    
     begin = regroupAndSkipDeadCandidates(begin, end);
     
     string operation = string("Detecting ") + TypeName<decltype(*begin)>::name + " clones";
@@ -1071,6 +1300,8 @@ void Population::detectAndHandleClones(RandomAccessIterator begin, RandomAccessI
 template <typename RandomAccessIterator>
 double Population::updateDeltaEntropy(RandomAccessIterator begin, RandomAccessIterator end)
 {
+    Profiler::Scope scope(m_profiler, Profiler::ENTROPY);
+    
     // Only consider live individuals in the entropy
     begin = regroupAndSkipNotAliveCandidates(begin, end);
     
@@ -1142,6 +1373,8 @@ void Population::describePopulation(const std::string& context, ForwardIterator
 template <typename RandomAccessIterator>
 void Population::shareFitness(RandomAccessIterator begin, RandomAccessIterator end)
 {
+    Profiler::Scope scope(m_profiler, Profiler::SHARING);
+    
     begin = regroupAndSkipDeadCandidates(begin, end);
     
     // NOTE/DET We sort by id to get deterministic results.
@@ -1237,9 +1470,7 @@ void Population::shareFitness(RandomAccessIterator begin, RandomAccessIterator e
             LOG_VERBOSE << "Before: " << *currentIndividual << " fitness is " << currentIndividual->getFitness() << ends;
             
             currentIndividual->getFitness().setScalingFactor(ScaledFitness::SHARING_SCALING, 1/m);
-            currentIndividual->getFitness().setAdditionalDescription(
-                ScaledFitness::SHARING_SCALING,
-                " [" + ugp3::Convert::toString(1/m) + " sharing, " + ugp3::Convert::toString(neighbours) + " neighbours]");
+            currentIndividual->getFitness().setSharingDescription(1/m, neighbours);
             
             LOG_VERBOSE << "After: " << *currentIndividual << " fitness is " << currentIndividual->getFitness() << ends;
         }
@@ -63,6 +63,7 @@ void Population::readXml(const xml::Element& element)
 
     this->generation = xml::Utility::attributeValueToUInt(element, XML_ATTRIBUTE_GENERATION);
     this->name = xml::Utility::attributeValueToString(element, XML_ATTRIBUTE_NAME);
+    m_profiler.setName(this->name);
 
     // get the inner elements
     const xml::Element* childElement = element.FirstChildElement();
@@ -38,7 +38,12 @@ maximumSteadyStateGenerations(0),
 maximumTimeStop(false),
 fitnessSharingEnabled(false),
 fitnessSharingRadius(0),
-cloneScalingFactor(0.0)
+cloneScalingFactor(0.0),
+asynchronousQueueDepth(0),
+asynchronousReplay(false),
+surrogateFraction(1.0),
+surrogateNeighbours(5),
+surrogateTrainingSize(500)
 {
     
 }
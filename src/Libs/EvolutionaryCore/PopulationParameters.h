@@ -74,6 +74,16 @@ protected:
     static const std::string XML_ATTRIBUTE_DISTANCETYPE;
     static const std::string XML_ATTRIBUTE_RADIUS;
     static const std::string XML_CHILDELEMENT_CLONESCALINGFACTOR;
+    /** Xml tag to enable asynchronous (steady-state) evaluation */
+    static const std::string XML_CHILDELEMENT_ASYNCHRONOUSEVALUATION;
+    static const std::string XML_ATTRIBUTE_QUEUEDEPTH;
+    static const std::string XML_ATTRIBUTE_EVENTLOG;
+    static const std::string XML_ATTRIBUTE_REPLAY;
+    /** Xml tag to enable the surrogate pre-screening of the offspring */
+    static const std::string XML_CHILDELEMENT_SURROGATESCREENING;
+    static const std::string XML_ATTRIBUTE_FRACTION;
+    static const std::string XML_ATTRIBUTE_NEIGHBOURS;
+    static const std::string XML_ATTRIBUTE_TRAININGSIZE;
     
     /** Xml tag to specify the evaluator */
     static const std::string XML_CHILDELEMENT_EVALUATOR;
@@ -134,6 +144,18 @@ protected:
     std::string fitnessSharingDistance; // type of crowding distance
     double fitnessSharingRadius;     // radius of crowding distance
     double cloneScalingFactor;
+    /** Number of offspring kept under evaluation in asynchronous mode, 0 for generational evolution */
+    unsigned int asynchronousQueueDepth;
+    /** File recording the offspring merged at each generation in asynchronous mode (appended to, remove it before a new run) */
+    std::string asynchronousEventLog;
+    /** Specify if the event log is read back to replay a previous run */
+    bool asynchronousReplay;
+    /** Fraction of the offspring sent to the evaluator after the surrogate screening, 1 to disable it */
+    double surrogateFraction;
+    /** Number of neighbours used by the surrogate model */
+    unsigned int surrogateNeighbours;
+    /** Number of evaluated candidates remembered by the surrogate model */
+    unsigned int surrogateTrainingSize;
     
 protected:
     /** 
@@ -325,6 +347,26 @@ public:
     
     double          getCloneScalingFactor() const noexcept { return cloneScalingFactor; }
     
+    /**
+     * Asynchronous evaluation: the population keeps queueDepth offspring
+     * under evaluation, and each generation merges the first lambda that
+     * complete. The merge order can be recorded to (or replayed from)
+     * the event log, for deterministic reruns.
+     */
+    unsigned int       getAsynchronousQueueDepth() const noexcept { return asynchronousQueueDepth; }
+    const std::string& getAsynchronousEventLog()   const noexcept { return asynchronousEventLog; }
+    bool               getAsynchronousReplay()     const noexcept { return asynchronousReplay; }
+    
+    /**
+     * Surrogate pre-screening: a model of the fitness, trained on the
+     * evaluated candidates, ranks the offspring and only the best fraction
+     * of them is evaluated; the others are discarded (see Surrogate).
+     */
+    bool         getSurrogateScreening()     const noexcept { return surrogateFraction < 1.0; }
+    double       getSurrogateFraction()      const noexcept { return surrogateFraction; }
+    unsigned int getSurrogateNeighbours()    const noexcept { return surrogateNeighbours; }
+    unsigned int getSurrogateTrainingSize()  const noexcept { return surrogateTrainingSize; }
+    
 public: // setters
     /** 
      * Sets the IndividualSelection instance used by the genetic operators to select individuals
@@ -436,6 +478,17 @@ public: // setters
         this->maximumTime = value;
     }
     
+    /**
+     * Disables all the stop conditions except the maximum number of generations
+     * (used to run an exact number of generations, e.g. when benchmarking).
+     */
+    void clearStopConditions() noexcept {
+        this->maximumEvaluationsStop = false;
+        this->maximumFitnessStop = false;
+        this->SteadyStateGenerationsStop = false;
+        this->maximumTimeStop = false;
+    }
+    
     void setFitnessSharingDistance(const std::string& value) noexcept {
         this->fitnessSharingEnabled = true;
         this->fitnessSharingDistance = value;
@@ -454,6 +507,32 @@ public: // setters
         this->cloneScalingFactor = value;
     }
     
+    void setAsynchronousQueueDepth(unsigned int value) noexcept { this->asynchronousQueueDepth = value; }
+    void setAsynchronousEventLog(const std::string& value) noexcept { this->asynchronousEventLog = value; }
+    void setAsynchronousReplay(bool value) noexcept { this->asynchronousReplay = value; }
+    
+    void setSurrogateFraction(double value) {
+        _STACK;
+        if (value <= 0.0 || value > 1.0) {
+            throw Exception("The fraction of offspring evaluated after the surrogate screening should be in (0, 1].", LOCATION);
+        }
+        this->surrogateFraction = value;
+    }
+    void setSurrogateNeighbours(unsigned int value) {
+        _STACK;
+        if (value == 0) {
+            throw Exception("The surrogate model needs at least one neighbour.", LOCATION);
+        }
+        this->surrogateNeighbours = value;
+    }
+    void setSurrogateTrainingSize(unsigned int value) {
+        _STACK;
+        if (value == 0) {
+            throw Exception("The surrogate model needs at least one training sample.", LOCATION);
+        }
+        this->surrogateTrainingSize = value;
+    }
+    
     /** 
      * Sets the script that is used as evaluator of individuals
      * @param fileName The name of the script file
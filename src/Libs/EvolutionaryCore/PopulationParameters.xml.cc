@@ -37,6 +37,14 @@ const string PopulationParameters::XML_CHILDELEMENT_FITNESSSHARING = "fitnessSha
 const string PopulationParameters::XML_ATTRIBUTE_DISTANCETYPE = "distance";
 const string PopulationParameters::XML_ATTRIBUTE_RADIUS = "radius";
 const string PopulationParameters::XML_CHILDELEMENT_CLONESCALINGFACTOR = "cloneScalingFactor";
+const string PopulationParameters::XML_CHILDELEMENT_ASYNCHRONOUSEVALUATION = "asynchronousEvaluation";
+const string PopulationParameters::XML_ATTRIBUTE_QUEUEDEPTH = "queueDepth";
+const string PopulationParameters::XML_ATTRIBUTE_EVENTLOG = "eventLog";
+const string PopulationParameters::XML_ATTRIBUTE_REPLAY = "replay";
+const string PopulationParameters::XML_CHILDELEMENT_SURROGATESCREENING = "surrogateScreening";
+const string PopulationParameters::XML_ATTRIBUTE_FRACTION = "fraction";
+const string PopulationParameters::XML_ATTRIBUTE_NEIGHBOURS = "neighbours";
+const string PopulationParameters::XML_ATTRIBUTE_TRAININGSIZE = "trainingSize";
 
 const string PopulationParameters::XML_CHILDELEMENT_EVALUATOR = "evaluator";
 
@@ -187,6 +195,32 @@ void PopulationParameters::writeInternalXml(std::ostream& output) const
       << " " << XML_ATTRIBUTE_VALUE << "=\"" << this->cloneScalingFactor << "\"/>"
       << endl;
         
+        if (this->asynchronousQueueDepth > 0)
+        {
+            output
+            << "<!-- (optional) keep queueDepth offspring under evaluation and merge them as they complete -->" << endl
+            << "<" << XML_CHILDELEMENT_ASYNCHRONOUSEVALUATION
+            << " " << XML_ATTRIBUTE_QUEUEDEPTH << "=\"" << this->asynchronousQueueDepth << "\"";
+            if (!this->asynchronousEventLog.empty())
+            {
+                output
+                << " " << XML_ATTRIBUTE_EVENTLOG << "=\"" << this->asynchronousEventLog << "\""
+                << " " << XML_ATTRIBUTE_REPLAY << "=\"" << (this->asynchronousReplay ? "true" : "false") << "\"";
+            }
+            output << "/>" << endl;
+        }
+        
+        if (getSurrogateScreening())
+        {
+            output
+            << "<!-- (optional) evaluate only the given fraction of the offspring, ranked by a surrogate model -->" << endl
+            << "<" << XML_CHILDELEMENT_SURROGATESCREENING
+            << " " << XML_ATTRIBUTE_FRACTION << "=\"" << this->surrogateFraction << "\""
+            << " " << XML_ATTRIBUTE_NEIGHBOURS << "=\"" << this->surrogateNeighbours << "\""
+            << " " << XML_ATTRIBUTE_TRAININGSIZE << "=\"" << this->surrogateTrainingSize << "\""
+            << "/>" << endl;
+        }
+        
         output
         << "<!-- parents selector parameters -->" << endl;
         this->selector->writeXml(output);
@@ -529,6 +563,50 @@ void PopulationParameters::readXml(const xml::Element& element)
                 throw;
             }
         }
+        else if (elementName == XML_CHILDELEMENT_ASYNCHRONOUSEVALUATION)
+        {
+            try
+            {
+                this->setAsynchronousQueueDepth(xml::Utility::attributeValueToUInt(*childElement, XML_ATTRIBUTE_QUEUEDEPTH));
+                if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_EVENTLOG))
+                {
+                    this->setAsynchronousEventLog(xml::Utility::attributeValueToString(*childElement, XML_ATTRIBUTE_EVENTLOG));
+                }
+                if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_REPLAY))
+                {
+                    this->setAsynchronousReplay(xml::Utility::attributeValueToBool(*childElement, XML_ATTRIBUTE_REPLAY));
+                }
+                if (this->asynchronousReplay && this->asynchronousEventLog.empty())
+                {
+                    throw ArgumentException("replay requires an event log.", LOCATION);
+                }
+            }
+            catch (const exception& e)
+            {
+                LOG_ERROR << "While parsing " << XML_CHILDELEMENT_ASYNCHRONOUSEVALUATION << ": " << e.what() << ends;
+                throw;
+            }
+        }
+        else if (elementName == XML_CHILDELEMENT_SURROGATESCREENING)
+        {
+            try
+            {
+                this->setSurrogateFraction(xml::Utility::attributeValueToDouble(*childElement, XML_ATTRIBUTE_FRACTION));
+                if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_NEIGHBOURS))
+                {
+                    this->setSurrogateNeighbours(xml::Utility::attributeValueToUInt(*childElement, XML_ATTRIBUTE_NEIGHBOURS));
+                }
+                if (xml::Utility::hasAttribute(*childElement, XML_ATTRIBUTE_TRAININGSIZE))
+                {
+                    this->setSurrogateTrainingSize(xml::Utility::attributeValueToUInt(*childElement, XML_ATTRIBUTE_TRAININGSIZE));
+                }
+            }
+            catch (const exception& e)
+            {
+                LOG_ERROR << "While parsing " << XML_CHILDELEMENT_SURROGATESCREENING << ": " << e.what() << ends;
+                throw;
+            }
+        }
         
         childElement = childElement->NextSiblingElement();
     }
@@ -0,0 +1,166 @@
+/***********************************************************************\
+|                                                                       |
+| Profiler.cc                                                           |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+#include "EvolutionaryCore.h"
+#include "Profiler.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace ugp3::core;
+
+bool Profiler::s_enabled = false;
+std::ofstream Profiler::s_trace;
+bool Profiler::s_firstTraceEvent = true;
+steady_clock::time_point Profiler::s_origin = steady_clock::now();
+unsigned int Profiler::s_profilerCounter = 0;
+
+Profiler::Profiler()
+: m_traceId(++s_profilerCounter),
+  m_traceNameWritten(false),
+  m_currentPhase(PHASE_COUNT)
+{
+    reset();
+}
+
+void Profiler::reset()
+{
+    for (auto& time: m_times) {
+        time = nanoseconds(0);
+    }
+    for (auto& time: m_operatorTimes) {
+        time.second = nanoseconds(0);
+    }
+}
+
+double Profiler::getMilliseconds(Phase phase) const
+{
+    return duration<double, milli>(m_times[phase]).count();
+}
+
+double Profiler::getOperatorMilliseconds(const string& operatorName) const
+{
+    auto it = m_operatorTimes.find(operatorName);
+    if (it == m_operatorTimes.end()) {
+        return 0;
+    }
+    return duration<double, milli>(it->second).count();
+}
+
+const string& Profiler::getPhaseName(Phase phase)
+{
+    static const string names[PHASE_COUNT] = {
+        "Other",
+        "Breeding",
+        "Operators",
+        "Merge",
+        "Surrogate",
+        "Evaluation",
+        "Clones",
+        "Entropy",
+        "Sharing",
+        "Levels",
+        "Slaughtering",
+        "Commit",
+        "DumpState",
+        "Statistics"
+    };
+    return names[phase];
+}
+
+void Profiler::Scope::start(Profiler& profiler, Phase phase, const string* operatorName)
+{
+    m_profiler = &profiler;
+    m_phase = phase;
+    m_operatorName = operatorName;
+    m_start = steady_clock::now();
+    
+    // Pause the enclosing phase
+    m_parentPhase = profiler.m_currentPhase;
+    if (m_parentPhase != PHASE_COUNT) {
+        profiler.m_times[m_parentPhase] += m_start - profiler.m_currentStart;
+    }
+    profiler.m_currentPhase = phase;
+    profiler.m_currentStart = m_start;
+}
+
+void Profiler::Scope::stop()
+{
+    Profiler& profiler = *m_profiler;
+    steady_clock::time_point now = steady_clock::now();
+    
+    nanoseconds time = now - profiler.m_currentStart;
+    profiler.m_times[m_phase] += time;
+    if (m_operatorName) {
+        // The operator gets its whole time, children included
+        profiler.m_operatorTimes[*m_operatorName] += now - m_start;
+    }
+    
+    // Resume the enclosing phase
+    profiler.m_currentPhase = m_parentPhase;
+    profiler.m_currentStart = now;
+    
+    if (s_trace.is_open()) {
+        profiler.writeTraceEvent(m_phase, m_operatorName, m_start, now);
+    }
+}
+
+void Profiler::writeTraceEvent(Phase phase, const string* operatorName,
+    steady_clock::time_point start, steady_clock::time_point stop)
+{
+    if (!m_traceNameWritten) {
+        s_trace << (s_firstTraceEvent ? "\n" : ",\n");
+        s_firstTraceEvent = false;
+        s_trace << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << m_traceId
+                << ",\"args\":{\"name\":\"" << (m_name.empty() ? "ugp3" : m_name) << "\"}}";
+        m_traceNameWritten = true;
+    }
+    
+    s_trace << ",\n{\"name\":\"" << (operatorName ? *operatorName : getPhaseName(phase))
+            << "\",\"cat\":\"" << getPhaseName(phase)
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << m_traceId
+            << ",\"ts\":" << duration_cast<microseconds>(start - s_origin).count()
+            << ",\"dur\":" << duration_cast<microseconds>(stop - start).count() << "}";
+}
+
+void Profiler::openTrace(const string& fileName)
+{
+    closeTrace();
+    
+    s_trace.open(fileName.c_str());
+    if (!s_trace.is_open()) {
+        throw Exception("Cannot open the trace file \"" + fileName + "\".", LOCATION);
+    }
+    s_trace << "[";
+    s_firstTraceEvent = true;
+    s_enabled = true;
+}
+
+void Profiler::closeTrace()
+{
+    if (s_trace.is_open()) {
+        s_trace << "\n]\n";
+        s_trace.close();
+    }
+}
@@ -0,0 +1,176 @@
+/***********************************************************************\
+|                                                                       |
+| Profiler.h                                                            |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#ifndef HEADER_UGP3_CORE_PROFILER
+#define HEADER_UGP3_CORE_PROFILER
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace ugp3 {
+namespace core {
+
+/**
+ * Time spent by the engine in each phase of a generation.
+ * 
+ * Phases are measured by Scope objects. Scopes can be nested: the time of a
+ * phase excludes the time of the phases started inside it, so that the
+ * phases of a generation add up to the duration of the generation.
+ * The times are reset at the beginning of each generation and exported as
+ * columns of the statistics file. Optionally, every scope is also written to
+ * a trace file in the Chrome trace-event format (chrome://tracing).
+ * 
+ * Profiling is disabled by default; when disabled a scope costs one test.
+ */
+class Profiler
+{
+public:
+    typedef enum {
+        OTHER = 0,
+        BREEDING,
+        OPERATORS,
+        MERGE,
+        SURROGATE,
+        EVALUATION,
+        CLONES,
+        ENTROPY,
+        SHARING,
+        LEVELS,
+        SLAUGHTERING,
+        COMMIT,
+        DUMP_STATE,
+        STATISTICS,
+        PHASE_COUNT
+    } Phase;
+    
+    /**
+     * Measures the time between its construction and its destruction.
+     */
+    class Scope
+    {
+    private:
+        Profiler* m_profiler;
+        Phase m_phase;
+        Phase m_parentPhase;
+        const std::string* m_operatorName;
+        std::chrono::steady_clock::time_point m_start;
+        
+        Scope(const Scope&);
+        Scope& operator=(const Scope&);
+        
+    public:
+        /**
+         * @param operatorName When given, the time is also added to the
+         * time of this operator. Must outlive the scope.
+         */
+        Scope(Profiler& profiler, Phase phase, const std::string* operatorName = nullptr) {
+            if (s_enabled) {
+                start(profiler, phase, operatorName);
+            } else {
+                m_profiler = nullptr;
+            }
+        }
+        ~Scope() {
+            close();
+        }
+        
+        /**
+         * End the measure before the end of the scope. Scopes must be
+         * closed in the reverse order of their creation.
+         */
+        void close() {
+            if (m_profiler) {
+                stop();
+                m_profiler = nullptr;
+            }
+        }
+        
+    private:
+        void start(Profiler& profiler, Phase phase, const std::string* operatorName);
+        void stop();
+    };
+    
+private:
+    static bool s_enabled;
+    static std::ofstream s_trace;
+    static bool s_firstTraceEvent;
+    static std::chrono::steady_clock::time_point s_origin;
+    static unsigned int s_profilerCounter;
+    
+    std::string m_name;
+    unsigned int m_traceId;
+    bool m_traceNameWritten;
+    Phase m_currentPhase;
+    std::chrono::steady_clock::time_point m_currentStart;
+    std::chrono::nanoseconds m_times[PHASE_COUNT];
+    std::unordered_map<std::string, std::chrono::nanoseconds> m_operatorTimes;
+    
+    void writeTraceEvent(Phase phase, const std::string* operatorName,
+        std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point stop);
+    
+public:
+    Profiler();
+    
+    /**
+     * Name of the profiled object (a population), used in the trace.
+     */
+    void setName(const std::string& name) { m_name = name; }
+    
+    /**
+     * Forget the times of the previous generation.
+     */
+    void reset();
+    
+    /**
+     * @return Time spent in the given phase since the last reset, in milliseconds.
+     */
+    double getMilliseconds(Phase phase) const;
+    
+    /**
+     * @return Time spent in the given operator since the last reset, in milliseconds.
+     */
+    double getOperatorMilliseconds(const std::string& operatorName) const;
+    
+    static const std::string& getPhaseName(Phase phase);
+    
+public:
+    static bool getEnabled() { return s_enabled; }
+    static void setEnabled(bool value) { s_enabled = value; }
+    
+    /**
+     * Write a trace of all the scopes to the given file, until closeTrace()
+     * is called. Enables profiling.
+     */
+    static void openTrace(const std::string& fileName);
+    static void closeTrace();
+};
+
+}
+}
+
+#endif // HEADER_UGP3_CORE_PROFILER
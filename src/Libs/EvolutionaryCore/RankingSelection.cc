@@ -31,6 +31,7 @@
 #include "Data.h"
 #include "Statistics.h"
 #include <Convert.h>
+#include <algorithm>
 #include <limits>
 #include "Log.h"
 
@@ -40,7 +41,7 @@ using namespace ugp3::core;
 
 RankingSelection::RankingSelection(/*const Population& population*/)
 : CandidateSelection(/*population*/),
-pressure(1), pressureMin(1), pressureMax(1)
+pressure(1), pressureMin(1), pressureMax(1), m_cumulativePressure(0)
 {}
 
 std::vector< CandidateSolution* > RankingSelection::infinitePressureSelection(
@@ -50,7 +51,7 @@ std::vector< CandidateSolution* > RankingSelection::infinitePressureSelection(
     
     vector<CandidateSolution*> selectedCandidates;
     
-    sortByFitness(population, m_selectable.begin(), m_selectable.end());
+    sortSelectableByFitness(population);
     // choose the best
     for (unsigned int i = 0; i < count; i++) {
         selectedCandidates.push_back(m_selectable[i]);
@@ -69,20 +70,50 @@ std::vector< CandidateSolution* > RankingSelection::customSelection(const Popula
     LOG_VERBOSE     << "rankingSelection : performing ranking selection for " << count 
     << " individuals, with pression multiplier " << pressionMultiplier << ends;
     
-    sortByFitness(population, m_selectable.begin(), m_selectable.end());
+    sortSelectableByFitness(population);
+    updateCumulative();
     
+    // Positions already selected: the ranks do not change while selecting,
+    // an individual already selected is simply drawn again
+    const unsigned int maxDraws = 8;
+    vector<unsigned int> taken;
     while (selectedIndividuals.size() < count) {
         // Pick an individual from the population
         unsigned int position = this->ranking();
+        unsigned int draws = 1;
+        while (std::find(taken.begin(), taken.end(), position) != taken.end()) {
+            if (draws++ < maxDraws) {
+                position = this->ranking();
+                continue;
+            }
+            // Most of the ranking fitness is taken: choose among the others
+            double remaining = 0;
+            for (unsigned int pos = 0; pos < m_cumulative.size(); pos++) {
+                if (std::find(taken.begin(), taken.end(), pos) == taken.end()) {
+                    remaining += m_cumulative[pos] - (pos > 0 ? m_cumulative[pos - 1] : 0);
+                }
+            }
+            double choice = Random::nextDouble(0, remaining);
+            for (position = 0; position < m_cumulative.size(); position++) {
+                if (std::find(taken.begin(), taken.end(), position) == taken.end()) {
+                    choice -= m_cumulative[position] - (position > 0 ? m_cumulative[position - 1] : 0);
+                    if (choice <= 0) {
+                        break;
+                    }
+                }
+            }
+            // Rounding errors
+            while (position >= m_cumulative.size() || std::find(taken.begin(), taken.end(), position) != taken.end()) {
+                position = (position + m_cumulative.size() - 1) % m_cumulative.size();
+            }
+        }
         CandidateSolution* individual = m_selectable[position];
         LOG_VERBOSE << "Individual in position " << position << " selected: " << individual << ends;
         
         // Collect the selected individual
+        taken.push_back(position);
         selectedIndividuals.push_back(individual);
-        // Prevent it from being selected again, preserve ordering of the vector
-        m_selectable.erase(m_selectable.begin() + position);
     }
-    m_selectable.insert(m_selectable.end(), selectedIndividuals.begin(), selectedIndividuals.end());
     
     LOG_DEBUG << "Selection complete. " << selectedIndividuals.size() << " individuals selected" << ends;
     // return the selected individuals
@@ -144,6 +175,27 @@ void RankingSelection::updateEndogenParameters(Population& population)
     
 }
 
+void RankingSelection::updateCumulative() const
+{
+    if (m_cumulative.size() == m_selectable.size() && m_cumulativePressure == this->pressure) {
+        return;
+    }
+    
+    const std::size_t size = m_selectable.size();
+    m_cumulative.resize(size);
+    m_cumulativePressure = this->pressure;
+    if (size == 1) {
+        m_cumulative[0] = 1;
+        return;
+    }
+    
+    double fitnessCumulate = 0;
+    for (unsigned int pos = 0; pos < size; pos++) {
+        fitnessCumulate += 2 - this->pressure + 2 * (this->pressure - 1) * (size - pos - 1) / (size - 1);
+        m_cumulative[pos] = fitnessCumulate;
+    }
+}
+
 unsigned int RankingSelection::ranking() const
 {
     _STACK;
@@ -171,31 +223,14 @@ unsigned int RankingSelection::ranking() const
         return 0;
     }
     // so we only have to extract a random double and associate it to the right individual
-    double fitnessCumulate = 0;
-    vector<double> fitness(m_selectable.size());
-    
-    for (unsigned int pos = 0; pos < m_selectable.size(); pos++) {
-        fitness[pos] = 2 - this->pressure + 2 * (this->pressure - 1 ) * (m_selectable.size() - pos - 1) / (m_selectable.size() - 1);
-        LOG_DEBUG << "Individual " << m_selectable[pos] << " goes from " << fitnessCumulate;
-        fitnessCumulate += fitness[pos];
-        LOG_DEBUG << " to " << fitnessCumulate << ends;
-        
-    }
-    
     // fitnessCumulate is equal to the number of individuals in the population
-    // it is stored only for debug purposes 
-    double choice = Random::nextDouble(0, fitnessCumulate);
+    double choice = Random::nextDouble(0, m_cumulative.back());
     LOG_DEBUG << "Choice=" << choice << ends;
     
-    unsigned int position = 0;
-    if ( choice < fitness[0]) {
-        position = 0;
-    } else {
-        fitnessCumulate = fitness[0];
-        for (unsigned int pos = 1; pos < m_selectable.size() && choice > fitnessCumulate; pos++) {
-            fitnessCumulate += fitness[pos];
-            position = pos;
-        }   
+    // first position whose cumulated fitness reaches the choice
+    unsigned int position = std::lower_bound(m_cumulative.begin(), m_cumulative.end(), choice) - m_cumulative.begin();
+    if (position >= m_cumulative.size()) {
+        position = m_cumulative.size() - 1;
     }
     
     return position;
@@ -48,10 +48,20 @@ class RankingSelection : public CandidateSelection
 {
 private:
 	double pressure, pressureMin, pressureMax;
+    
+    // Cumulative ranking fitness of the positions of a sorted m_selectable,
+    // kept until the size or the pressure changes
+    mutable std::vector<double> m_cumulative;
+    mutable double m_cumulativePressure;
 
 private:
     /**
-     * Return an index into m_selectable.
+     * Fill m_cumulative for the current size of m_selectable.
+     */
+    void updateCumulative() const;
+    
+    /**
+     * Return an index into m_selectable, sorted by fitness.
      */
     unsigned int ranking() const;
 
@@ -25,9 +25,11 @@
 \***********************************************************************/
 
 #include "ScaledFitness.h"
+#include "MemoryUsage.h"
 
 #include "Debug.h"
 #include "Log.h"
+#include "Convert.h"
 
 #include <cmath>
 #include <algorithm>
@@ -39,10 +41,12 @@ ugp3::core::ScaledFitness::ScaledFitness()
 ugp3::core::ScaledFitness::ScaledFitness(unsigned int parameterCount)
 :Fitness(parameterCount)
 {
+    m_rawValues.reserve(parameterCount);
 }
 
 void ugp3::core::ScaledFitness::setScalingFactor(ScalingCause cause, double factor)
 {
+    // Assigning a list keeps the capacity of the vector
     m_scalingFactors[cause].factors = {factor};
     rescale();
 }
@@ -60,40 +64,111 @@ void ugp3::core::ScaledFitness::setValues(const std::vector< double >& values)
     rescale();
 }
 
+std::string ugp3::core::ScaledFitness::getAdditionalDescription(ugp3::core::ScaledFitness::ScalingCause cause) const
+{
+    std::string description;
+    m_descriptions[cause].appendTo(description);
+    return description;
+}
+
 void ugp3::core::ScaledFitness::setAdditionalDescription(ugp3::core::ScaledFitness::ScalingCause cause, const std::string& description)
 {
-    m_descriptions[cause] = description;
-    redescribe();
+    m_descriptions[cause].kind = TEXT;
+    m_descriptions[cause].text = description;
+    m_isDescribed = false;
+}
+
+void ugp3::core::ScaledFitness::setCloneMasterDescription(unsigned int total)
+{
+    AdditionalDescription& description = m_descriptions[CLONE_SCALING];
+    if (total > 1) {
+        description.kind = CLONE_MASTER;
+        description.count = total;
+    } else {
+        description.kind = TEXT;
+        description.text.clear();
+    }
+    m_isDescribed = false;
+}
+
+void ugp3::core::ScaledFitness::setCloneDescription(unsigned int total, const std::string& master)
+{
+    AdditionalDescription& description = m_descriptions[CLONE_SCALING];
+    description.kind = CLONE;
+    description.count = total;
+    description.text = master;
+    m_isDescribed = false;
+}
+
+void ugp3::core::ScaledFitness::setSharingDescription(double factor, unsigned int neighbours)
+{
+    AdditionalDescription& description = m_descriptions[SHARING_SCALING];
+    description.kind = SHARING;
+    description.value = factor;
+    description.count = neighbours;
+    m_isDescribed = false;
 }
 
 void ugp3::core::ScaledFitness::setDescription(const std::string& description)
 {
     m_rawDescription = description;
-    redescribe();
+    m_isDescribed = false;
+}
+
+std::size_t ugp3::core::ScaledFitness::getDescriptionMemoryUsage() const
+{
+    std::size_t bytes = MemoryUsage::ofString(m_rawDescription) + MemoryUsage::ofString(description);
+    for (int i = 0; i < SCALING_CAUSE_COUNT; ++i) {
+        bytes += MemoryUsage::ofString(m_descriptions[i].text);
+    }
+    return bytes;
 }
 
 void ugp3::core::ScaledFitness::rescale()
 {
-    std::vector<double> newValues(m_rawValues);
-    
-    for (std::size_t i = 0; i < newValues.size(); ++i) {
+    // Scale in place: m_values keeps its capacity
+    m_values.resize(m_rawValues.size());
+    for (std::size_t i = 0; i < m_rawValues.size(); ++i) {
+        double value = m_rawValues[i];
         for (int j = 0; j < SCALING_CAUSE_COUNT; ++j) {
-            newValues[i] *= m_scalingFactors[j].factors[std::min(i, m_scalingFactors[j].factors.size() - 1)];
+            value *= m_scalingFactors[j].factors[std::min(i, m_scalingFactors[j].factors.size() - 1)];
         }
+        Assert(!std::isnan(value));
+        m_values[i] = value;
     }
     
-    Fitness::setValues(newValues);
+    isValid = true;
 }
 
-void ugp3::core::ScaledFitness::redescribe()
+void ugp3::core::ScaledFitness::describe() const
 {
-    std::string desc = m_rawDescription;
+    if (m_isDescribed) {
+        return;
+    }
     
+    description = m_rawDescription;
     for (int i = 0; i < SCALING_CAUSE_COUNT; ++i) {
-        desc += m_descriptions[i];
+        m_descriptions[i].appendTo(description);
+    }
+    m_isDescribed = true;
+}
+
+void ugp3::core::ScaledFitness::AdditionalDescription::appendTo(std::string& description) const
+{
+    switch (kind) {
+        case TEXT:
+            description += text;
+            break;
+        case CLONE_MASTER:
+            description += " [master of " + ugp3::Convert::toString(count) + " clones]";
+            break;
+        case CLONE:
+            description += " [clone #" + ugp3::Convert::toString(count) + " of " + text + "]";
+            break;
+        case SHARING:
+            description += " [" + ugp3::Convert::toString(value) + " sharing, " + ugp3::Convert::toString(count) + " neighbours]";
+            break;
     }
-    
-    Fitness::setDescription(desc);
 }
 
 std::ostream& ugp3::core::operator<<(std::ostream& stream, const ugp3::core::ScaledFitness::Scaling& scaling)
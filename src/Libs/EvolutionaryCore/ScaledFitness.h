@@ -50,20 +50,47 @@ public:
         void fromString(const std::string& str);
     };
     
+    /**
+     * What an additional description says. Except for TEXT, only the numbers
+     * are stored: the text is formatted when the description is read.
+     */
+    typedef enum {
+        TEXT = 0,           // the text given to setAdditionalDescription()
+        CLONE_MASTER,       // " [master of <count> clones]"
+        CLONE,              // " [clone #<count> of <text>]"
+        SHARING             // " [<value> sharing, <count> neighbours]"
+    } DescriptionKind;
+    
+    struct AdditionalDescription {
+        DescriptionKind kind = TEXT;
+        double value = 0;
+        unsigned int count = 0;
+        std::string text;
+        void appendTo(std::string& description) const;
+    };
+    
 private:
     Scaling m_scalingFactors[SCALING_CAUSE_COUNT];
-    std::string m_descriptions[SCALING_CAUSE_COUNT];
+    AdditionalDescription m_descriptions[SCALING_CAUSE_COUNT];
     unsigned int m_cloneCount = 0;
     
     // We keep the unscaled values here to be able to rescale them later
     // The scaled values are kept in the m_values vector from Fitness
+    // NOTE Both vectors keep their capacity: rescaling does not allocate
     std::vector<double> m_rawValues;
     std::string m_rawDescription;
     
+    // The description of Fitness must be built again before being read
+    mutable bool m_isDescribed = true;
+    
     // Copy the raw values to the scaled values and apply the current scaling factors.
     void rescale();
     
-    void redescribe();
+protected:
+    /**
+     * Build the description from the raw description and the additional ones.
+     */
+    virtual void describe() const;
 
 public:
 	ScaledFitness(unsigned int parameterCount);
@@ -85,9 +112,21 @@ public:
     /**
      * When set, these descriptions will be appended to the original description.
      */
-    const std::string& getAdditionalDescription(ScalingCause cause) const { return m_descriptions[cause]; }   
+    std::string getAdditionalDescription(ScalingCause cause) const;
     void setAdditionalDescription(ScalingCause cause, const std::string& description);
     
+    /**
+     * Additional descriptions of the usual scalings, formatted only when read.
+     */
+    void setCloneMasterDescription(unsigned int total);
+    void setCloneDescription(unsigned int total, const std::string& master);
+    void setSharingDescription(double factor, unsigned int neighbours);
+    
+    /**
+     * Bytes retained by the descriptions, without building them.
+     */
+    std::size_t getDescriptionMemoryUsage() const;
+    
     /**
      * When a new description is set, additional descriptions of
      * the various scalings applied are appended to the end.
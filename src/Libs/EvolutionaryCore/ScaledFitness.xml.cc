@@ -54,7 +54,7 @@ void ScaledFitness::writeXml(ostream& output) const
             << " " << XML_ATTRIBUTE_CLONECOUNT << "=\""  << this->m_cloneCount << "\"";
         for (int cause = 0; cause < SCALING_CAUSE_COUNT; ++cause) {
             output << " " << XML_ATTRIBUTE_SCALING_FACTOR[cause] << "=\"" << this->m_scalingFactors[cause] << "\"";
-            output << " " << XML_ATTRIBUTE_DESCRIPTION[cause] << "=\"" << xml::Utility::transformXmlEscChar(m_descriptions[cause]) << "\"";
+            output << " " << XML_ATTRIBUTE_DESCRIPTION[cause] << "=\"" << xml::Utility::transformXmlEscChar(getAdditionalDescription((ScalingCause) cause)) << "\"";
         }
         output << ">" << std::endl;
 
@@ -85,14 +85,17 @@ void ScaledFitness::readXml(const xml::Element& element)
             m_scalingFactors[cause] = Scaling();
         }
         
+        // Read back as plain text
         if (xml::Utility::hasAttribute(element, XML_ATTRIBUTE_DESCRIPTION[cause])) {
-            m_descriptions[cause] = xml::Utility::attributeValueToString(element, XML_ATTRIBUTE_DESCRIPTION[cause]);
+            setAdditionalDescription((ScalingCause) cause, xml::Utility::attributeValueToString(element, XML_ATTRIBUTE_DESCRIPTION[cause]));
         } else {
-            m_descriptions[cause] = "";
+            setAdditionalDescription((ScalingCause) cause, "");
         }
     }
+    m_rawDescription.clear();
 
-    // The reading of the raw values will trigger rescale and redescribe
+    // The reading of the raw values will trigger rescale
     Fitness::readXml(element);
+    m_isDescribed = false;
 }
 
@@ -0,0 +1,86 @@
+/***********************************************************************\
+|                                                                       |
+| SelectionKeys.cc                                                      |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#include "EvolutionaryCore.h"
+#include "SelectionKeys.h"
+
+using namespace std;
+using namespace ugp3::core;
+
+void SelectionKeys::clear()
+{
+    m_candidates.clear();
+    m_fitness.clear();
+    m_birth.clear();
+    m_id.clear();
+    m_ranges.clear();
+    m_fitnessSize = 0;
+}
+
+void SelectionKeys::add(const CandidateSolution& candidate)
+{
+    const Fitness& fitness = candidate.getFitness();
+    if (!fitness.getIsValid()) {
+        return;
+    }
+    
+    const vector<double>& values = fitness.getValues();
+    if (m_candidates.empty()) {
+        m_fitnessSize = values.size();
+    } else if (values.size() != m_fitnessSize) {
+        // Compared the slow way
+        return;
+    }
+    
+    candidate.setSelectionKey(m_candidates.size());
+    m_candidates.push_back(&candidate);
+    m_fitness.insert(m_fitness.end(), values.begin(), values.end());
+    m_birth.push_back(candidate.getBirth());
+    m_id.push_back(candidate.getNumericId());
+}
+
+bool SelectionKeys::compare(const CandidateSolution* a, const CandidateSolution* b) const
+{
+    unsigned int keyA = a->getSelectionKey();
+    unsigned int keyB = b->getSelectionKey();
+    
+    // Higher scaled fitness first
+    const double* fitnessA = &m_fitness[keyA * m_fitnessSize];
+    const double* fitnessB = &m_fitness[keyB * m_fitnessSize];
+    for (std::size_t i = 0; i < m_fitnessSize; ++i) {
+        if (fitnessA[i] > fitnessB[i]) {
+            return true;
+        } else if (fitnessA[i] < fitnessB[i]) {
+            return false;
+        }
+    }
+    
+    // Then the oldest, then the first id
+    if (m_birth[keyA] != m_birth[keyB]) {
+        return m_birth[keyA] < m_birth[keyB];
+    }
+    return m_id[keyA] < m_id[keyB];
+}
@@ -0,0 +1,156 @@
+/***********************************************************************\
+|                                                                       |
+| SelectionKeys.h                                                       |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#ifndef HEADER_UGP3_CORE_SELECTIONKEYS
+#define HEADER_UGP3_CORE_SELECTIONKEYS
+
+#include "CandidateSolution.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace ugp3 {
+namespace core {
+
+/**
+ * Compact copy of what Population::compareForSelection() looks at, for the
+ * candidates that can be selected as parents: the scaled fitness values,
+ * the birth and the id, stored in contiguous arrays.
+ * 
+ * Tournaments and sorts compare these numbers instead of going through the
+ * virtual Fitness::compareTo(). The keys are built before breeding and must
+ * be cleared as soon as a scaled fitness can change.
+ * 
+ * Each range given to build() is also kept as a selection index: its live
+ * candidates in id order and from the best to the worst, so that
+ * CandidateSelection does not filter and sort the whole population for
+ * every operator call.
+ */
+class SelectionKeys
+{
+public:
+    /**
+     * Live candidates of one of the ranges given to build().
+     * The range is identified by the address of its first element and by its
+     * size, which do not change while breeding.
+     */
+    struct Range
+    {
+        const void* data;
+        std::size_t size;
+        std::vector<CandidateSolution*> byId;
+        std::vector<CandidateSolution*> byFitness;
+    };
+    
+private:
+    std::size_t m_fitnessSize;
+    std::vector<const CandidateSolution*> m_candidates;
+    std::vector<double> m_fitness;
+    std::vector<unsigned long> m_birth;
+    std::vector<std::uint64_t> m_id;
+    std::vector<Range> m_ranges;
+    
+    void add(const CandidateSolution& candidate);
+    
+public:
+    SelectionKeys() : m_fitnessSize(0) {}
+    
+    /**
+     * Add the keys of the live candidates of the given range.
+     * The range must be a container of the population that does not change
+     * until clear() is called.
+     */
+    template <typename ForwardIterator>
+    void build(ForwardIterator begin, ForwardIterator end) {
+        Range range;
+        range.data = (begin == end) ? nullptr : &*begin;
+        range.size = std::distance(begin, end);
+        for (auto it = begin; it != end; ++it) {
+            if ((*it)->isAlive()) {
+                add(**it);
+                range.byId.push_back(*it);
+            }
+        }
+        // NOTE/DET Same order as CandidateSelection would obtain by itself
+        std::sort(range.byId.begin(), range.byId.end(), CandidateSolution::OrderById());
+        m_ranges.push_back(std::move(range));
+    }
+    
+    /**
+     * Sort the candidates of every range from the best to the worst.
+     * Called once all the keys are built, since @p compare is expected
+     * to use them.
+     */
+    template <typename Compare>
+    void sortRanges(Compare compare) {
+        for (Range& range: m_ranges) {
+            range.byFitness = range.byId;
+            std::sort(range.byFitness.begin(), range.byFitness.end(), compare);
+        }
+    }
+    
+    /**
+     * @return The range previously given to build() that starts at the
+     * same element and has the same size, or nullptr.
+     */
+    template <typename ForwardIterator>
+    const Range* findRange(ForwardIterator begin, ForwardIterator end) const {
+        if (begin == end) {
+            return nullptr;
+        }
+        const void* data = &*begin;
+        std::size_t size = std::distance(begin, end);
+        for (const Range& range: m_ranges) {
+            if (range.data == data && range.size == size) {
+                return &range;
+            }
+        }
+        return nullptr;
+    }
+    
+    void clear();
+    
+    /**
+     * @return True if the given candidate has a key.
+     */
+    bool contains(const CandidateSolution* candidate) const {
+        unsigned int key = candidate->getSelectionKey();
+        return key < m_candidates.size() && m_candidates[key] == candidate;
+    }
+    
+    /**
+     * Same result as Population::compareForSelection(), for two candidates
+     * that have a key.
+     */
+    bool compare(const CandidateSolution* a, const CandidateSolution* b) const;
+};
+
+}
+}
+
+#endif // HEADER_UGP3_CORE_SELECTIONKEYS
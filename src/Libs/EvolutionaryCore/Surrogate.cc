@@ -0,0 +1,210 @@
+/***********************************************************************\
+|                                                                       |
+| Surrogate.cc                                                          |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#include "ugp3_config.h"
+#include "EvolutionaryCore.h"
+#include "Surrogate.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace ugp3::core;
+
+namespace {
+
+// Lexicographic order of the fitness values, as in Fitness::compareTo()
+int compareValues(const vector<double>& a, const vector<double>& b)
+{
+    for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+        if (a[i] > b[i]) {
+            return 1;
+        } else if (a[i] < b[i]) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+}
+
+void Surrogate::setNeighbours(unsigned int value)
+{
+    if (value == 0) {
+        throw ArgumentException("The surrogate needs at least one neighbour.", LOCATION);
+    }
+    m_neighbours = value;
+}
+
+void Surrogate::setCapacity(size_t value)
+{
+    if (value == 0) {
+        throw ArgumentException("The surrogate needs room for at least one sample.", LOCATION);
+    }
+    m_capacity = value;
+    
+    // Sort the samples from the oldest to the newest, then drop the oldest
+    std::rotate(m_samples.begin(), m_samples.begin() + m_nextSample, m_samples.end());
+    if (m_samples.size() > m_capacity) {
+        m_samples.erase(m_samples.begin(), m_samples.end() - m_capacity);
+    }
+    m_nextSample = m_samples.size() % m_capacity;
+}
+
+void Surrogate::train(const CandidateSolution& candidate)
+{
+    Assert(candidate.getRawFitness().getIsValid());
+    
+    Sample sample = { candidate.getSketch(), candidate.getRawFitness().getValues() };
+    if (m_samples.size() < m_capacity) {
+        m_samples.push_back(std::move(sample));
+    } else {
+        m_samples[m_nextSample] = std::move(sample);
+    }
+    m_nextSample = (m_nextSample + 1) % m_capacity;
+}
+
+vector<double> Surrogate::predict(const CandidateSolution& candidate) const
+{
+    Assert(isReady());
+    
+    const MessageSketch& sketch = candidate.getSketch();
+    vector<pair<double, const Sample*>> neighbours;
+    neighbours.reserve(m_samples.size());
+    for (const Sample& sample: m_samples) {
+        neighbours.push_back(make_pair(sketch.estimateJaccard(sample.sketch), &sample));
+    }
+    
+    // NOTE/DET Ties are broken by position in the buffer
+    const size_t k = min<size_t>(m_neighbours, neighbours.size());
+    partial_sort(neighbours.begin(), neighbours.begin() + k, neighbours.end(),
+        [] (const pair<double, const Sample*>& a, const pair<double, const Sample*>& b) {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+        });
+    
+    // Weighted mean; plain mean when no neighbour shares any symbol
+    vector<double> prediction(neighbours.front().second->fitness.size(), 0.0);
+    double totalWeight = 0;
+    for (size_t i = 0; i < k; ++i) {
+        totalWeight += neighbours[i].first;
+    }
+    for (size_t i = 0; i < k; ++i) {
+        const double weight = totalWeight > 0 ? neighbours[i].first / totalWeight : 1.0 / k;
+        const vector<double>& fitness = neighbours[i].second->fitness;
+        for (size_t f = 0; f < prediction.size() && f < fitness.size(); ++f) {
+            prediction[f] += weight * fitness[f];
+        }
+    }
+    return prediction;
+}
+
+vector<CandidateSolution*> Surrogate::screen(vector<CandidateSolution*>& candidates, double fraction)
+{
+    vector<pair<CandidateSolution*, vector<double>>> ranking;
+    ranking.reserve(candidates.size());
+    for (CandidateSolution* candidate: candidates) {
+        ranking.push_back(make_pair(candidate, predict(*candidate)));
+    }
+    stable_sort(ranking.begin(), ranking.end(),
+        [] (const pair<CandidateSolution*, vector<double>>& a, const pair<CandidateSolution*, vector<double>>& b) {
+            return compareValues(a.second, b.second) > 0;
+        });
+    
+    const size_t kept = max<size_t>(1, (size_t) ceil(fraction * ranking.size()));
+    vector<CandidateSolution*> discarded;
+    candidates.clear();
+    for (size_t i = 0; i < ranking.size(); ++i) {
+        if (i < kept) {
+            candidates.push_back(ranking[i].first);
+            m_predictions.push_back(make_pair(ranking[i].first, std::move(ranking[i].second)));
+        } else {
+            discarded.push_back(ranking[i].first);
+        }
+    }
+    
+    m_screenedCount += ranking.size();
+    m_discardedCount += discarded.size();
+    return discarded;
+}
+
+size_t Surrogate::assess()
+{
+    vector<pair<const vector<double>*, const vector<double>*>> assessed;
+    double absoluteError = 0;
+    unsigned long errorCount = 0;
+    for (const auto& prediction: m_predictions) {
+        const Fitness& fitness = prediction.first->getRawFitness();
+        if (!fitness.getIsValid() || prediction.first->isRacedOut()) {
+            continue;
+        }
+        for (size_t f = 0; f < prediction.second.size() && f < fitness.getValues().size(); ++f) {
+            absoluteError += abs(prediction.second[f] - fitness.getValues()[f]);
+            ++errorCount;
+        }
+        assessed.push_back(make_pair(&prediction.second, &fitness.getValues()));
+    }
+    
+    double concordantPairs = 0;
+    unsigned long rankedPairs = 0;
+    for (size_t i = 0; i < assessed.size(); ++i) {
+        for (size_t j = i + 1; j < assessed.size(); ++j) {
+            const int actual = compareValues(*assessed[i].second, *assessed[j].second);
+            if (actual == 0) {
+                continue;
+            }
+            const int predicted = compareValues(*assessed[i].first, *assessed[j].first);
+            concordantPairs += predicted == 0 ? 0.5 : (predicted == actual ? 1 : 0);
+            ++rankedPairs;
+        }
+    }
+    
+    m_absoluteError += absoluteError;
+    m_errorCount += errorCount;
+    m_concordantPairs += concordantPairs;
+    m_rankedPairs += rankedPairs;
+    m_lastError = errorCount ? absoluteError / errorCount : 0;
+    m_lastAgreement = rankedPairs ? concordantPairs / rankedPairs : 0;
+    m_lastAssessed = assessed.size();
+    
+    m_predictions.clear();
+    return m_lastAssessed;
+}
+
+void Surrogate::clear()
+{
+    m_samples.clear();
+    m_nextSample = 0;
+    m_predictions.clear();
+}
+
+size_t Surrogate::getMemoryUsage() const
+{
+    size_t bytes = m_samples.capacity() * sizeof(Sample);
+    for (const Sample& sample: m_samples) {
+        bytes += sample.sketch.getMemoryUsage() + sample.fitness.capacity() * sizeof(double);
+    }
+    return bytes;
+}
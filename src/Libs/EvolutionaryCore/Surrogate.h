@@ -0,0 +1,164 @@
+/***********************************************************************\
+|                                                                       |
+| Surrogate.h                                                           |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+#ifndef HEADER_UGP3_CORE_SURROGATE
+#define HEADER_UGP3_CORE_SURROGATE
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Entropy.h"
+
+namespace ugp3 {
+namespace core {
+
+class CandidateSolution;
+
+/**
+ * Online model of the fitness, used to screen the offspring before their
+ * evaluation: only the most promising ones are sent to the evaluator.
+ * 
+ * The model is a k-nearest neighbours regression over the last evaluated
+ * candidates. The features of a candidate are the symbols of its entropic
+ * message, compared through their sketches (see MessageSketch), so that a
+ * prediction costs O(samples * sketch size) and does not need the messages
+ * of the samples. The predicted fitness is the mean of the raw fitness of
+ * the k samples most similar to the candidate, weighted by their similarity.
+ * 
+ * The accuracy of the model is measured on the offspring that are evaluated
+ * anyway: the predictions are compared with their actual fitness before the
+ * model learns from them.
+ */
+class Surrogate
+{
+private:
+    struct Sample
+    {
+        MessageSketch sketch;
+        std::vector<double> fitness;
+    };
+    
+    // Last evaluated candidates, used as a circular buffer
+    std::vector<Sample> m_samples;
+    std::size_t m_nextSample = 0;
+    
+    unsigned int m_neighbours = 5;
+    std::size_t m_capacity = 500;
+    
+    // Predictions waiting for the evaluation of their candidates
+    std::vector<std::pair<const CandidateSolution*, std::vector<double>>> m_predictions;
+    
+    // Statistics, since the beginning of the run
+    unsigned long m_screenedCount = 0;
+    unsigned long m_discardedCount = 0;
+    double m_absoluteError = 0;
+    unsigned long m_errorCount = 0;
+    double m_concordantPairs = 0;
+    unsigned long m_rankedPairs = 0;
+    
+    // Statistics of the last assessment
+    double m_lastError = 0;
+    double m_lastAgreement = 0;
+    std::size_t m_lastAssessed = 0;
+    
+public:
+    unsigned int getNeighbours() const { return m_neighbours; }
+    void setNeighbours(unsigned int value);
+    
+    /**
+     * Maximum number of samples: older samples are replaced by new ones.
+     */
+    std::size_t getCapacity() const { return m_capacity; }
+    void setCapacity(std::size_t value);
+    
+    std::size_t getSampleCount() const { return m_samples.size(); }
+    
+    /**
+     * The model can predict once it has at least k samples.
+     */
+    bool isReady() const { return m_samples.size() >= m_neighbours; }
+    
+    /**
+     * Add the raw fitness of the given candidate to the samples.
+     * The fitness must be valid and come from a complete evaluation.
+     */
+    void train(const CandidateSolution& candidate);
+    
+    /**
+     * Predicted raw fitness of the given candidate. The model must be ready.
+     */
+    std::vector<double> predict(const CandidateSolution& candidate) const;
+    
+    /**
+     * Rank the given candidates by predicted fitness (best first, ties keep
+     * their order) and split them: the first ceil(fraction * size) of them,
+     * at least one, are kept in the vector and their predictions are
+     * remembered until assess(); the others are returned.
+     */
+    std::vector<CandidateSolution*> screen(std::vector<CandidateSolution*>& candidates, double fraction);
+    
+    /**
+     * Compare the remembered predictions with the actual raw fitness of
+     * their candidates, then forget them. Candidates without a valid
+     * fitness, or dropped by a racing evaluation, are ignored. Must be called before the candidates die.
+     * @return Number of predictions assessed.
+     */
+    std::size_t assess();
+    
+    /**
+     * Forget the samples and the pending predictions, keeping the statistics.
+     */
+    void clear();
+    
+    unsigned long getScreenedCount() const { return m_screenedCount; }
+    unsigned long getDiscardedCount() const { return m_discardedCount; }
+    
+    /**
+     * Mean absolute error of the predicted fitness values, and fraction of
+     * the pairs of candidates with a different fitness that the predictions
+     * ranked in the right order. Both are 0 when nothing was assessed.
+     */
+    double getMeanError() const { return m_errorCount ? m_absoluteError / m_errorCount : 0; }
+    double getRankAgreement() const { return m_rankedPairs ? m_concordantPairs / m_rankedPairs : 0; }
+    
+    /**
+     * Same statistics, for the last call to assess() only.
+     */
+    std::size_t getLastAssessed() const { return m_lastAssessed; }
+    double getLastMeanError() const { return m_lastError; }
+    double getLastRankAgreement() const { return m_lastAgreement; }
+    
+    /**
+     * Approximate number of bytes retained by the samples.
+     */
+    std::size_t getMemoryUsage() const;
+};
+
+}
+}
+
+#endif // HEADER_UGP3_CORE_SURROGATE
@@ -52,7 +52,7 @@ std::vector< CandidateSolution* > TournamentSelection::infinitePressureSelection
     if (Random::nextDouble() < this->fitnessHole) {
         sortByHole(population, m_selectable.begin(), m_selectable.end());
     } else {
-        sortByFitness(population, m_selectable.begin(), m_selectable.end());
+        sortSelectableByFitness(population);
     }
     
     // Choose the best
@@ -277,14 +277,19 @@ std::vector< CandidateSolution* > TwoStepTournamentSelectionWithFitnessHole::cus
                     }
                 );
                 // Choose the candidate that is most diverse from already selected candidates
-                // We use the entropic distance (because it is always available)
+                // We use the entropic distance (because it is always available),
+                // or its estimate from the sketches of the messages
                 // FIXME maybe use other distances when possible
                 double maxDistance = -1;
                 CandVecIt maxCandidate = end;
                 for (CandVecIt candIt: secondStepCandidates) {
                     double meanDistance = 0;
                     for (CandidateSolution* selected: selectedCandidates) {
-                        meanDistance += Distances::entropic(selected->getMessage(), (*candIt)->getMessage());
+                        if (m_approximateDistance) {
+                            meanDistance += Distances::approximateEntropic(selected->getSketch(), (*candIt)->getSketch());
+                        } else {
+                            meanDistance += Distances::entropic(selected->getMessage(), (*candIt)->getMessage());
+                        }
                     }
                     meanDistance /= selectedCandidates.size();
                     if (meanDistance > maxDistance) {
@@ -119,7 +119,7 @@ public: // friend class, used for the graphical user interface
 
 class TournamentSelectionWithFitnessHole : public TournamentSelection
 {
-private:
+protected:
 	static const std::string XML_ATTRIBUTE_FITNESSHOLE;
     
 public:
@@ -143,11 +143,27 @@ public: // friend class, used for the graphical user interface
  */
 class TwoStepTournamentSelectionWithFitnessHole : public TournamentSelectionWithFitnessHole
 {
+private:
+	static const std::string XML_ATTRIBUTE_DISTANCE;
+    
+    // Measure diversity with the sketches of the messages instead of the messages
+    bool m_approximateDistance = false;
+    
 public:
     static const std::string XML_SCHEMA_TYPE;
+    static const std::string DISTANCE_ENTROPIC;
+    static const std::string DISTANCE_APPROXIMATEENTROPIC;
     
 protected:
     virtual std::vector< CandidateSolution* > customSelection(const Population& population, unsigned int count, double pressionMultiplier) const;
+    
+public:
+    bool getApproximateDistance() const { return m_approximateDistance; }
+    void setApproximateDistance(bool value) { m_approximateDistance = value; }
+    
+public: // Xml interface
+	virtual void writeXml(std::ostream& output) const;
+	virtual void readXml(const xml::Element& element);
 };
 
 inline void TournamentSelectionWithFitnessHole::setFitnessHole(double value)
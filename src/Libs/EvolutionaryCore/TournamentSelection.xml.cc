@@ -43,6 +43,9 @@ const string TournamentSelection::XML_ATTRIBUTE_METATAUMAX = "metaTauMax";
 const string TournamentSelection::XML_ATTRIBUTE_METATAUMIN = "metaTauMin";
 
 const string TournamentSelectionWithFitnessHole::XML_ATTRIBUTE_FITNESSHOLE = "fitnessHole";
+const string TwoStepTournamentSelectionWithFitnessHole::XML_ATTRIBUTE_DISTANCE = "distance";
+const string TwoStepTournamentSelectionWithFitnessHole::DISTANCE_ENTROPIC = "entropic";
+const string TwoStepTournamentSelectionWithFitnessHole::DISTANCE_APPROXIMATEENTROPIC = "approximateEntropic";
 
 void TournamentSelectionWithFitnessHole::writeXml(std::ostream& output) const
 {
@@ -66,6 +69,43 @@ void TournamentSelectionWithFitnessHole::readXml(const xml::Element& element)
 	this->fitnessHole = xml::Utility::attributeValueToDouble(element, XML_ATTRIBUTE_FITNESSHOLE);
 }
 
+void TwoStepTournamentSelectionWithFitnessHole::writeXml(std::ostream& output) const
+{
+	output << "<" << this->getXmlName()
+        << " " 
+        << XML_ATTRIBUTE_TYPE << "=\"" << XML_SCHEMA_TYPE << "\""
+		<< " " 
+		<< XML_ATTRIBUTE_TAU << "=\"" << this->getTau() << "\""
+		<< " " 
+		<< XML_ATTRIBUTE_TAUMIN << "=\"" << this->getTauMin() << "\""
+		<< " " 
+		<< XML_ATTRIBUTE_TAUMAX << "=\"" << this->getTauMax() << "\""
+		<< " " 
+		<< XML_ATTRIBUTE_FITNESSHOLE << "=\"" << this->getFitnessHole() << "\""
+		<< " " 
+		<< XML_ATTRIBUTE_DISTANCE << "=\"" << (m_approximateDistance ? DISTANCE_APPROXIMATEENTROPIC : DISTANCE_ENTROPIC) << "\" />" << endl;
+}
+
+void TwoStepTournamentSelectionWithFitnessHole::readXml(const xml::Element& element)
+{
+	TournamentSelectionWithFitnessHole::readXml(element);
+	
+	// Optional, the exact entropic distance by default
+	m_approximateDistance = false;
+	if (element.Attribute(XML_ATTRIBUTE_DISTANCE) != nullptr)
+	{
+		const string distance = xml::Utility::attributeValueToString(element, XML_ATTRIBUTE_DISTANCE);
+		if (distance == DISTANCE_APPROXIMATEENTROPIC)
+		{
+			m_approximateDistance = true;
+		}
+		else if (distance != DISTANCE_ENTROPIC)
+		{
+			throw xml::SchemaException("selection type \"" + XML_SCHEMA_TYPE + "\" accepts only \"" + DISTANCE_ENTROPIC + "\" or \"" + DISTANCE_APPROXIMATEENTROPIC + "\" as " + XML_ATTRIBUTE_DISTANCE + ".", LOCATION);
+		}
+	}
+}
+
 void TournamentSelection::writeXml(std::ostream& output) const
 {
 	output << "<" << this->getXmlName()
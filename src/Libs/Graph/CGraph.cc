@@ -338,13 +338,13 @@ void CGraph::clear()
 	this->subGraphs.clear();
 }
 
-CNode* CGraph::getNode(const string& id) const
+CNode* CGraph::getNode(NodeHandle handle) const
 {
     _STACK;
 
     for(unsigned int i = 0; i < this->subGraphs.size(); i++)
     {
-        CNode* node = this->subGraphs[i]->getNode(id);
+        CNode* node = this->subGraphs[i]->getNode(handle);
 
         if(node != nullptr)
         {
@@ -352,12 +352,12 @@ CNode* CGraph::getNode(const string& id) const
         }
     }
 
-    if(this->prologue->getId() == id)
+    if(this->prologue->getHandle() == handle)
     {
         return this->prologue.get();
     }
 
-    if(this->epilogue->getId() == id)
+    if(this->epilogue->getHandle() == handle)
     {
         return this->epilogue.get();
     }
@@ -365,7 +365,7 @@ CNode* CGraph::getNode(const string& id) const
     return nullptr;
 }
 
-void CGraph::writeExternalRepresentation(ostream& stream, Relabeller& relabeller) const
+void CGraph::appendExternalRepresentation(string& buffer, Relabeller& relabeller) const
 {
     _STACK;
 
@@ -392,17 +392,15 @@ void CGraph::writeExternalRepresentation(ostream& stream, Relabeller& relabeller
 	}
 
     Assert(prologue.get() != nullptr);
-    LOG_DEBUG << "Dumping the section prologue " << prologue->toString() << ends;
-    prologue->writeExternalRepresentation(stream, relabeller);
+    prologue->appendExternalRepresentation(buffer, relabeller);
 
     for(unsigned int i = 0; i < this->subGraphs.size(); i++)
     {
-        this->subGraphs[i]->writeExternalRepresentation(stream, relabeller);
+        this->subGraphs[i]->appendExternalRepresentation(buffer, relabeller);
     }
 
      Assert(epilogue.get() != nullptr);
-     LOG_DEBUG << "Dumping the section epilogue " << epilogue->toString() << ends;
-     epilogue->writeExternalRepresentation(stream, relabeller);
+     epilogue->appendExternalRepresentation(buffer, relabeller);
 }
 
 bool CGraph::equals( const CGraph& graph ) const
@@ -135,7 +135,8 @@ namespace ugp3
 			/** Searches for a node with given identifier.
 			@param id A string representing the id of the node.
 			@return A valid pointer to a CNode instance or nullptr if no node with the specified id cannot be found. */
-			CNode* getNode(const std::string& id) const;
+			using NodeContainer::getNode;
+			virtual CNode* getNode(tgraph::NodeHandle handle) const;
 
 			/** Returns the parent container of this instance. */
 			IContainer<CGraph>* getParentContainer() const;
@@ -170,7 +171,7 @@ namespace ugp3
 			virtual void clear();
 			virtual void buildRandom();
 			virtual bool validate() const;
-			virtual void writeExternalRepresentation(std::ostream& stream, Relabeller& relabeller) const;
+			virtual void appendExternalRepresentation(std::string& buffer, Relabeller& relabeller) const;
 
 		public: // IString interface
 			virtual const std::string toString() const;
@@ -144,11 +144,10 @@ bool CGraphContainer::attachOuterLabel(CNode& node, const OuterLabelParameter& o
 	bool targetFound = false;
 
     // chance 1: see if there is the same target to which the edge was referring before it was detached
-    if(edge->containsTag(Edge::targetTagName) == true)
+    if(edge->hasFloatingTarget() == true)
     {
-    	const string& targetNodeId = edge->getTag(Edge::targetTagName).getValue();
-    	CNode* targetNode = this->getNode(targetNodeId);
-    	edge->removeTag(Edge::targetTagName);
+    	CNode* targetNode = this->getNode(edge->getFloatingTarget());
+    	edge->clearFloatingTarget();
 
     	// the target must not belong to the source subgraph (otherwise it isn't an outer label)
     	if(targetNode != nullptr && targetNode->getParentContainer() != node.getParentContainer())
@@ -175,18 +174,17 @@ bool CGraphContainer::attachOuterLabel(CNode& node, const OuterLabelParameter& o
     else LOG_DEBUG << "Node " << node << ": previous target information was not found" << ends;
 
     // chance 2: see if there is an offset (used on cloned individuals)
-    if(targetFound == false && edge->containsTag(Edge::offsetTagName) && edge->containsTag("section"))
+    if(targetFound == false && edge->hasFloatingOffset() && edge->hasFloatingSection())
     // offset found
     {
     	// search for the target graph
-        const string sectionName = edge->getTag("section").getValue();
+        const string sectionName = edge->getFloatingSection();
         CGraph* graph = this->getCGraph(sectionName);
-        edge->removeTag("section");
+        edge->clearFloatingSection();
 
 		// get the subgraph's index
-        const string& offsetString = edge->getTag(Edge::offsetTagName).getValue();
-        unsigned int offset = Convert::toUInt(offsetString);
-        edge->removeTag(Edge::offsetTagName);
+        unsigned int offset = (unsigned int)edge->getFloatingOffset();
+        edge->clearFloatingOffset();
 
         // the information is valid only if the index does not exceed the sub-graph count
         if(offset < graph->getSubGraphCount())
@@ -432,14 +430,14 @@ CSubGraph* CGraphContainer::getRandomSubGraph(const string& sectionName, const s
 	}
 }
 
-CNode* CGraphContainer::getNode(const string& id) const
+CNode* CGraphContainer::getNode(NodeHandle handle) const
 {
     _STACK;
 
     // search for node inside the graphs
     for(unsigned int i = 0; i < this->graphs.size(); i++)
     {
-        CNode* node = this->graphs[i]->getNode(id);
+        CNode* node = this->graphs[i]->getNode(handle);
         if(node != nullptr)
         {
             return node;
@@ -447,13 +445,13 @@ CNode* CGraphContainer::getNode(const string& id) const
     }
     
     // but the node could also be the global prologue/epilogue
-    if( this->prologue->getId().compare(id) == 0 ) return this->prologue.get();
-    if( this->epilogue->getId().compare(id) == 0 ) return this->epilogue.get();
+    if( this->prologue->getHandle() == handle ) return this->prologue.get();
+    if( this->epilogue->getHandle() == handle ) return this->epilogue.get();
 
     return nullptr;
 }
 
-void CGraphContainer::writeExternalRepresentation(ostream& stream, Relabeller& relabeller) const
+void CGraphContainer::appendExternalRepresentation(string& buffer, Relabeller& relabeller) const
 {
     _STACK;
 
@@ -462,17 +460,15 @@ void CGraphContainer::writeExternalRepresentation(ostream& stream, Relabeller& r
     LOG_DEBUG << "Requested a dump for CGraphContainer" << ends;
 
     Assert(prologue.get() != nullptr);
-    LOG_DEBUG << "Dumping the global prologue " << this->prologue->toString() << ends;
-    prologue->writeExternalRepresentation(stream, relabeller);
+    prologue->appendExternalRepresentation(buffer, relabeller);
 
     for( unsigned int i=0; i<graphs.size(); i++ )
     {
-        graphs[i]->writeExternalRepresentation(stream, relabeller);
+        graphs[i]->appendExternalRepresentation(buffer, relabeller);
     }
 
     Assert(epilogue.get() != nullptr);
-    LOG_DEBUG << "Dumping the global epilogue " << this->epilogue->toString() << ends;
-    epilogue->writeExternalRepresentation(stream, relabeller);
+    epilogue->appendExternalRepresentation(buffer, relabeller);
 }
 
 bool CGraphContainer::contains(const CGraph& graph) const
@@ -123,7 +123,8 @@ namespace ugp3
             /** Returns the node with the given id.
                 @param id The id of the CNode to be retrieved.
                 @return A valid pointer to the specified node or nullptr if the specified id is not found. */
-            CNode* getNode(const std::string& id) const;
+            using NodeContainer::getNode;
+            virtual CNode* getNode(tgraph::NodeHandle handle) const;
 
             /** Returns a random sub-graph with the given SubSection name.
                 @param sectionName The name of the section corresponding to the graph in which the sub-graph is sampled.
@@ -162,7 +163,7 @@ namespace ugp3
 			virtual void clear();
 			virtual void buildRandom();
 			virtual bool validate() const;
-			virtual void writeExternalRepresentation(std::ostream& stream, Relabeller& relabeller) const;
+			virtual void appendExternalRepresentation(std::string& buffer, Relabeller& relabeller) const;
 
 		public: // IString interface
 			virtual const std::string toString() const;
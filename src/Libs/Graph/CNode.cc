@@ -37,7 +37,7 @@ using namespace xml;
 
 InfinityString CNode::uniqueTagGenerator;
 
-const string CNode::Escape = "$";
+const string CNode::Escape = Expression::TagEscape;
 const string CNode::TAG_PLACE = "place";
 const string CNode::TAG_NEXT = "next";
 const string CNode::TAG_PREV = "prev";
@@ -297,14 +297,14 @@ bool CNode::validate() const
     return true;
 }
 
-void CNode::writeExternalRepresentation( ostream& stream, Relabeller& relabeller ) const
+void CNode::appendExternalRepresentation( string& buffer, Relabeller& relabeller ) const
 {
     _STACK;
 
 	if(getConstrain() == nullptr)
 	    throw Exception("Constrain not available.", LOCATION);
 
-    LOG_DEBUG << "Dumping object ugp3::ctgraph::CNode " << this << ends;
+    const IdentifierFormat& identifierFormat = *this->getConstrain()->getIdentifierFormat();
 
     if(getBackEdgeCount() > 0)
     // Referenced node. Print label
@@ -320,95 +320,73 @@ void CNode::writeExternalRepresentation( ostream& stream, Relabeller& relabeller
         if(expand == false
         || (expand == true && getBackEdgeCount() > countIncomingOuterLabels()) )
         {
-        	const string& identifier = this->getConstrain()->getIdentifierFormat()->get(relabeller.translate(this->getId()));
-        	const string& label = this->getConstrain()->getLabelFormat()->get(identifier);
-
-        	stream << label;
+            this->getConstrain()->getLabelFormat()->appendTo(buffer, identifierFormat, relabeller.translate(*this));
         }
     }
 
-
-    for( unsigned int i=0; i< this->getGenericMacro().getExpression().getElements().size(); i++ )
+    // the program is compiled when the constraints are loaded: no need to inspect the parameters here
+    const vector<Expression::EmissionStep>& program = this->getGenericMacro().getExpression().getProgram();
+    for( unsigned int i=0; i < program.size(); i++ )
     {
-        const ExpressionElement *currentElement = this->getGenericMacro().getExpression().getElements().at(i);
+        const Expression::EmissionStep& step = program[i];
 
-        if( currentElement->getParameter() != nullptr)
-       	// this is a parameter
+        switch(step.kind)
         {
-            const Parameter* parameter = currentElement->getParameter();
-            LOG_DEBUG << "Writing parameter " << parameter << "" << ends;
+        case Expression::LITERAL:
+            buffer += step.text;
+            break;
+
+        case Expression::DATA:
+            buffer += this->getTag(step.text).getValue();
+            break;
 
-            if(dynamic_cast<const DataParameter*>(parameter) != nullptr)
+        case Expression::UNIQUETAG:
             {
-                const Tag& parameterTag = this->getTag(CNode::Escape + parameter->getName());
-                stream << parameterTag.getValue();
+                const UniqueTagFormat& uniqueTagFormat = *this->getConstrain()->getUniqueTagFormat();
+                buffer += uniqueTagFormat.getTextBefore();
+                identifierFormat.appendTo(buffer, this->getTag(step.text).getValue());
+                buffer += uniqueTagFormat.getTextAfter();
             }
-            else
-            {
-                string value = "";
-                if(dynamic_cast<const UniqueTagParameter*>(parameter) != nullptr)
-                {
-                    const Tag& parameterTag = this->getTag(CNode::Escape + parameter->getName());
+            break;
 
-                    value = parameterTag.getValue();
+        case Expression::SELFREF:
+            identifierFormat.appendTo(buffer, this->getTag(step.text).getValue());
+            break;
 
-                    const string& identifier = this->getConstrain()->getIdentifierFormat()->get(value);
-                	const string& uniqueTag = this->getConstrain()->getUniqueTagFormat()->get(identifier);
-				    stream << uniqueTag;
-                }
-                else if(dynamic_cast<const SelfRefParameter*>(parameter) != nullptr)
-                {
-                    const Tag& parameterTag = this->getTag(CNode::Escape + parameter->getName());
+        case Expression::INNERLABEL:
+            {
+                Edge* edge = this->getEdge(step.text);
 
-                    value = parameterTag.getValue();
+                Assert(edge != nullptr);
+                Assert(edge->getTo() != nullptr);
+                Assert(dynamic_cast<CNode*>(edge->getTo()) != nullptr);
 
-                    const string& identifier = this->getConstrain()->getIdentifierFormat()->get(value);
-				    stream << identifier;
-                }
-                else if(dynamic_cast<const InnerLabelParameter*>(parameter) != nullptr)
-                {
-                    Edge* edge = this->getEdge(parameter->getName());
+                CNode* node = (CNode*) edge->getTo();
+                identifierFormat.appendTo(buffer, relabeller.translate(*node));
+            }
+            break;
 
-                    Assert(edge != nullptr);
-                    Assert(edge->getTo() != nullptr);
-                    Assert(dynamic_cast<CNode*>(edge->getTo()) != nullptr);
+        case Expression::OUTERLABEL:
+            {
+                Edge* edge = this->getEdge(step.text);
 
-                    CNode* node = (CNode*) edge->getTo();
-                    value = relabeller.translate(node->getId());
+                Assert(edge != nullptr);
+                Assert(edge->getTo() != nullptr);
+                Assert(dynamic_cast<CNode*>(edge->getTo()) != nullptr);
 
-                    const string& identifier = this->getConstrain()->getIdentifierFormat()->get(value);
-				    stream << identifier;
+                CNode* node = (CNode*) edge->getTo();
+                Assert(dynamic_cast<const CSubGraph*>(node->getParentContainer()) != nullptr);
+                const CSubGraph* targetParent = (const CSubGraph*)node->getParentContainer();
+                if(targetParent->getSubSection().getExpand() == true)
+                {
+                    targetParent->appendExternalRepresentation(buffer, relabeller);
                 }
-                else if(dynamic_cast<const OuterLabelParameter*>(parameter) != nullptr)
+                else
                 {
-                    Edge* edge = this->getEdge(parameter->getName());
-
-                    Assert(edge != nullptr);
-                    Assert(edge->getTo() != nullptr);
-                    Assert(dynamic_cast<CNode*>(edge->getTo()) != nullptr);
-
-                    CNode* node = (CNode*) edge->getTo();
-                    Assert(dynamic_cast<const CSubGraph*>(node->getParentContainer()) != nullptr);
-                    const CSubGraph* targetParent = (const CSubGraph*)node->getParentContainer();
-                    if(targetParent->getSubSection().getExpand() == true)
-                    {
-
-                            targetParent->writeExternalRepresentation(stream, relabeller);
-                    }
-                    else
-                    {
-                        value = relabeller.translate(node->getId());
-
-                        const string& identifier = this->getConstrain()->getIdentifierFormat()->get(value);
-				        stream << identifier;
-                    }
+                    identifierFormat.appendTo(buffer, relabeller.translate(*node));
                 }
             }
-        }
-        else
-        {
-            LOG_DEBUG << "Writing token \"" << *currentElement->getCharacters() << "\"" << ends;
-            stream << *currentElement->getCharacters();
+            break;
         }
     }
 }
@@ -635,17 +613,8 @@ bool CNode::randomizeParameter(unsigned int i)
 		// the edge contains the target name and/or offset so, remove them
 		edge->setTo(nullptr); // but first, set the edge as "floating"
 
-		if(edge->containsTag(Edge::targetTagName))
-		{
-			edge->removeTag(Edge::targetTagName);
-			LOG_DEBUG << "Removing \"" << Edge::targetTagName << "\"..." << ends;
-		}
-
-		if(edge->containsTag(Edge::offsetTagName))
-		{
-			edge->removeTag(Edge::offsetTagName);
-			LOG_DEBUG << "Removing \"" << Edge::offsetTagName << "\"..." << ends;
-		}
+		edge->clearFloatingTarget();
+		edge->clearFloatingOffset();
 	
 		/*  DO NOT compute a new target here, it will be randomly assigned when CSubGraph::attachFloatingEdge() is called */
 	}
@@ -842,7 +811,7 @@ void CNode::detachOuterLabel(const OuterLabelParameter& outerLabel)
     //   - "section: <target_section_name>"
     //   - "offset: <index_of_subgraph>"
 	edge->setTo(nullptr);
-	edge->addTag(Edge::targetTagName, targetNode->getId());
+	edge->setFloatingTarget(targetNode->getHandle());
 
     // save the position of the subSection in the list of subSections
     Assert(dynamic_cast<const Section*>(subGraph->getSubSection().getParent()) != nullptr);
@@ -853,10 +822,10 @@ void CNode::detachOuterLabel(const OuterLabelParameter& outerLabel)
     {
         if(&subGraph->getSubSection() == &section->getSubSection(pos))
         {
-            edge->addTag(Edge::offsetTagName, Convert::toString(pos));
+            edge->setFloatingOffset(pos);
 
             // save the path "section"
-            edge->addTag("section", section->getId());
+            edge->setFloatingSection(section->getId());
             break;
         }
     }
@@ -921,8 +890,8 @@ void CNode::detachInnerLabel(const InnerLabelParameter& innerLabel)
     // add a new floating edge with the offset information
     int offset = subGraph->getOffset(*this, *targetNode);
     Edge* newEdge = this->addFloatingEdge(innerLabel);
-    newEdge->addTag(Edge::targetTagName, targetNode->getId());
-    newEdge->addTag(Edge::offsetTagName, Convert::toString(offset));
+    newEdge->setFloatingTarget(targetNode->getHandle());
+    newEdge->setFloatingOffset(offset);
 }
 
 unique_ptr<CNode> CNode::clone() const
@@ -998,24 +967,22 @@ unique_ptr<CNode> CNode::clone() const
                 //   - "offset: <offset_to_target>"
                 //   - "parameter: <inner_label_name>"
                 Edge* newEdge = node->addFloatingEdge(*structuralParameter);
-                newEdge->addTag(Edge::offsetTagName, Convert::toString(offset));
-                newEdge->addTag(Edge::targetTagName, targetNode->getId());
+                newEdge->setFloatingOffset(offset);
+                newEdge->setFloatingTarget(targetNode->getHandle());
             }
             else
             // the edge is floating
             {
                 Edge* newEdge = node->addFloatingEdge(*structuralParameter);
 
-                if(edge->containsTag(Edge::offsetTagName))
+                if(edge->hasFloatingOffset())
                 {
-                    const Tag& offsetTag = edge->getTag(Edge::offsetTagName);
-                    newEdge->addTag(offsetTag.getName(), offsetTag.getValue());
+                    newEdge->setFloatingOffset(edge->getFloatingOffset());
                 }
 
-                if(edge->containsTag(Edge::targetTagName))
+                if(edge->hasFloatingTarget())
                 {
-                    const Tag& targetTag = edge->getTag(Edge::targetTagName);
-                    newEdge->addTag(targetTag.getName(), targetTag.getValue());
+                    newEdge->setFloatingTarget(edge->getFloatingTarget());
                 }
             }
         }
@@ -1041,7 +1008,7 @@ unique_ptr<CNode> CNode::clone() const
                 //   - "offset: <subsection_index>"
                 //   - "parameter: <outer_label_name>"
 
-                newEdge->addTag(Edge::targetTagName, targetNode->getId());
+                newEdge->setFloatingTarget(targetNode->getHandle());
 
                 CSubGraph* sGraph = dynamic_cast<CSubGraph*>(targetNode->getParentContainer());
                 CGraph* graph = dynamic_cast<CGraph*>(sGraph->getParentContainer());
@@ -1057,22 +1024,19 @@ unique_ptr<CNode> CNode::clone() const
                 }
 
 
-                newEdge->addTag(Edge::offsetTagName, Convert::toString(subGraphOffset));
-                newEdge->addTag("section", sectionName);
+                newEdge->setFloatingOffset(subGraphOffset);
+                newEdge->setFloatingSection(sectionName);
             }
             else
             // the edge is floating
             {
                 // additional information must be present on the edge
-                Assert(edge->containsTag("section"));
-                Assert(edge->containsTag(Edge::offsetTagName));
+                Assert(edge->hasFloatingSection());
+                Assert(edge->hasFloatingOffset());
 
                 // copy the information
-                Tag& sectionTag = edge->getTag("section");
-                newEdge->addTag(sectionTag.getName(), sectionTag.getValue());
-
-                Tag& offsetTag = edge->getTag(Edge::offsetTagName);
-                newEdge->addTag(offsetTag.getName(), offsetTag.getValue());
+                newEdge->setFloatingSection(edge->getFloatingSection());
+                newEdge->setFloatingOffset(edge->getFloatingOffset());
             }
         }
     }
@@ -1086,11 +1050,7 @@ void CNode::setInfinityString(const string& value)
     _STACK;
 
 	// update the id generator for the nodes
-
-	// create a new infinity string from the specified value
-    InfinityString newVal(value);
-
-    Node::idCounter = newVal;
+    Node::handleCounter = InfinityString::toNumber(value);
 }
 
 Edge* CNode::getEdge(const string& parameterName) const
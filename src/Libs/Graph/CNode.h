@@ -138,7 +138,7 @@ public: // ConstrainedElement interface
 	virtual void clear();
 	virtual void buildRandom();
 	virtual bool validate() const;
-	virtual void writeExternalRepresentation(std::ostream& stream, Relabeller& relabeller) const;
+	virtual void appendExternalRepresentation(std::string& buffer, Relabeller& relabeller) const;
 
 public: // Xml interface
 	virtual void writeXml(std::ostream& output) const;
@@ -209,7 +209,7 @@ inline void CNode::setPrev(CNode* node)
 
 inline const std::string CNode::getInfinityString()
 {
-	return idCounter.toString();
+	return InfinityString::fromNumber(handleCounter);
 }
 
 }
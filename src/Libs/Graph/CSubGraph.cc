@@ -123,9 +123,9 @@ void CSubGraph::addNode(CNode& node)
 {
     _STACK;
 
-    if(this->nodes.count(node.getId()) == 0)
+    if(this->nodes.count(node.getHandle()) == 0)
     {
-        this->nodes[node.getId()] = &node;
+        this->nodes[node.getHandle()] = &node;
     }
     else throw Exception("Duplicate node id.", LOCATION);
 }
@@ -356,7 +356,7 @@ CNode* CSubGraph::getTargetFromFloatingEdgeUsingOffset(const CNode& node, const
     // the target must not be set
     Assert(edge.getTo() == nullptr);
     // the edge must contain the offset information
-    Assert(edge.containsTag(Edge::offsetTagName));
+    Assert(edge.hasFloatingOffset());
 
 #ifndef NDEBUG
     bool edgeFound = false;
@@ -373,9 +373,8 @@ CNode* CSubGraph::getTargetFromFloatingEdgeUsingOffset(const CNode& node, const
 #endif
 
 
-    const Tag& offsetTag = edge.getTag(Edge::offsetTagName);
     // get the relative position of the target node
-    const int offset = Convert::toInt(offsetTag.getValue());
+    const int offset = edge.getFloatingOffset();
 
     // get the parameter associated to the edge
     Assert(edge.containsTag(Edge::parameterTagName));
@@ -548,7 +547,7 @@ CNode* CSubGraph::getRandomTargetForInnerLabel(
     return (CNode*)candidateList[randomSample];
 }
 
-void CSubGraph::writeExternalRepresentation(ostream& stream, Relabeller& relabeller) const
+void CSubGraph::appendExternalRepresentation(string& buffer, Relabeller& relabeller) const
 {
     _STACK;
 
@@ -557,7 +556,7 @@ void CSubGraph::writeExternalRepresentation(ostream& stream, Relabeller& relabel
     CNode* cursor = this->prologue;
     while(cursor != nullptr)
     {
-        cursor->writeExternalRepresentation(stream, relabeller);
+        cursor->appendExternalRepresentation(buffer, relabeller);
         cursor = cursor->getNext();
     }
 }
@@ -617,11 +616,11 @@ bool CSubGraph::equals(const CSubGraph& subGraph) const
     return true;
 }
 
-CNode* CSubGraph::getNode(const string& id) const
+CNode* CSubGraph::getNode(NodeHandle handle) const
 {
     _STACK;
 
-    map<string, CNode*>::const_iterator iterator = this->nodes.find(id);
+    auto iterator = this->nodes.find(handle);
 
     if(iterator != this->nodes.end())
     {
@@ -710,7 +709,7 @@ bool CSubGraph::attachFloatingEdges()
     {
         CNode& node = this->slice.getNode(i);
 
-        this->nodes[node.getId()] = &node;
+        this->nodes[node.getHandle()] = &node;
 
         setAsParent(&node, this);
     }
@@ -766,24 +765,21 @@ bool CSubGraph::restoreInnerLabel(CNode& node, const InnerLabelParameter& innerL
 
         CNode* targetNode = nullptr;
 
-        if(edge.containsTag(Edge::targetTagName))
+        if(edge.hasFloatingTarget())
         // a target exists
         {
-            Tag& targetTag = edge.getTag(Edge::targetTagName);
-
             // retrieve the target node
-            targetNode = this->getNode(targetTag.getValue());
+            targetNode = this->getNode(edge.getFloatingTarget());
             LOG_DEBUG << "Target node " << targetNode << " retrieved." << std::ends;
         }
 
         if(targetNode == nullptr) //(!)gx20111221: why not an else!?
         {
-            if(edge.containsTag(Edge::offsetTagName))
+            if(edge.hasFloatingOffset())
             {
                 // relink it to the target node using offset
-                const string& offset = edge.getTag(Edge::offsetTagName).getValue();
                 targetNode = this->getTargetFromFloatingEdgeUsingOffset(node, edge);
-                LOG_DEBUG << "Node " << targetNode << " found at requested offset " << offset << "." << std::ends;
+                LOG_DEBUG << "Node " << targetNode << " found at requested offset " << edge.getFloatingOffset() << "." << std::ends;
             }
 
             if(targetNode == nullptr)  
@@ -802,8 +798,8 @@ bool CSubGraph::restoreInnerLabel(CNode& node, const InnerLabelParameter& innerL
 
         Assert(targetNode != nullptr);
         edge.setTo(targetNode);
-        edge.removeTag(Edge::targetTagName);
-        edge.removeTag(Edge::offsetTagName);
+        edge.clearFloatingTarget();
+        edge.clearFloatingOffset();
     }
 
     LOG_DEBUG << "Node " << node << ": inner label " << innerLabel <<
@@ -816,7 +812,7 @@ bool CSubGraph::contains(const CNode& node) const
 {
     _STACK;
 
-    return this->nodes.find(node.getId()) != this->nodes.end();
+    return this->nodes.find(node.getHandle()) != this->nodes.end();
 }
 
 hash_t CSubGraph::calculateHashCode(Purpose purpose) const
@@ -855,7 +851,7 @@ void CSubGraph::setPrologue(unique_ptr<CNode>& value)
 		this->prologue->detachInnerLabels();;
 
 		this->nodes.erase(
-				this->nodes.find(this->prologue->getId())
+				this->nodes.find(this->prologue->getHandle())
 				);
 
 		this->prologue->setNext(nullptr);
@@ -876,7 +872,7 @@ void CSubGraph::setPrologue(unique_ptr<CNode>& value)
 	    value->setNext(nextNode);
 	}
 
-	this->nodes[value->getId()] = value.get();
+	this->nodes[value->getHandle()] = value.get();
 	this->prologue = value.release();
 
 	// what happens if the node has no TAG_PLACE?
@@ -917,7 +913,7 @@ void CSubGraph::setEpilogue(unique_ptr<CNode>& value)
 		this->epilogue->detachNextAndPrev();
 
 		this->nodes.erase(
-			this->nodes.find(this->prologue->getId())
+			this->nodes.find(this->prologue->getHandle())
 			);
 
 	    this->epilogue->setPrev(nullptr);
@@ -939,7 +935,7 @@ void CSubGraph::setEpilogue(unique_ptr<CNode>& value)
 	}
 
 	// set the new epilogue
-	this->nodes[value->getId()] = value.get();
+	this->nodes[value->getHandle()] = value.get();
 	this->epilogue = value.release();
 
 	// what happens if the tag place is not there?
@@ -1027,16 +1023,17 @@ void CSubGraph::setMessageInformation2()
 map<hash_t,string> CSubGraph::getMessageMap()
 {
 	map<hash_t,string> symbolMap;
+	string symbol;
 
 	for( CNode* cursor = &this->getPrologue(); cursor != nullptr; cursor = cursor->getNext() )
     	{
         IdentityRelabeller relabeller;
-		ostringstream ss;
-		cursor->writeExternalRepresentation(ss, relabeller);
+		symbol.clear();
+		cursor->appendExternalRepresentation(symbol, relabeller);
 		
 		// if the symbol is empty, replace it with \"\"
-		if(ss.str().size() > 0)
-        		symbolMap[cursor->getHashCode(ENTROPY)] = ss.str();
+		if(symbol.size() > 0)
+        		symbolMap[cursor->getHashCode(ENTROPY)] = symbol;
 		else
 			symbolMap[cursor->getHashCode(ENTROPY)] = "\"\"";
     	}
@@ -33,6 +33,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <ostream>
 
 #include "Constraints.h"
@@ -68,7 +69,7 @@ private: // fields
     std::string id;
 
     IContainer<CSubGraph>* parentContainer;
-    std::map<std::string, CNode*> nodes;
+    std::unordered_map<tgraph::NodeHandle, CNode*> nodes;
     Slice slice;
 
     CNode* prologue;
@@ -132,7 +133,8 @@ public: // getters
     const ugp3::constraints::SubSection& getSubSection() const;
 
 public: // NodeContainer interface
-    virtual CNode*  getNode(const std::string& id) const;
+    using NodeContainer::getNode;
+    virtual CNode*  getNode(tgraph::NodeHandle handle) const;
     virtual void    setPrologue(std::unique_ptr<CNode>& value);
     virtual void    setEpilogue(std::unique_ptr<CNode>& value);
 
@@ -157,7 +159,7 @@ public: // ConstrainedElement interface
 	virtual void clear();
 	virtual void buildRandom();
 	virtual bool validate() const;
-	virtual void writeExternalRepresentation(std::ostream& stream, Relabeller& relabeller) const;
+	virtual void appendExternalRepresentation(std::string& buffer, Relabeller& relabeller) const;
 
 public: // Hashable interface
 	 virtual hash_t calculateHashCode(Purpose purpose) const;
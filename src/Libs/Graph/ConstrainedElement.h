@@ -54,7 +54,10 @@ namespace ugp3
         public:
 			virtual void clear() = 0;
 			virtual void buildRandom() = 0;
-			virtual void writeExternalRepresentation(std::ostream& stream, Relabeller& relabeller) const = 0;
+			/** Appends the phenotype of the element to the buffer. */
+			virtual void appendExternalRepresentation(std::string& buffer, Relabeller& relabeller) const = 0;
+			/** Writes the phenotype of the element to the stream. */
+			void writeExternalRepresentation(std::ostream& stream, Relabeller& relabeller) const;
 
 			void setConstrain(const ugp3::constraints::ConstrainingElement& constrain);
 			const ugp3::constraints::ConstrainingElement* getConstrain() const;
@@ -80,6 +83,13 @@ namespace ugp3
 		{
 			return this->constrain;
 		}
+
+		inline void ConstrainedElement::writeExternalRepresentation(std::ostream& stream, Relabeller& relabeller) const
+		{
+			std::string buffer;
+			this->appendExternalRepresentation(buffer, relabeller);
+			stream << buffer;
+		}
 	}
 }
 
@@ -39,10 +39,15 @@ using namespace std;
 const string Edge::offsetTagName = "offset";
 const string Edge::parameterTagName = "parameter";
 const string Edge::targetTagName = "target";
+const string Edge::sectionTagName = "section";
 
 Edge::Edge(Node& from, Node* to)
     : from(from),
-    to(to)
+    to(to),
+    floatingTarget(0),
+    floatingTargetSet(false),
+    floatingOffset(0),
+    floatingOffsetSet(false)
 {
     _STACK;
 
@@ -52,7 +57,11 @@ Edge::Edge(Node& from, Node* to)
 
 Edge::Edge(Node& sourceNode)
     : from(sourceNode),
-	to(nullptr)
+	to(nullptr),
+	floatingTarget(0),
+	floatingTargetSet(false),
+	floatingOffset(0),
+	floatingOffsetSet(false)
 { }
 
 void Edge::clear()
@@ -60,6 +69,9 @@ void Edge::clear()
 	Taggable::clear();
 
 	this->to = nullptr;
+	this->floatingTargetSet = false;
+	this->floatingOffsetSet = false;
+	this->floatingSection.clear();
 }
 
 Edge::~Edge()
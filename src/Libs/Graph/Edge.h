@@ -51,6 +51,16 @@ private:
     Node& from;
     Node* to;
 
+    /** Where a floating edge pointed before being detached: the handle of
+        the old target, an offset (to the target node for inner labels, to
+        the target sub-graph for outer labels) and the name of the target
+        section for outer labels. */
+    NodeHandle floatingTarget;
+    bool floatingTargetSet;
+    int floatingOffset;
+    bool floatingOffsetSet;
+    std::string floatingSection;
+
     /// private copy constructor. It should never be used
     Edge( const Edge& );
     Edge& operator=(const Edge& edge);
@@ -64,6 +74,7 @@ public: // static fields
     static const std::string offsetTagName;
     static const std::string parameterTagName;
     static const std::string targetTagName;
+    static const std::string sectionTagName;
     static const std::string XML_NAME;
 
 public: // constructors and destructors
@@ -92,6 +103,22 @@ public: // getters and setters
         @param to The new to pointer */
     void setTo(Node*);
 
+public: // floating edge information
+    bool hasFloatingTarget() const;
+    NodeHandle getFloatingTarget() const;
+    void setFloatingTarget(NodeHandle target);
+    void clearFloatingTarget();
+
+    bool hasFloatingOffset() const;
+    int getFloatingOffset() const;
+    void setFloatingOffset(int offset);
+    void clearFloatingOffset();
+
+    bool hasFloatingSection() const;
+    const std::string& getFloatingSection() const;
+    void setFloatingSection(const std::string& section);
+    void clearFloatingSection();
+
 public: // Xml interface
 	virtual void writeXml(std::ostream& output) const;
 	virtual void readXml(const xml::Element& element);
@@ -116,6 +143,68 @@ inline const std::string& Edge::getXmlName() const
 {
 	return XML_NAME;
 }
+
+inline bool Edge::hasFloatingTarget() const
+{
+    return this->floatingTargetSet;
+}
+
+inline NodeHandle Edge::getFloatingTarget() const
+{
+    return this->floatingTarget;
+}
+
+inline void Edge::setFloatingTarget(NodeHandle target)
+{
+    this->floatingTarget = target;
+    this->floatingTargetSet = true;
+}
+
+inline void Edge::clearFloatingTarget()
+{
+    this->floatingTargetSet = false;
+}
+
+inline bool Edge::hasFloatingOffset() const
+{
+    return this->floatingOffsetSet;
+}
+
+inline int Edge::getFloatingOffset() const
+{
+    return this->floatingOffset;
+}
+
+inline void Edge::setFloatingOffset(int offset)
+{
+    this->floatingOffset = offset;
+    this->floatingOffsetSet = true;
+}
+
+inline void Edge::clearFloatingOffset()
+{
+    this->floatingOffsetSet = false;
+}
+
+inline bool Edge::hasFloatingSection() const
+{
+    return this->floatingSection.empty() == false;
+}
+
+inline const std::string& Edge::getFloatingSection() const
+{
+    return this->floatingSection;
+}
+
+inline void Edge::setFloatingSection(const std::string& section)
+{
+    this->floatingSection = section;
+}
+
+inline void Edge::clearFloatingSection()
+{
+    this->floatingSection.clear();
+}
     
 }
 
@@ -26,6 +26,7 @@
 
 #include "ugp3_config.h"
 #include "TaggedGraph.h"
+#include "Convert.h"
 using namespace tgraph;
 using namespace ugp3;
 using namespace std;
@@ -46,8 +47,28 @@ void Edge::readXml(const xml::Element& element)
         throw xml::SchemaException("expected element 'edge'", LOCATION);
     }
 
+    // the information about floating edges is saved as tags
+    if(this->containsTag(Edge::targetTagName))
+    {
+        this->setFloatingTarget(InfinityString::toNumber(this->getTag(Edge::targetTagName).getValue()));
+        this->removeTag(Edge::targetTagName);
+    }
+    if(this->containsTag(Edge::offsetTagName))
+    {
+        this->setFloatingOffset(Convert::toInt(this->getTag(Edge::offsetTagName).getValue()));
+        this->removeTag(Edge::offsetTagName);
+    }
+    if(this->containsTag(Edge::sectionTagName))
+    {
+        this->setFloatingSection(this->getTag(Edge::sectionTagName).getValue());
+        this->removeTag(Edge::sectionTagName);
+    }
+
     const std::string targetId = xml::Utility::attributeValueToString(element, XML_ATTRIBUTE_TO);
-    this->addTag(Edge::targetTagName, targetId);
+    if(targetId.empty() == false)
+    {
+        this->setFloatingTarget(InfinityString::toNumber(targetId));
+    }
 }
 
 void Edge::writeXml(ostream& output) const
@@ -66,10 +87,22 @@ void Edge::writeXml(ostream& output) const
     }
 
 
-    if(this->getTagCount() > 0)
+    if(this->getTagCount() > 0 || this->hasFloatingTarget() || this->hasFloatingOffset() || this->hasFloatingSection())
     {
         output << ">" << std::endl;
         Taggable::writeXml(output);
+        if(this->to == nullptr && this->hasFloatingTarget())
+        {
+            Tag(Edge::targetTagName, InfinityString::fromNumber(this->floatingTarget)).writeXml(output);
+        }
+        if(this->hasFloatingOffset())
+        {
+            Tag(Edge::offsetTagName, Convert::toString(this->floatingOffset)).writeXml(output);
+        }
+        if(this->hasFloatingSection())
+        {
+            Tag(Edge::sectionTagName, this->floatingSection).writeXml(output);
+        }
         output << "</" << XML_NAME << ">" << endl;
     }
     else
@@ -80,16 +80,17 @@ void Graph::buildFromXml(const xml::Element *element)
             if(edge.getTo() == nullptr)
             // the edge is floating, attach it to the target node
             {
-                // the target tag contains the id of the target node
-                Tag& targetTag = edge.getTag(Edge::targetTagName);
-
-                const string targetId = targetTag.getValue();
+                // the edge keeps the handle of the target node
+                if(edge.hasFloatingTarget() == false)
+                {
+                    throw xml::SchemaException("Missing target node.", LOCATION);
+                }
 
                 // search the target node
                 Node* target = nullptr;
                 for(unsigned int n = 0; n < this->nodes.size(); n++)
                 {
-                    if(this->nodes[n]->getId() == targetId)
+                    if(this->nodes[n]->getHandle() == edge.getFloatingTarget())
                     {
                         target = this->nodes[n];
                     }
@@ -97,12 +98,12 @@ void Graph::buildFromXml(const xml::Element *element)
 
                 if(target == nullptr)
                 {
-                    throw xml::SchemaException("Could not find target node " + targetId + ".", LOCATION);
+                    throw xml::SchemaException("Could not find target node " + InfinityString::fromNumber(edge.getFloatingTarget()) + ".", LOCATION);
                 }
 
-                // set the target and delete the auxiliary tags
+                // set the target and delete the auxiliary information
                 edge.setTo(target);
-                edge.removeTag(Edge::targetTagName);
+                edge.clearFloatingTarget();
                // edge.removeTag(Edge::floatingTagName);
             }
         }
@@ -110,7 +111,7 @@ void Graph::buildFromXml(const xml::Element *element)
         // check for id uniqueness
         for(unsigned int n = i + 1; n < this->nodes.size(); n++)
         {
-            if(this->nodes[n]->getId() == node->getId())
+            if(this->nodes[n]->getHandle() == node->getHandle())
             {
                 throw xml::SchemaException("The id " + node->getId() + " of the node is not unique.", LOCATION);
             }
@@ -37,14 +37,12 @@ using namespace std;
 using namespace tgraph;
 using namespace ugp3;
 
-InfinityString Node::idCounter;
+NodeHandle Node::handleCounter = 0;
 
 Node::Node()
-    : id(idCounter.toString())
+    : handle(handleCounter++)
 {
     _STACK;
-
-    Node::idCounter++;
 }
 
 Node::~Node()
@@ -41,6 +41,7 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 
 #include "Taggable.h"
 #include "XMLIFace.h"
@@ -49,6 +50,13 @@
 #include "IContainer.h"
 #include "IString.h"
 #include "Exceptions/IndexOutOfBoundsException.h"
+
+namespace tgraph
+{
+/** Compact identifier of a node. Its string form (an InfinityString) is only used for output. */
+typedef std::uint64_t NodeHandle;
+}
+
 #include "Edge.h"
 
 /**
@@ -71,7 +79,9 @@ class Node :
 {
 protected:
     /** Identifier of this Node */
-    std::string id;
+    NodeHandle handle;
+    /** String form of the identifier, built on first request */
+    mutable std::string id;
     /** Output edges from this Node */
     std::vector<Edge*> edges;
     /** Input edges to this Node */
@@ -79,7 +89,7 @@ protected:
 
 protected:
     /** Static counter to set the ids to new Nodes */
-    static InfinityString idCounter;
+    static NodeHandle handleCounter;
 
 
     /** Private copy constructor. It should never be used. Not implementes and not used. */
@@ -163,6 +173,13 @@ public:
      */
     const std::string& getId() const;
 
+    /**
+     * Returns the compact identifier of this node
+     * @returns NodeHandle The handle of this node
+     * @throws nothing. if an exception is thrown, the execution is aborted.
+     */
+    NodeHandle getHandle() const;
+
 public: // IString interface
 		virtual const std::string toString() const;
 
@@ -203,12 +220,21 @@ public: // Xml interface
 
 inline const std::string& Node::getId() const
 {
+    if(this->id.empty())
+    {
+        this->id = InfinityString::fromNumber(this->handle);
+    }
     return this->id;
 }
 
+inline NodeHandle Node::getHandle() const
+{
+    return this->handle;
+}
+
 inline const std::string Node::toString() const
 {
-    return "{" + this->id + "}";
+    return "{" + this->getId() + "}";
 }
 
 inline const std::string& Node::getXmlName() const
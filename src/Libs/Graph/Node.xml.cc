@@ -57,11 +57,10 @@ void Node::readXml(const xml::Element& element)
 
     this->id = xml::Utility::attributeValueToString(element, XML_ATTRIBUTE_ID);
     LOG_DEBUG << "Setting the id of the new node to " <<  this->id << ends;
-    InfinityString infinityString(this->id);
-    if(Node::idCounter <= infinityString)
+    this->handle = InfinityString::toNumber(this->id);
+    if(Node::handleCounter <= this->handle)
     {
-        Node::idCounter = infinityString;
-        Node::idCounter++;
+        Node::handleCounter = this->handle + 1;
     }
 
     const xml::Element* childElement = element.FirstChildElement();
@@ -88,7 +87,7 @@ void Node::writeXml(ostream& output) const
 
     output << "<" << this->getXmlName() 
         << " " 
-        << XML_ATTRIBUTE_ID << "=\""<< this->id << "\"" 
+        << XML_ATTRIBUTE_ID << "=\""<< this->getId() << "\"" 
         << ">" << endl;
 
     Taggable::writeXml(output);
@@ -40,6 +40,7 @@
 #include "IContainer.h"
 #include "IValidable.h"
 #include "IString.h"
+#include "Node.h"
 
 namespace ugp3
 {
@@ -61,7 +62,11 @@ namespace ugp3
 		NodeContainer();
 		NodeContainer(const ugp3::constraints::ConstrainingElement& element);
 
-		virtual CNode* getNode(const std::string& nodeId) const = 0;
+		/** Finds a node of the container from its handle.
+		    @return The node, or nullptr if it is not in the container. */
+		virtual CNode* getNode(tgraph::NodeHandle handle) const = 0;
+		/** Finds a node of the container from the string form of its id, as found in xml files. */
+		CNode* getNode(const std::string& nodeId) const;
 
 		virtual CNode& getPrologue() const;
 		virtual CNode& getEpilogue() const;
@@ -82,6 +87,11 @@ namespace ugp3
 {
     namespace ctgraph
     {
+        inline CNode* NodeContainer::getNode(const std::string& nodeId) const
+        {
+            return this->getNode(InfinityString::toNumber(nodeId));
+        }
+
         inline NodeContainer::NodeContainer()
             : ConstrainedElement()
         { }
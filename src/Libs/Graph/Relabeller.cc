@@ -31,12 +31,39 @@
 
 #include "Relabeller.h"
 
-const std::string& ugp3::ctgraph::NormalizingRelabeller::translate(const std::string& label)
+const std::vector<std::string>& ugp3::ctgraph::NormalizingRelabeller::getLabelTable()
 {
-    auto translation = m_translations.find(label);
-    if (translation == m_translations.end()) {
-        std::tie(translation, std::ignore) = m_translations.insert(std::make_pair(label, m_counter.toString()));
-        ++m_counter;
+    static const std::vector<std::string> table = [] {
+        std::vector<std::string> labels;
+        labels.reserve(1024);
+        InfinityString counter;
+        for (unsigned int i = 0; i < 1024; ++i) {
+            labels.push_back(counter.toString());
+            ++counter;
+        }
+        return labels;
+    }();
+    return table;
+}
+
+const std::string& ugp3::ctgraph::NormalizingRelabeller::translate(const tgraph::Node& node)
+{
+    auto position = m_indices.find(node.getHandle());
+    if (position == m_indices.end()) {
+        position = m_indices.emplace(node.getHandle(), (unsigned int)m_indices.size()).first;
+    }
+    
+    const std::vector<std::string>& table = getLabelTable();
+    unsigned int index = position->second;
+    if (index < table.size()) {
+        return table[index];
+    }
+    
+    // Very large graphs: continue the sequence after the end of the table
+    while (m_overflow.size() <= index - table.size()) {
+        InfinityString counter(m_overflow.empty() ? table.back() : m_overflow.back());
+        ++counter;
+        m_overflow.push_back(counter.toString());
     }
-    return translation->second;
+    return m_overflow[index - table.size()];
 }
@@ -35,8 +35,11 @@
 #define HEADER_UGP3_CTGRAPH_RELABELLER
 
 #include <string>
+#include <vector>
+#include <deque>
 #include <unordered_map>
 #include <InfinityString.h>
+#include "Node.h"
 
 namespace ugp3 {
 namespace ctgraph {
@@ -52,25 +55,30 @@ public:
     Relabeller& operator=(const Relabeller&) = delete;
     Relabeller& operator=(Relabeller&&) = delete;
     
-    virtual const std::string& translate(const std::string& label) = 0;
+    virtual const std::string& translate(const tgraph::Node& node) = 0;
 };
 
 class IdentityRelabeller: public Relabeller
 {
 public:
-    virtual const std::string& translate(const std::string& label) {
-        return label;
+    virtual const std::string& translate(const tgraph::Node& node) {
+        return node.getId();
     }
 };
 
 class NormalizingRelabeller: public Relabeller
 {
 private:
-    std::unordered_map<std::string, std::string> m_translations;
-    InfinityString m_counter;
+    /** Position of each node in the order of first appearance */
+    std::unordered_map<tgraph::NodeHandle, unsigned int> m_indices;
+    /** Normalized labels past the end of the shared table */
+    std::deque<std::string> m_overflow;
+    
+    /** Normalized labels ("A", "B", ...) of the first positions, shared by all relabellers */
+    static const std::vector<std::string>& getLabelTable();
     
 public:
-    virtual const std::string& translate(const std::string& label);
+    virtual const std::string& translate(const tgraph::Node& node);
 };
 
 }
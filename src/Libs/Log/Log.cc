@@ -47,11 +47,20 @@ Log log_;
 Log::Log()
      : temporaryStream(new ostringstream()),
        level(Level::Info),
-       progress(nullptr)
+       progress(nullptr),
+       defaultFormat(nullptr),
+       overflowPolicy(BLOCK),
+       writerRunning(false),
+       writerSleeping(false),
+       pendingRecords(0),
+       droppedRecords(0),
+       progressInterval(0)
 { }
 
 Log::~Log()
 {
+    this->stopWriter();
+
     for(unsigned int i = 0; i < this->handlers.size(); i++)
     {
         delete this->handlers[i];
@@ -122,6 +131,8 @@ void Log::readXml(const xml::Element& element)
 
 void Log::clear()
 {
+    this->stopWriter();
+
     this->level = Level::Info;
     this->location = Location();
     this->progress = nullptr;
@@ -174,33 +185,48 @@ void Log::commit()
         }
     }
 
-    if(messageSuppressed == false)
+    if(messageSuppressed == false && this->queue != nullptr)
     {
-        // Gets the actual time
-        ::time_t timeNow;
-        ::time(&timeNow);
-        ::tm* timeInfo = ::localtime(&timeNow);
-
-        // Creates the record with the information to show
-        const Record* record = nullptr;
-        if(this->progress != nullptr)
+        // Intermediate progress updates are rate-limited: the console shows at most one per second anyway
+        bool progressSuppressed = false;
+        if(this->progress != nullptr && *this->progress != Progress::START && *this->progress != Progress::END)
         {
-            record = new Record(message, this->level, this->location, *timeInfo, *this->progress);
-        }
-        else
-        {
-            record = new Record(message, this->level, this->location, *timeInfo);
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if(now - this->lastProgress < this->progressInterval)
+            {
+                progressSuppressed = true;
+            }
+            else
+            {
+                this->lastProgress = now;
+            }
         }
 
-        // Reports the message on the various handlers
-        for(unsigned int i = 0; i < this->handlers.size(); i++)
+        if(progressSuppressed == false)
         {
-            if(this->handlers[i]->isLoggable(*record))
+            RecordQueue::Item item;
+            item.message.swap(message);
+            item.level = this->level;
+            item.location = this->location;
+            ::time(&item.time);
+            item.hasProgress = this->progress != nullptr;
+            item.progress = item.hasProgress ? (double) *this->progress : 0;
+            this->enqueue(item);
+
+            // Errors are shown before going on: the program might be about to stop
+            if(this->level <= Level::Error)
             {
-                this->handlers[i]->publish(*record);
+                this->flush();
             }
         }
-        delete record;
+    }
+    else if(messageSuppressed == false)
+    {
+        // Gets the actual time
+        ::time_t timeNow;
+        ::time(&timeNow);
+
+        this->publish(message, this->level, this->location, timeNow, this->progress);
     }
 
     // Resets the parameters for a new message
@@ -208,12 +234,161 @@ void Log::commit()
     this->location = Location();
     this->progress = nullptr;
 
-    delete this->temporaryStream;
-    this->temporaryStream = new std::ostringstream();
+    this->temporaryStream->str(string());
+    this->temporaryStream->clear();
+    this->temporaryStream->copyfmt(this->defaultFormat);
+}
+
+void Log::publish(const std::string& message, const Level& level, const Location& location, std::time_t time, const Progress* progress)
+{
+    ::tm* timeInfo = ::localtime(&time);
+
+    // Creates the record with the information to show
+    const Record* record = nullptr;
+    if(progress != nullptr)
+    {
+        record = new Record(message, level, location, *timeInfo, *progress);
+    }
+    else
+    {
+        record = new Record(message, level, location, *timeInfo);
+    }
+
+    // Reports the message on the various handlers
+    for(unsigned int i = 0; i < this->handlers.size(); i++)
+    {
+        if(this->handlers[i]->isLoggable(*record))
+        {
+            this->handlers[i]->publish(*record);
+        }
+    }
+    delete record;
+}
+
+Log::OverflowPolicy Log::parseOverflowPolicy(const std::string& name)
+{
+    if(name == "block")
+    {
+        return BLOCK;
+    }
+    else if(name == "drop")
+    {
+        return DROP;
+    }
+
+    throw Exception("Unknown log overflow policy \"" + name + "\" (expected \"block\" or \"drop\").", LOCATION);
+}
+
+void Log::startWriter(std::size_t capacity, OverflowPolicy policy, std::chrono::milliseconds progressInterval)
+{
+    if(this->queue != nullptr)
+    {
+        throw Exception("The log writer is already running.", LOCATION);
+    }
+
+    this->queue = unique_ptr<RecordQueue>(new RecordQueue(capacity));
+    this->overflowPolicy = policy;
+    this->progressInterval = progressInterval;
+    this->lastProgress = std::chrono::steady_clock::time_point();
+    this->pendingRecords = 0;
+    this->droppedRecords = 0;
+    this->writerRunning = true;
+    this->writer = std::thread(&Log::writeRecords, this);
+}
+
+void Log::stopWriter()
+{
+    if(this->queue == nullptr)
+    {
+        return;
+    }
+
+    this->flush();
+    this->writerRunning = false;
+    this->wakeUpWriter();
+    this->writer.join();
+    this->queue.reset();
+
+    if(this->droppedRecords > 0)
+    {
+        ::time_t timeNow;
+        ::time(&timeNow);
+
+        std::ostringstream message;
+        message << this->droppedRecords << " log messages were dropped because the log queue was full";
+        this->publish(message.str(), Level::Warning, Location(LOCATION), timeNow, nullptr);
+        this->droppedRecords = 0;
+    }
+}
+
+void Log::flush()
+{
+    while(this->pendingRecords > 0)
+    {
+        this->wakeUpWriter();
+        std::this_thread::yield();
+    }
+}
+
+void Log::wakeUpWriter()
+{
+    std::lock_guard<std::mutex> lock(this->writerMutex);
+    this->writerWakeUp.notify_one();
+}
+
+void Log::enqueue(RecordQueue::Item& item)
+{
+    ++this->pendingRecords;
+    while(this->queue->push(item) == false)
+    {
+        if(this->overflowPolicy == DROP && item.level > Level::Warning)
+        {
+            ++this->droppedRecords;
+            --this->pendingRecords;
+            return;
+        }
+
+        // Backpressure: let the writer make room
+        this->wakeUpWriter();
+        std::this_thread::yield();
+    }
+
+    if(this->writerSleeping)
+    {
+        this->wakeUpWriter();
+    }
+}
+
+void Log::writeRecords()
+{
+    RecordQueue::Item item;
+    while(true)
+    {
+        while(this->queue->pop(item))
+        {
+            const Progress itemProgress(item.progress);
+            this->publish(item.message, item.level, item.location, item.time, item.hasProgress ? &itemProgress : nullptr);
+            --this->pendingRecords;
+        }
+
+        if(this->writerRunning == false)
+        {
+            break;
+        }
+
+        // Wait for new messages; a notification might be missed, so do not wait too long
+        std::unique_lock<std::mutex> lock(this->writerMutex);
+        this->writerSleeping = true;
+        this->writerWakeUp.wait_for(lock, std::chrono::milliseconds(20));
+        this->writerSleeping = false;
+    }
 }
 
 void Log::addHandler(Handler& handler)
 {
+    // The writer thread is idle once all messages are published
+    this->flush();
+
     for(unsigned int i = 0; i < this->handlers.size(); i++)
     {
         if(&handler == this->handlers[i])
@@ -227,6 +402,8 @@ void Log::addHandler(Handler& handler)
 
 void Log::removeHandler(Handler& handler)
 {
+    this->flush();
+
     for(unsigned int i = 0; i < this->handlers.size(); i++)
     {
         if(&handler == this->handlers[i])
@@ -50,6 +50,12 @@
 #include <cassert>
 #include <map>
 #include <type_traits>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 // headers from this module
 #include "Handler.h"
@@ -57,6 +63,7 @@
 #include "Location.h"
 #include "Progress.h"
 #include "Record.h"
+#include "RecordQueue.h"
 
 // headers from other modules
 #include "IString.h"
@@ -98,6 +105,17 @@ namespace log
  */
 class Log : public xml::XMLIFace
 {
+public:
+    /**
+     * What the asynchronous writer does when its queue is full.
+     */
+    typedef enum {
+        /** Wait for the writer thread to make room */
+        BLOCK = 0,
+        /** Discard the message (errors and warnings are never discarded) */
+        DROP = 1,
+    } OverflowPolicy;
+
 private:
     // A list of the opened streams on which the messages are written.
     std::vector<Handler*> handlers;
@@ -134,10 +152,40 @@ private:
     // Maximum number of warnings of the same kind allowed
     static const int MAX_WARNINGS;
 
+    // Default format of the temporary stream, restored after each message.
+    std::ios defaultFormat;
+
+    // Asynchronous writer: messages committed, waiting to be published
+    std::unique_ptr<RecordQueue> queue;
+    OverflowPolicy overflowPolicy;
+    std::thread writer;
+    std::atomic<bool> writerRunning;
+    std::atomic<bool> writerSleeping;
+    std::mutex writerMutex;
+    std::condition_variable writerWakeUp;
+    // Messages committed but not published yet
+    std::atomic<unsigned long> pendingRecords;
+    std::atomic<unsigned long> droppedRecords;
+    // Minimum time between two intermediate updates of a progress bar
+    std::chrono::milliseconds progressInterval;
+    std::chrono::steady_clock::time_point lastProgress;
+
 private:
     // Flushes the current message, writing it on the active streams.
     void commit();
 
+    // Formats the message and writes it on the active streams.
+    void publish(const std::string& message, const Level& level, const Location& location, std::time_t time, const Progress* progress);
+
+    // Hands the message over to the writer thread, according to the overflow policy.
+    void enqueue(RecordQueue::Item& item);
+
+    // Main loop of the writer thread.
+    void writeRecords();
+
+    // Wakes up the writer thread if it is waiting for messages.
+    void wakeUpWriter();
+
 
     // The copy constructor: it is declared as private so that it cannot be accessed.
     Log(const Log& log);
@@ -197,6 +245,41 @@ public:
      */
     unsigned int getHandlersCount() const;
 
+public:
+    /** 
+     * Publishes the messages from a background thread: committing a message
+     * only costs an enqueue. Errors are still published before the commit
+     * returns. Handlers must not be modified while the writer is running,
+     * except through addHandler and removeHandler.
+     * @param capacity Maximum number of messages waiting to be published
+     * @param policy What to do when the queue is full
+     * @param progressInterval Minimum time between two updates of a progress bar
+     * @throws Any exception. Exception if the writer is already running.
+     */
+    void startWriter(std::size_t capacity, OverflowPolicy policy, std::chrono::milliseconds progressInterval);
+    /** 
+     * Publishes all the pending messages and stops the writer thread. 
+     * Does nothing if the writer is not running.
+     */
+    void stopWriter();
+    /** 
+     * Waits until all the committed messages have been published.
+     */
+    void flush();
+    /** 
+     * Returns true if messages are published by a background thread
+     */
+    bool isAsynchronous() const { return this->queue != nullptr; }
+    /** 
+     * Returns the number of messages discarded because the queue was full
+     */
+    unsigned long getDroppedRecordsCount() const { return this->droppedRecords; }
+    /** 
+     * Parses the name of an overflow policy ("block" or "drop")
+     * @throws Any exception. Exception if the name is unknown.
+     */
+    static OverflowPolicy parseOverflowPolicy(const std::string& name);
+
 public: // XMLIFace methods
     virtual void writeXml(std::ostream& output) const;
     virtual void readXml(const xml::Element& element);
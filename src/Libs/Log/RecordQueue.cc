@@ -0,0 +1,121 @@
+/***********************************************************************\
+|                                                                       |
+| RecordQueue.cc                                                        |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file RecordQueue.cc
+ * Implementation of the RecordQueue class.
+ * @see RecordQueue.h
+ */
+
+#include "ugp3_config.h"
+#include "RecordQueue.h"
+#include "Exception.h"
+
+#include <cstdint>
+
+using namespace ugp3::log;
+using namespace std;
+
+/*
+ * Bounded multi-producer multi-consumer queue (D. Vyukov). Every cell has a
+ * sequence number telling whether it can be written (sequence == position)
+ * or read (sequence == position + 1) at a given position; the positions are
+ * claimed with a compare-and-swap, so no lock is ever taken.
+ */
+
+static size_t roundToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+RecordQueue::RecordQueue(size_t capacity)
+    : cells(new Cell[roundToPowerOfTwo(capacity)]),
+      mask(roundToPowerOfTwo(capacity) - 1)
+{
+    if (capacity == 0) {
+        throw Exception("The capacity of the log queue must be greater than zero.", LOCATION);
+    }
+
+    for (size_t i = 0; i <= this->mask; i++) {
+        this->cells[i].sequence.store(i, memory_order_relaxed);
+    }
+    this->pushPosition.value.store(0, memory_order_relaxed);
+    this->popPosition.value.store(0, memory_order_relaxed);
+}
+
+bool RecordQueue::push(Item& item)
+{
+    Cell* cell;
+    size_t position = this->pushPosition.value.load(memory_order_relaxed);
+    while (true) {
+        cell = &this->cells[position & this->mask];
+        size_t sequence = cell->sequence.load(memory_order_acquire);
+        intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+        if (difference == 0) {
+            if (this->pushPosition.value.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The oldest message has not been read yet
+            return false;
+        } else {
+            position = this->pushPosition.value.load(memory_order_relaxed);
+        }
+    }
+
+    cell->item = std::move(item);
+    cell->sequence.store(position + 1, memory_order_release);
+    return true;
+}
+
+bool RecordQueue::pop(Item& item)
+{
+    Cell* cell;
+    size_t position = this->popPosition.value.load(memory_order_relaxed);
+    while (true) {
+        cell = &this->cells[position & this->mask];
+        size_t sequence = cell->sequence.load(memory_order_acquire);
+        intptr_t difference = (intptr_t) sequence - (intptr_t) (position + 1);
+        if (difference == 0) {
+            if (this->popPosition.value.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // Nothing has been written here yet
+            return false;
+        } else {
+            position = this->popPosition.value.load(memory_order_relaxed);
+        }
+    }
+
+    item = std::move(cell->item);
+    cell->sequence.store(position + this->mask + 1, memory_order_release);
+    return true;
+}
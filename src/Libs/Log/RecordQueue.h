@@ -0,0 +1,145 @@
+/***********************************************************************\
+|                                                                       |
+| RecordQueue.h                                                         |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file RecordQueue.h
+ * Definition of the RecordQueue class.
+ * @see RecordQueue.cc
+ */
+
+#ifndef HEADER_UGP3_LOG_RECORDQUEUE
+/** Defines that this file has been included */
+#define HEADER_UGP3_LOG_RECORDQUEUE
+
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <string>
+
+#include "Level.h"
+#include "Location.h"
+
+/**
+ * ugp3 namespace
+ */
+namespace ugp3
+{
+
+/**
+ * ugp3::log namespace
+ */
+namespace log
+{
+
+/**
+ * @class RecordQueue
+ * Bounded lock-free queue of the messages waiting to be published by the
+ * writer thread of the Log. Any number of threads can push and pop at the
+ * same time; a push never allocates memory beyond the message itself.
+ * @see Log
+ */
+class RecordQueue
+{
+public:
+    /**
+     * @struct Item
+     * Everything needed to build a Record once the message is published.
+     */
+    struct Item
+    {
+        /** Text of the message */
+        std::string message;
+        /** Verbosity level of the message */
+        Level level;
+        /** Location where the message was generated */
+        Location location;
+        /** Time when the message was committed */
+        std::time_t time;
+        /** True if the message is a progress update */
+        bool hasProgress;
+        /** Value of the progress, if any */
+        double progress;
+
+        Item() : level(Level::Info), time(0), hasProgress(false), progress(0) { }
+    };
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        Item item;
+    };
+
+    // Keep the two positions on separate cache lines. Padded rather than
+    // aligned: before C++17, new does not honour extended alignments.
+    static const std::size_t CACHE_LINE_SIZE = 64;
+    struct Position
+    {
+        std::atomic<std::size_t> value;
+        char padding[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    const std::size_t mask;
+    char padding[CACHE_LINE_SIZE];
+    Position pushPosition;
+    Position popPosition;
+
+    // Copy constructor. Not implemented.
+    RecordQueue(const RecordQueue&);
+    RecordQueue& operator=(const RecordQueue&);
+
+public:
+    /** 
+     * Constructor of the class. The capacity is rounded up to a power of two.
+     * @param capacity Minimum number of messages that the queue can hold
+     * @throws Any exception. Exception if the capacity is zero.
+     */
+    explicit RecordQueue(std::size_t capacity);
+
+    /** 
+     * Moves the item into the queue, if there is room for it.
+     * @param item Message to enqueue; left untouched if the queue is full
+     * @returns bool True if the item was enqueued, false if the queue is full
+     */
+    bool push(Item& item);
+    /** 
+     * Moves the oldest message of the queue into item.
+     * @param item Where to store the message
+     * @returns bool True if a message was dequeued, false if the queue is empty
+     */
+    bool pop(Item& item);
+    /** 
+     * Returns the maximum number of messages in the queue
+     */
+    std::size_t getCapacity() const { return this->mask + 1; }
+};
+
+}
+
+}
+
+#endif
@@ -82,6 +82,18 @@ public:
         // entropic distance is the the difference between the two
         return 2*totalMessage.getSize() - startingPointMessage.getSize() - endPointMessage.getSize();
     }
+    
+    /**
+     * Estimate of entropic() from the sketches of the two messages:
+     * with J the Jaccard similarity of the two sets of symbols,
+     * |A | B| = (|A| + |B|) / (1 + J).
+     */
+    static double approximateEntropic(const MessageSketch& startingPointSketch, const MessageSketch& endPointSketch)
+    {
+        const double sizes = startingPointSketch.getSymbolCount() + endPointSketch.getSymbolCount();
+        const double jaccard = startingPointSketch.estimateJaccard(endPointSketch);
+        return sizes * (1 - jaccard) / (1 + jaccard);
+    }
 };
 
 }
@@ -105,6 +105,65 @@ int InfinityString::compareTo(const InfinityString& infinityString) const
     return 0;
 }
 
+std::uint64_t InfinityString::toNumber(const string& infinityString)
+{
+    _STACK;
+
+    // 32^12 = 2^60, the offsets of the shorter strings take less than another 2^60
+    if(infinityString.size() == 0 || infinityString.size() > 12)
+    {
+        throw ugp3::ArgumentException("Cannot convert the InfinityString \"" + infinityString + "\" to a number.", LOCATION);
+    }
+
+    // Strings of the same length are numbers in base 32, shorter strings come first
+    std::uint64_t offset = 0;
+    std::uint64_t power = 1;
+    for(unsigned int i = 1; i < infinityString.size(); i++)
+    {
+        power *= 32;
+        offset += power;
+    }
+
+    std::uint64_t value = 0;
+    for(unsigned int i = 0; i < infinityString.size(); i++)
+    {
+        char c = infinityString[i];
+        unsigned int digit;
+        if(c >= 'A' && c <= 'Z')
+            digit = c - 'A';
+        else if(c >= '2' && c <= '7')
+            digit = c - '2' + 26;
+        else
+            throw ugp3::ArgumentException("Invalid character in the InfinityString \"" + infinityString + "\".", LOCATION);
+        value = value * 32 + digit;
+    }
+
+    return offset + value;
+}
+
+string InfinityString::fromNumber(std::uint64_t number)
+{
+    // skip the blocks of the shorter strings
+    unsigned int length = 1;
+    std::uint64_t block = 32;
+    while(length < 12 && number >= block)
+    {
+        number -= block;
+        block *= 32;
+        length++;
+    }
+
+    string result(length, 'A');
+    for(unsigned int i = length; i > 0; i--)
+    {
+        unsigned int digit = number % 32;
+        result[i - 1] = (char)(digit < 26 ? 'A' + digit : '2' + digit - 26);
+        number /= 32;
+    }
+
+    return result;
+}
+
 const string InfinityString::toString() const
 {
 	ostringstream stream;
@@ -43,6 +43,7 @@
 #include "IString.h"
 #include "IComparable.h"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -106,6 +107,20 @@ public: // methods
      * @returns bool True if the infinity strings are equals, false otherwise
      */
     virtual bool equals(const InfinityString& infinityString) const;
+    /**
+     * Returns the position of the given infinity string in the sequence generated by the increment operator ("A" is 0, "7" is 31, "AA" is 32...). Numbers compare like the corresponding infinity strings.
+     * @param str The infinity string to convert
+     * @returns std::uint64_t The position of the string
+     * @throws std::exception. Argument exception if the string is empty or too long to fit in 64 bits
+     */
+    static std::uint64_t toNumber(const std::string& str);
+    /**
+     * Returns the infinity string at the given position in the sequence generated by the increment operator. Inverse of toNumber().
+     * @param number The position of the string
+     * @returns string The infinity string
+     * @throws nothing. if an exception is thrown, the execution is aborted.
+     */
+    static std::string fromNumber(std::uint64_t number);
 
 public: // operators
     /**
@@ -0,0 +1,145 @@
+/***********************************************************************\
+|                                                                       |
+| Process.cc                                                            |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file Process.cc
+ * Implementation of the Process class.
+ * @see Process.h
+ */
+
+#include "ugp3_config.h"
+#include <stdlib.h>
+#include <thread>
+
+#ifndef WINDOWS
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#else
+#include <process.h>
+#endif
+
+#include "Process.h"
+
+using namespace ugp3;
+using namespace std;
+
+int Process::run(const string& commandLine, chrono::milliseconds timeout, bool& timedOut)
+{
+    timedOut = false;
+    
+#ifdef WINDOWS
+    return system(commandLine.c_str());
+#else
+    if (timeout.count() == 0) {
+        return system(commandLine.c_str());
+    }
+    
+    int pid = spawn(commandLine);
+    if (pid < 0) {
+        return -1;
+    }
+    
+    const auto deadline = chrono::steady_clock::now() + timeout;
+    int status = 0;
+    while (hasExited(pid, status) == false) {
+        if (chrono::steady_clock::now() >= deadline) {
+            timedOut = true;
+            kill(pid);
+            break;
+        }
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    return status;
+#endif
+}
+
+int Process::spawn(const string& commandLine)
+{
+#ifdef WINDOWS
+    return -1;
+#else
+    pid_t pid = fork();
+    if (pid < 0) {
+        return -1;
+    }
+    if (pid == 0) {
+        // Own process group, so that the whole tree can be killed at once
+        setpgid(0, 0);
+        execl("/bin/sh", "sh", "-c", commandLine.c_str(), (char*)nullptr);
+        _exit(127);
+    }
+    setpgid(pid, pid);
+    return pid;
+#endif
+}
+
+bool Process::hasExited(int pid, int& status)
+{
+#ifdef WINDOWS
+    return true;
+#else
+    return waitpid(pid, &status, WNOHANG) != 0;
+#endif
+}
+
+void Process::kill(int pid)
+{
+#ifndef WINDOWS
+    int status = 0;
+    ::kill(-pid, SIGKILL);
+    waitpid(pid, &status, 0);
+#endif
+}
+
+long Process::getPeakMemory()
+{
+#ifdef WINDOWS
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    // bytes on Mac OS X, kilobytes elsewhere
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+int Process::getId()
+{
+#ifdef WINDOWS
+    return _getpid();
+#else
+    return getpid();
+#endif
+}
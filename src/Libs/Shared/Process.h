@@ -0,0 +1,105 @@
+/***********************************************************************\
+|                                                                       |
+| Process.h                                                             |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file Process.h
+ * Definition of the Process class.
+ * @see Process.cc
+ */
+
+#ifndef HEADER_UGP3_PROCESS
+/** Defines that this file has been included */
+#define HEADER_UGP3_PROCESS
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string>
+#include <chrono>
+
+/**
+ * ugp3 namespace
+ */
+namespace ugp3
+{
+    /**
+     * @class Process
+     * Runs external commands, optionally with a wall-clock time limit.
+     */
+    class Process
+    {
+    public:
+        /** 
+         * Runs the command line through the shell and waits for its termination.
+         * If the timeout is not zero and the command is still running after
+         * that time, the command and all the processes it spawned are killed.
+         * On platforms without process groups the timeout is ignored.
+         * @param commandLine Command line to execute
+         * @param timeout Wall-clock time limit, zero for none
+         * @param timedOut Set to true iff the command has been killed
+         * @returns int The exit code of the command, as returned by system()
+         */
+        static int run(const std::string& commandLine, std::chrono::milliseconds timeout, bool& timedOut);
+        
+        /**
+         * Starts the command line through the shell, in its own process
+         * group, and returns without waiting.
+         * @param commandLine Command line to execute
+         * @returns int The process id, or -1 if the command could not be started (always on Windows)
+         */
+        static int spawn(const std::string& commandLine);
+        
+        /**
+         * Checks whether a spawned command has terminated, without waiting.
+         * @param pid Process id returned by spawn()
+         * @param status Set to the exit status, as returned by system(), when terminated
+         * @returns bool True iff the command has terminated
+         */
+        static bool hasExited(int pid, int& status);
+        
+        /**
+         * Kills a spawned command and all the processes it spawned, and
+         * waits for its termination.
+         * @param pid Process id returned by spawn()
+         */
+        static void kill(int pid);
+        
+        /**
+         * Returns the peak resident set size of the current process.
+         * @returns long Peak memory in kilobytes, or zero if not available on this platform
+         */
+        static long getPeakMemory();
+        
+        /**
+         * Returns the id of the current process.
+         * @returns int The process id
+         */
+        static int getId();
+    };
+}
+
+#endif
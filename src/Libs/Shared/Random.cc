@@ -42,10 +42,31 @@ using namespace ugp3;
 
 unsigned long Random::totalCalls = 0;
 
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+RandomStream Random::mainStream;
+thread_local RandomStream* Random::currentStream = nullptr;
+#elif defined(USE_MERSENNE_TWISTER)
 std::mt19937 Random::mtEngine;
 #endif
 
+Random::StreamScope::StreamScope(std::uint64_t id0, std::uint64_t id1, std::uint64_t id2)
+#ifdef USE_PHILOX
+: m_stream(mainStream.derive(RandomStream::mix(RandomStream::mix(RandomStream::mix(0, id0), id1), id2))),
+  m_previous(currentStream)
+{
+    currentStream = &m_stream;
+}
+#else
+{ }
+#endif
+
+Random::StreamScope::~StreamScope()
+{
+#ifdef USE_PHILOX
+    currentStream = m_previous;
+#endif
+}
+
 #include <beta_distribution.h>
 
 double Random::nextNormal(const double sigma)
@@ -55,6 +76,20 @@ double Random::nextNormal(const double sigma)
     // FIXME candidate implementation using the standard library, but I'm not sure what the parameter means.
     // return std::normal_distribution<double>(0, sigma)(mtEngine);
     
+#ifdef USE_PHILOX
+    // Polar method without keeping the second value: a value cached from
+    // one stream would otherwise be returned to another one
+	double V1, S;
+	do
+	{
+		V1 = 2 * stream().nextDouble() - 1;
+		double V2 = 2 * stream().nextDouble() - 1;
+		S = V1 * V1 + V2 * V2;
+	}
+	while(S >= 1 || S == 0);
+
+	return V1 * sigma * sqrt(-2 * log(S) / S);
+#else
 	static double V1, V2, S;
 	static int phase = 0;
 	double X;
@@ -85,11 +120,14 @@ double Random::nextNormal(const double sigma)
 	phase = 1 - phase;
 
 	return X;
+#endif
 }
 
 double Random::nextBeta(double alpha, double beta)
 {
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+    return sftrabbit::beta_distribution<double>(alpha, beta)(stream());
+#elif defined(USE_MERSENNE_TWISTER)
     return sftrabbit::beta_distribution<double>(alpha, beta)(mtEngine);
 #else
     // TODO implement beta distribution by hand
@@ -107,7 +145,9 @@ double Random::nextDouble(double minimum, double maximum)
     if(minimum == maximum)
         return minimum;
 
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+    return minimum + stream().nextDouble() * (maximum - minimum);
+#elif defined(USE_MERSENNE_TWISTER)
     return std::uniform_real_distribution<double>(minimum, maximum)(mtEngine);
 #else
 	return minimum + Random::nextDouble() * (maximum - minimum);
@@ -118,7 +158,9 @@ double Random::nextDouble()
 {
 	totalCalls++;
 
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+    return stream().nextDouble();
+#elif defined(USE_MERSENNE_TWISTER)
     return std::uniform_real_distribution<double>(0, 1)(mtEngine);
 #else
 	return rand_drand48();
@@ -127,7 +169,9 @@ double Random::nextDouble()
 
 void Random::seed(long value)
 {
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+    mainStream.setState((std::uint64_t) value, 0, 0);
+#elif defined(USE_MERSENNE_TWISTER)
 	mtEngine.seed(value);
 #else
 	rand_srand48(value);
@@ -136,7 +180,11 @@ void Random::seed(long value)
 
 const std::string Random::getStatus()
 {
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+    std::ostringstream stream;
+    stream << mainStream.getKey() << " " << mainStream.getStream() << " " << mainStream.getPosition();
+    return stream.str();
+#elif defined(USE_MERSENNE_TWISTER)
     std::ostringstream stream;
     stream << mtEngine;
     return stream.str();
@@ -147,7 +195,13 @@ const std::string Random::getStatus()
 
 void Random::setStatus(const std::string& status)
 {
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+    std::istringstream stream(status);
+    std::uint64_t key, number, position;
+    if (!(stream >> key >> number >> position))
+        throw std::invalid_argument("Random::setStatus: Invalid state \"" + status + "\"");
+    mainStream.setState(key, number, position);
+#elif defined(USE_MERSENNE_TWISTER)
     std::istringstream stream(status);
     stream >> mtEngine;
 #else
@@ -164,7 +218,9 @@ unsigned long  Random::nextUInteger(unsigned long  minimum, unsigned long  maxim
     if(minimum == maximum)
         return minimum;
 
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+    return minimum + (unsigned long) stream().nextBelow((std::uint64_t) (maximum - minimum) + 1);
+#elif defined(USE_MERSENNE_TWISTER)
     return std::uniform_int_distribution<unsigned long>(minimum, maximum)(mtEngine);
 #else
     unsigned long int range = maximum - minimum + 1;
@@ -197,7 +253,9 @@ long Random::nextSInteger(long minimum, long maximum)
     if(minimum == maximum)
         return minimum;
 
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+    return (long) ((unsigned long) minimum + (unsigned long) stream().nextBelow((std::uint64_t) ((unsigned long) maximum - (unsigned long) minimum) + 1));
+#elif defined(USE_MERSENNE_TWISTER)
     return std::uniform_int_distribution<long>(minimum, maximum)(mtEngine);
 #else
     unsigned long int range = maximum - minimum + 1;
@@ -39,15 +39,21 @@
 #endif
 
 /**
+ * @def USE_PHILOX
+ * Tag to define the counter-based Philox as the random numbers generator
  * @def USE_MERSENNE_TWISTER
  * Tag to define the Mersenne Twister as the random numbers generator
  */
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+#include "RandomStream.h"
+#elif defined(USE_MERSENNE_TWISTER)
 #include <random>
 #else
 #include "drand48.h"
 #endif
 
+#include <cstdint>
+
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
@@ -61,11 +67,21 @@ namespace ugp3
 /**
  * @class Random
  * Static class to generate random numbers
+ *
+ * With the Philox generator, the numbers are drawn from the main stream,
+ * or from the stream selected by the innermost StreamScope of the calling
+ * thread. With the other generators, all the numbers come from the same
+ * global state and StreamScope has no effect.
  */
 class Random
 {
 private:	
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+    static RandomStream         mainStream;
+    // Stream used by the calling thread, nullptr for the main stream
+    static thread_local RandomStream* currentStream;
+    static RandomStream&        stream() { return currentStream != nullptr ? *currentStream : mainStream; }
+#elif defined(USE_MERSENNE_TWISTER)
     // Used to generate the numbers in Mersenne Twister
     static std::mt19937 mtEngine;
 #else
@@ -81,10 +97,34 @@ private:
 
 public:
     
+    /**
+     * Makes the calling thread draw its numbers from an independent stream
+     * until the scope is destroyed. The stream only depends on the seed and
+     * on the given identifiers (e.g. population, generation and call index),
+     * not on the numbers drawn before. Scopes can be nested.
+     */
+    class StreamScope
+    {
+    private:
+#ifdef USE_PHILOX
+        RandomStream m_stream;
+        RandomStream* m_previous;
+#endif
+        StreamScope(const StreamScope&);
+        StreamScope& operator=(const StreamScope&);
+        
+    public:
+        StreamScope(std::uint64_t id0, std::uint64_t id1 = 0, std::uint64_t id2 = 0);
+        ~StreamScope();
+    };
+    
+    static constexpr const char* RANDOM_TYPE_PHILOX = "Philox4x32";
     static constexpr const char* RANDOM_TYPE_MERSENNE_TWISTER = "Mersenne Twister";
     static constexpr const char* RANDOM_TYPE_RAND48 = "rand48";
     static std::string getType() {
-#ifdef USE_MERSENNE_TWISTER
+#ifdef USE_PHILOX
+        return RANDOM_TYPE_PHILOX;
+#elif defined(USE_MERSENNE_TWISTER)
         return RANDOM_TYPE_MERSENNE_TWISTER;
 #else
         return RANDOM_TYPE_RAND48;
@@ -153,7 +193,8 @@ public:
         }
         
         /**
-         * Returns the current generator seed
+         * Returns the current generator seed. With Philox, the state of
+         * the main stream: key, stream number and position.
          * @returns string The current seed
          * @throws nothing. if an exception is thrown, the execution is aborted.
          */
@@ -0,0 +1,200 @@
+/***********************************************************************\
+|                                                                       |
+| RandomStream.h                                                        |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file RandomStream.h
+ * Definition of the RandomStream class.
+ * @see Random.h
+ */
+
+#ifndef HEADER_UGP3_RANDOMSTREAM
+/** Defines that this file has been included */
+#define HEADER_UGP3_RANDOMSTREAM
+
+#include <cstdint>
+#include <string>
+
+namespace ugp3
+{
+
+/**
+ * @class RandomStream
+ * Counter-based random number generator (Philox4x32-10, Salmon et al., 2011).
+ *
+ * The n-th number of a stream is a pure function of the key, of the stream
+ * number and of n: there is no state besides these three numbers, so
+ * independent streams are derived cheaply (e.g. one for each operator call,
+ * from the seed, the generation and the call index) and a stream can be
+ * saved and restored exactly.
+ * It satisfies the UniformRandomBitGenerator requirements, so it can be
+ * used with the distributions of the standard library.
+ */
+class RandomStream
+{
+public:
+    typedef std::uint32_t result_type;
+
+private:
+    std::uint64_t m_key;
+    std::uint64_t m_stream;
+    // Index of the next block of four numbers
+    std::uint64_t m_counter;
+    std::uint32_t m_block[4];
+    // Next number to return from the block, 4 when the block is exhausted
+    unsigned int m_index;
+
+    /**
+     * Encrypts the counter in place with the given key.
+     */
+    static void philox(std::uint32_t counter[4], std::uint64_t key);
+
+    void nextBlock() {
+        m_block[0] = (std::uint32_t) m_counter;
+        m_block[1] = (std::uint32_t) (m_counter >> 32);
+        m_block[2] = (std::uint32_t) m_stream;
+        m_block[3] = (std::uint32_t) (m_stream >> 32);
+        philox(m_block, m_key);
+        ++m_counter;
+        m_index = 0;
+    }
+
+public:
+    /**
+     * @param key Usually the seed of the run
+     * @param stream Number of the stream, 0 for the main stream
+     * @param position Number of values already drawn from the stream
+     */
+    explicit RandomStream(std::uint64_t key = 0, std::uint64_t stream = 0, std::uint64_t position = 0) {
+        setState(key, stream, position);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    result_type operator()() {
+        if (m_index == 4) {
+            nextBlock();
+        }
+        return m_block[m_index++];
+    }
+
+    std::uint64_t next64() {
+        std::uint64_t high = (*this)();
+        return (high << 32) | (*this)();
+    }
+
+    /**
+     * Returns a double uniformly distributed in [0, 1), with 53 random bits.
+     */
+    double nextDouble() {
+        return (next64() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * Returns an integer uniformly distributed in [0, range), without bias.
+     * A range of 0 stands for 2^64.
+     */
+    std::uint64_t nextBelow(std::uint64_t range) {
+        if (range == 0) {
+            return next64();
+        }
+        // Reject the values of the last incomplete copy of the range
+        const std::uint64_t threshold = (0 - range) % range;
+        std::uint64_t value;
+        do {
+            value = next64();
+        } while (value < threshold);
+        return value % range;
+    }
+
+    /**
+     * Returns the stream with the same key and the given number.
+     */
+    RandomStream derive(std::uint64_t stream) const {
+        return RandomStream(m_key, stream);
+    }
+
+    std::uint64_t getKey() const { return m_key; }
+    std::uint64_t getStream() const { return m_stream; }
+    std::uint64_t getPosition() const { return (m_counter - (m_index < 4 ? 1 : 0)) * 4 + (m_index % 4); }
+    void setState(std::uint64_t key, std::uint64_t stream, std::uint64_t position);
+
+    /**
+     * Combines two numbers into a well-mixed stream number (splitmix64 finalizer).
+     */
+    static std::uint64_t mix(std::uint64_t a, std::uint64_t b) {
+        std::uint64_t z = a + 0x9E3779B97F4A7C15ull * (b + 1);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * Platform-independent hash of a name (FNV-1a), to derive a stream from it.
+     */
+    static std::uint64_t hash(const std::string& name) {
+        std::uint64_t value = 0xCBF29CE484222325ull;
+        for (unsigned char c: name) {
+            value = (value ^ c) * 0x100000001B3ull;
+        }
+        return value;
+    }
+};
+
+inline void RandomStream::philox(std::uint32_t counter[4], std::uint64_t key)
+{
+    std::uint32_t key0 = (std::uint32_t) key;
+    std::uint32_t key1 = (std::uint32_t) (key >> 32);
+
+    for (unsigned int round = 0; round < 10; round++) {
+        const std::uint64_t product0 = 0xD2511F53ull * counter[0];
+        const std::uint64_t product1 = 0xCD9E8D57ull * counter[2];
+        const std::uint32_t c1 = counter[1];
+        const std::uint32_t c3 = counter[3];
+        counter[0] = (std::uint32_t) (product1 >> 32) ^ c1 ^ key0;
+        counter[1] = (std::uint32_t) product1;
+        counter[2] = (std::uint32_t) (product0 >> 32) ^ c3 ^ key1;
+        counter[3] = (std::uint32_t) product0;
+        key0 += 0x9E3779B9u;
+        key1 += 0xBB67AE85u;
+    }
+}
+
+inline void RandomStream::setState(std::uint64_t key, std::uint64_t stream, std::uint64_t position)
+{
+    m_key = key;
+    m_stream = stream;
+    m_counter = position / 4;
+    m_index = 4;
+    if (position % 4 != 0) {
+        nextBlock();
+        m_index = position % 4;
+    }
+}
+
+}
+
+#endif
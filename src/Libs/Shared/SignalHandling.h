@@ -68,6 +68,14 @@ namespace ugp3
             raise(code);
         }
    }
+
+   static volatile sig_atomic_t MemoryDumpRequested = 0;
+
+   /** Requests a report of the memory used, at the end of the current generation. */
+   void memoryDumpHandler(int)
+   {
+        MemoryDumpRequested = 1;
+   }
 }
 #endif
 
@@ -0,0 +1,319 @@
+/***********************************************************************\
+|                                                                       |
+| Socket.cc                                                             |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file Socket.cc
+ * Implementation of the Socket class.
+ * @see Socket.h
+ */
+
+#include "ugp3_config.h"
+#include <string.h>
+#include <errno.h>
+#include <sstream>
+#include <algorithm>
+
+#ifndef WINDOWS
+#include <unistd.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
+#include "Socket.h"
+#include "Exception.h"
+#include "Convert.h"
+
+using namespace ugp3;
+using namespace std;
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// Longest header line: keyword, id and length
+#define MAX_HEADER_SIZE 256
+
+const size_t Socket::MAX_PAYLOAD_SIZE;
+
+Socket::Socket()
+: m_descriptor(-1)
+{ }
+
+Socket::Socket(int descriptor)
+: m_descriptor(descriptor)
+{ }
+
+Socket::~Socket()
+{
+    close();
+}
+
+#ifdef WINDOWS
+
+void Socket::listen(const string& address, unsigned int port)
+{
+    throw Exception("Sockets are not supported on this platform.", LOCATION);
+}
+
+Socket* Socket::accept()
+{
+    throw Exception("Sockets are not supported on this platform.", LOCATION);
+}
+
+void Socket::connect(const string& host, unsigned int port)
+{
+    throw Exception("Sockets are not supported on this platform.", LOCATION);
+}
+
+void Socket::close()
+{ }
+
+void Socket::setSendTimeout(chrono::milliseconds timeout)
+{
+    throw Exception("Sockets are not supported on this platform.", LOCATION);
+}
+
+bool Socket::send(const string& keyword, unsigned long id, const string& payload)
+{
+    throw Exception("Sockets are not supported on this platform.", LOCATION);
+}
+
+bool Socket::receive()
+{
+    throw Exception("Sockets are not supported on this platform.", LOCATION);
+}
+
+bool Socket::wait(const vector<Socket*>& sockets, chrono::milliseconds timeout, vector<bool>& ready)
+{
+    throw Exception("Sockets are not supported on this platform.", LOCATION);
+}
+
+#else
+
+void Socket::listen(const string& address, unsigned int port)
+{
+    close();
+    
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE | AI_NUMERICHOST;
+    struct addrinfo* addresses = nullptr;
+    int error = getaddrinfo(address.c_str(), Convert::toString(port).c_str(), &hints, &addresses);
+    if (error != 0) {
+        throw Exception("Invalid address \"" + address + "\": " + gai_strerror(error) + ".", LOCATION);
+    }
+    
+    m_descriptor = socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+    if (m_descriptor < 0) {
+        const string error = strerror(errno);
+        freeaddrinfo(addresses);
+        throw Exception("Could not create a socket: " + error + ".", LOCATION);
+    }
+    
+    // A restarted run can bind the port while the old connections linger
+    int enable = 1;
+    setsockopt(m_descriptor, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    
+    bool bound = ::bind(m_descriptor, addresses->ai_addr, addresses->ai_addrlen) == 0 && ::listen(m_descriptor, 16) == 0;
+    const string reason = strerror(errno);
+    freeaddrinfo(addresses);
+    if (bound == false) {
+        close();
+        throw Exception("Could not listen on " + address + ":" + Convert::toString(port) + ": " + reason + ".", LOCATION);
+    }
+}
+
+Socket* Socket::accept()
+{
+    int descriptor = ::accept(m_descriptor, nullptr, nullptr);
+    if (descriptor < 0) {
+        throw Exception("Could not accept a connection: " + string(strerror(errno)) + ".", LOCATION);
+    }
+    
+    // Messages are small and latency matters more than throughput
+    int enable = 1;
+    setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    return new Socket(descriptor);
+}
+
+void Socket::connect(const string& host, unsigned int port)
+{
+    close();
+    
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* addresses = nullptr;
+    int error = getaddrinfo(host.c_str(), Convert::toString(port).c_str(), &hints, &addresses);
+    if (error != 0) {
+        throw Exception("Could not resolve host \"" + host + "\": " + gai_strerror(error) + ".", LOCATION);
+    }
+    
+    for (struct addrinfo* address = addresses; address != nullptr; address = address->ai_next) {
+        m_descriptor = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (m_descriptor < 0) {
+            continue;
+        }
+        if (::connect(m_descriptor, address->ai_addr, address->ai_addrlen) == 0) {
+            break;
+        }
+        close();
+    }
+    freeaddrinfo(addresses);
+    
+    if (m_descriptor < 0) {
+        throw Exception("Could not connect to " + host + ":" + Convert::toString(port) + ".", LOCATION);
+    }
+    int enable = 1;
+    setsockopt(m_descriptor, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+}
+
+void Socket::close()
+{
+    if (m_descriptor >= 0) {
+        ::close(m_descriptor);
+        m_descriptor = -1;
+    }
+    m_input.clear();
+}
+
+void Socket::setSendTimeout(chrono::milliseconds timeout)
+{
+    struct timeval interval;
+    interval.tv_sec = timeout.count() / 1000;
+    interval.tv_usec = (timeout.count() % 1000) * 1000;
+    if (setsockopt(m_descriptor, SOL_SOCKET, SO_SNDTIMEO, &interval, sizeof(interval)) != 0) {
+        throw Exception("Could not set the send timeout: " + string(strerror(errno)) + ".", LOCATION);
+    }
+}
+
+bool Socket::send(const string& keyword, unsigned long id, const string& payload)
+{
+    if (payload.size() > MAX_PAYLOAD_SIZE) {
+        throw Exception("The message " + keyword + " of " + Convert::toString(payload.size()) 
+            + " bytes exceeds the maximum size of a message.", LOCATION);
+    }
+    if (m_descriptor < 0) {
+        return false;
+    }
+    
+    ostringstream message;
+    message << keyword << " " << id << " " << payload.size() << "\n" << payload;
+    const string& data = message.str();
+    
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t count = ::send(m_descriptor, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        // Also when the send timeout expires (EAGAIN)
+        if (count <= 0) {
+            return false;
+        }
+        sent += count;
+    }
+    return true;
+}
+
+bool Socket::receive()
+{
+    if (m_descriptor < 0) {
+        return false;
+    }
+    
+    char buffer[65536];
+    ssize_t count;
+    do {
+        count = ::recv(m_descriptor, buffer, sizeof(buffer), 0);
+    } while (count < 0 && errno == EINTR);
+    if (count <= 0) {
+        return false;
+    }
+    m_input.append(buffer, count);
+    return true;
+}
+
+bool Socket::wait(const vector<Socket*>& sockets, chrono::milliseconds timeout, vector<bool>& ready)
+{
+    vector<struct pollfd> descriptors(sockets.size());
+    for (size_t i = 0; i < sockets.size(); ++i) {
+        descriptors[i].fd = sockets[i]->m_descriptor;
+        descriptors[i].events = POLLIN;
+        descriptors[i].revents = 0;
+    }
+    
+    int count = poll(descriptors.data(), descriptors.size(), (int) timeout.count());
+    if (count < 0 && errno != EINTR) {
+        throw Exception("Could not wait on the sockets: " + string(strerror(errno)) + ".", LOCATION);
+    }
+    
+    ready.assign(sockets.size(), false);
+    for (size_t i = 0; i < sockets.size(); ++i) {
+        // Errors and hang-ups are reported by the next receive()
+        ready[i] = (descriptors[i].revents & (POLLIN | POLLERR | POLLHUP)) != 0;
+    }
+    return count > 0;
+}
+
+#endif
+
+bool Socket::nextMessage(string& keyword, unsigned long& id, string& payload)
+{
+    size_t end = m_input.find('\n');
+    if (end == string::npos) {
+        if (m_input.size() > MAX_HEADER_SIZE) {
+            throw Exception("Message header too long.", LOCATION);
+        }
+        return false;
+    }
+    
+    istringstream header(m_input.substr(0, min<size_t>(end, MAX_HEADER_SIZE)));
+    size_t length = 0;
+    header >> keyword >> id >> length;
+    if (header.fail() || end > MAX_HEADER_SIZE) {
+        throw Exception("Malformed message header \"" + m_input.substr(0, min<size_t>(end, MAX_HEADER_SIZE)) + "\".", LOCATION);
+    }
+    if (length > MAX_PAYLOAD_SIZE) {
+        throw Exception("The message " + keyword + " announces " + Convert::toString(length) 
+            + " bytes, more than the maximum size of a message.", LOCATION);
+    }
+    if (m_input.size() < end + 1 + length) {
+        return false;
+    }
+    
+    payload = m_input.substr(end + 1, length);
+    m_input.erase(0, end + 1 + length);
+    return true;
+}
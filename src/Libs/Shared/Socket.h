@@ -0,0 +1,150 @@
+/***********************************************************************\
+|                                                                       |
+| Socket.h                                                              |
+|                                                                       |
+| This file is part of MicroGP v3 (ugp3)                                |
+| https://github.com/squillero/microgp3                                 |
+|                                                                       |
+| Copyright (c) 2006-2016 Giovanni Squillero                            |
+|                                                                       |
+|-----------------------------------------------------------------------|
+|                                                                       |
+| This program is free software; you can redistribute it and/or modify  |
+| it under the terms of the GNU General Public License as published by  |
+| the Free Software Foundation, either version 3 of the License, or (at |
+| your option) any later version.                                       |
+|                                                                       |
+| This program is distributed in the hope that it will be useful, but   |
+| WITHOUT ANY WARRANTY; without even the implied warranty of            |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      |
+| General Public License for more details                               |
+|                                                                       |
+|***********************************************************************'
+| $Revision: 644 $
+| $Date: 2015-02-23 14:50:30 +0100 (Mon, 23 Feb 2015) $
+\***********************************************************************/
+
+/**
+ * @file Socket.h
+ * Definition of the Socket class.
+ * @see Socket.cc
+ */
+
+#ifndef HEADER_UGP3_SOCKET
+/** Defines that this file has been included */
+#define HEADER_UGP3_SOCKET
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * ugp3 namespace
+ */
+namespace ugp3
+{
+    /**
+     * @class Socket
+     * TCP connection exchanging framed messages. Each message is a header
+     * line "keyword id length" followed by length bytes of payload.
+     * Sockets are not available on Windows: all the methods throw.
+     */
+    class Socket
+    {
+    public:
+        /**
+         * Largest payload accepted, in bytes. A peer that announces a larger
+         * message does not follow the protocol.
+         */
+        static const std::size_t MAX_PAYLOAD_SIZE = 64 << 20;
+        
+    private:
+        int m_descriptor;
+        // Bytes received but not yet returned as messages
+        std::string m_input;
+        
+        explicit Socket(int descriptor);
+        Socket(const Socket&) = delete;
+        Socket& operator=(const Socket&) = delete;
+        
+    public:
+        /**
+         * Creates a closed socket.
+         */
+        Socket();
+        ~Socket();
+        
+        /**
+         * Listens for connections on the given port of an interface.
+         * @param address Address of the interface ("0.0.0.0" for all)
+         * @param port Port number
+         * @throws Exception if the port cannot be bound.
+         */
+        void listen(const std::string& address, unsigned int port);
+        
+        /**
+         * Accepts a pending connection of a listening socket.
+         * @returns Socket* The new connection (owned by the caller)
+         */
+        Socket* accept();
+        
+        /**
+         * Connects to the given host.
+         * @param host Name or address of the host
+         * @param port Port number
+         * @throws Exception if the connection fails.
+         */
+        void connect(const std::string& host, unsigned int port);
+        
+        /**
+         * Closes the connection. Does nothing on a closed socket.
+         */
+        void close();
+        
+        bool isOpen() const { return m_descriptor >= 0; }
+        
+        /**
+         * Limits the time that send() waits for the peer to accept more
+         * data. Without a limit, a peer that stops reading blocks send().
+         */
+        void setSendTimeout(std::chrono::milliseconds timeout);
+        
+        /**
+         * Sends a message, blocking until it has been written or until the
+         * peer stops accepting data for longer than the send timeout.
+         * @returns bool False if the connection has been lost or timed out
+         * @throws Exception if the payload exceeds MAX_PAYLOAD_SIZE.
+         */
+        bool send(const std::string& keyword, unsigned long id, const std::string& payload = std::string());
+        
+        /**
+         * Reads the bytes available on the connection, without blocking
+         * if called after wait() reported the socket as ready.
+         * @returns bool False if the connection has been closed or lost
+         */
+        bool receive();
+        
+        /**
+         * Extracts the first complete message received.
+         * @returns bool False if no complete message is available
+         * @throws Exception if the peer does not follow the protocol, or
+         * announces a payload larger than MAX_PAYLOAD_SIZE.
+         */
+        bool nextMessage(std::string& keyword, unsigned long& id, std::string& payload);
+        
+        /**
+         * Waits until at least one of the sockets has data to read (or a
+         * pending connection, for listening sockets), or until the timeout.
+         * @param sockets Open sockets to watch
+         * @param ready Set to true for each socket that can be read
+         * @returns bool True if at least one socket is ready
+         */
+        static bool wait(const std::vector<Socket*>& sockets, std::chrono::milliseconds timeout, std::vector<bool>& ready);
+    };
+}
+
+#endif
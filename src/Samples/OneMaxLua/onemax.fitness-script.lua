@@ -26,3 +26,14 @@ function evaluate(individuals)
   return count
 end
 
+
+-- Optional entry point, used when <batchEvaluations> is greater than 1:
+-- receives several candidates at once (each one being the table that
+-- `evaluate' receives) and returns one table of fitness values per candidate.
+function evaluate_batch(candidates)
+  local results = {}
+  for i, individuals in ipairs(candidates) do
+    results[i] = { evaluate(individuals) }
+  end
+  return results
+end